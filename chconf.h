@@ -0,0 +1,8 @@
+#pragma once
+
+#ifdef MEMORY_MAP_ENABLE
+#define CH_DBG_FILL_THREADS       TRUE  // Stack high-water marks (keymaps/seniply/memory_map.c)
+#define CH_DBG_ENABLE_STACK_CHECK TRUE  // Thread working area bounds, halt on overflow
+#endif
+
+#include_next <chconf.h>
\ No newline at end of file
@@ -66,6 +66,8 @@
     #define RGBLED_NUM 62
     #define DRIVER_LED_TOTAL RGBLED_NUM
     #define RGB_MATRIX_LED_COUNT RGBLED_NUM
+    #define WS2812_FUSED_LED_COUNT 31  // LEDs per half (split_count), sizes the DMA buffer in ws2812_fused.c
+    #define WS2812_POWER_BUDGET_MA 200  // Per half, brighter frames are scaled down (ws2812_fused.c)
     
     #define ENABLE_RGB_MATRIX_ALPHAS_MODS
     #define ENABLE_RGB_MATRIX_GRADIENT_UP_DOWN
@@ -102,11 +104,8 @@
     #define RGB_MATRIX_KEYPRESSES
     #define ENABLE_RGB_MATRIX_SOLID_REACTIVE_SIMPLE
     #define ENABLE_RGB_MATRIX_SOLID_REACTIVE
-    #define ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTIWIDE
-    #define ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTICROSS
-    #define ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTINEXUS
-    #define ENABLE_RGB_MATRIX_MULTISPLASH
-    #define ENABLE_RGB_MATRIX_SOLID_MULTISPLASH
+    // MULTIWIDE, MULTICROSS, MULTINEXUS, MULTISPLASH and SOLID_MULTISPLASH are
+    // replaced by the FIELD_* effects in rgb_matrix_kb.inc (flat frame cost)
 
     #define LOCKING_SUPPORT_ENABLE
     #define LOCKING_RESYNC_ENABLE
@@ -3,8 +3,18 @@
 #define HAL_USE_SERIAL  TRUE
 #define HAL_USE_PWM     TRUE
 #define HAL_USE_I2C     FALSE
+#ifdef QUANTUM_PAINTER_ENABLE
+#define HAL_USE_SPI     TRUE
+#define SPI_USE_WAIT    TRUE
+#else
 #define HAL_USE_SPI     FALSE
 #define SPI_USE_WAIT    FALSE
+#endif
 #define SPI_SELECT_MODE SPI_SELECT_MODE_PAD
 
+#ifdef SERIAL_DMA_ENABLE
+#define PAL_USE_CALLBACKS TRUE  // serial_dma.c sleeps on the RX start bit
+#define PAL_USE_WAIT      TRUE
+#endif
+
 #include_next <halconf.h>
\ No newline at end of file
@@ -2,7 +2,7 @@
 
 void keyboard_post_init_user(void) {
   debug_enable=true;
-  debug_matrix=true;
+//   debug_matrix=true;  // Matrix dumps format text on every change; key events go through DEFLOG instead
 //   debug_keyboard=true;
 //   debug_mouse=true;
 }
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include "deflog.h"
+
+#ifdef CONSOLE_ENABLE
+
+// ============================================================================
+// RECORD FORMAT
+// ============================================================================
+// [nargs:u8] [id:u16] [time:u16] [arg:u16 x nargs]   (little endian)
+// Drained as one console line per record: '~' + hex bytes + '\n'
+// Dropped records are reported as '~!' + hex count + '\n'
+
+_Static_assert((DEFLOG_BUFFER_SIZE & (DEFLOG_BUFFER_SIZE - 1)) == 0, "DEFLOG_BUFFER_SIZE must be a power of two");
+
+#define DEFLOG_HEADER_SIZE 5
+#define DEFLOG_MASK (DEFLOG_BUFFER_SIZE - 1)
+
+// Provided by the linker for the "deflog_fmt" orphan section
+extern const char __start_deflog_fmt[];
+
+static uint8_t deflog_buffer[DEFLOG_BUFFER_SIZE];
+static volatile uint16_t deflog_head = 0;  // Written by producer only
+static volatile uint16_t deflog_tail = 0;  // Written by consumer only
+static volatile uint16_t deflog_dropped = 0;
+static volatile uint16_t deflog_last_write = 0;
+
+static inline void deflog_put(uint16_t pos, uint8_t byte) {
+    deflog_buffer[pos & DEFLOG_MASK] = byte;
+}
+
+static inline uint8_t deflog_get(uint16_t pos) {
+    return deflog_buffer[pos & DEFLOG_MASK];
+}
+
+void deflog_write(const char *fmt, const uint16_t *args, uint8_t nargs) {
+    if (nargs > DEFLOG_MAX_ARGS) {
+        nargs = DEFLOG_MAX_ARGS;
+    }
+
+    uint16_t head = deflog_head;
+    uint16_t len  = DEFLOG_HEADER_SIZE + 2 * nargs;
+    uint16_t now  = timer_read();
+
+    deflog_last_write = now;
+
+    // Never block on the hot path: drop the record if the host is not draining
+    if ((uint16_t)(DEFLOG_BUFFER_SIZE - (uint16_t)(head - deflog_tail)) < len) {
+        deflog_dropped++;
+        return;
+    }
+
+    uint16_t id = (uint16_t)(fmt - __start_deflog_fmt);
+
+    deflog_put(head++, nargs);
+    deflog_put(head++, id & 0xFF);
+    deflog_put(head++, id >> 8);
+    deflog_put(head++, now & 0xFF);
+    deflog_put(head++, now >> 8);
+    for (uint8_t i = 0; i < nargs; i++) {
+        deflog_put(head++, args[i] & 0xFF);
+        deflog_put(head++, args[i] >> 8);
+    }
+
+    // Publish the record only after its payload is in place
+    __asm__ volatile("" ::: "memory");
+    deflog_head = head;
+}
+
+// ============================================================================
+// DRAIN (idle time only)
+// ============================================================================
+
+static void deflog_emit_hex(char *out, uint8_t byte) {
+    static const char hex[] = "0123456789ABCDEF";
+    out[0] = hex[byte >> 4];
+    out[1] = hex[byte & 0x0F];
+}
+
+void deflog_task(void) {
+    if (timer_elapsed(deflog_last_write) < DEFLOG_IDLE_TERM) {
+        return;
+    }
+
+    // Line: '~' + up to (header + args) bytes as hex + '\0'
+    char line[2 + 2 * (DEFLOG_HEADER_SIZE + 2 * DEFLOG_MAX_ARGS)];
+
+    if (deflog_dropped) {
+        uint16_t dropped = deflog_dropped;
+        deflog_dropped   = 0;
+        line[0] = '~';
+        line[1] = '!';
+        deflog_emit_hex(&line[2], dropped >> 8);
+        deflog_emit_hex(&line[4], dropped & 0xFF);
+        line[6] = '\0';
+        uprintf("%s\n", line);
+    }
+
+    for (uint8_t n = 0; n < DEFLOG_DRAIN_RECORDS; n++) {
+        uint16_t tail = deflog_tail;
+        if (tail == deflog_head) {
+            return;
+        }
+
+        uint8_t nargs = deflog_get(tail);
+        uint8_t len   = DEFLOG_HEADER_SIZE + 2 * nargs;
+        uint8_t pos   = 1;
+
+        line[0] = '~';
+        for (uint8_t i = 0; i < len; i++, pos += 2) {
+            deflog_emit_hex(&line[pos], deflog_get(tail + i));
+        }
+        line[pos] = '\0';
+
+        __asm__ volatile("" ::: "memory");
+        deflog_tail = tail + len;
+
+        uprintf("%s\n", line);
+    }
+}
+
+#endif
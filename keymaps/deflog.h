@@ -0,0 +1,54 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Deferred binary logging (defmt style)
+// Log calls only copy a format-string ID and raw 16-bit arguments into a
+// lock-free ring buffer. The buffer is drained to the console endpoint once
+// the keyboard has been idle for DEFLOG_IDLE_TERM, and the host-side decoder
+// (keymaps/tools/deflog_decode.py) rebuilds the text from the firmware ELF.
+//
+// Format strings live in the "deflog_fmt" section; the ID of a string is its
+// offset from the start of that section.
+
+#ifndef DEFLOG_BUFFER_SIZE
+#define DEFLOG_BUFFER_SIZE 256  // Ring buffer bytes (must be a power of two)
+#endif
+
+#ifndef DEFLOG_IDLE_TERM
+#define DEFLOG_IDLE_TERM 50  // ms without new records before draining starts
+#endif
+
+#ifndef DEFLOG_DRAIN_RECORDS
+#define DEFLOG_DRAIN_RECORDS 1  // Records drained per housekeeping pass
+#endif
+
+#define DEFLOG_MAX_ARGS 8
+
+#ifdef CONSOLE_ENABLE
+
+// Log a format string with 1 to DEFLOG_MAX_ARGS integer arguments.
+// Arguments are truncated to 16 bits; the format string is never touched on
+// the keyboard, only by the host decoder.
+#define DEFLOG(fmt, ...)                                                                     \
+    do {                                                                                     \
+        static const char __attribute__((section("deflog_fmt"), used)) deflog_fmt_[] = fmt; \
+        const uint16_t deflog_args_[] = {0, __VA_ARGS__};                                    \
+        deflog_write(deflog_fmt_, &deflog_args_[1],                                          \
+                     sizeof(deflog_args_) / sizeof(deflog_args_[0]) - 1);                    \
+    } while (0)
+
+// Append one record to the ring buffer. Safe to call from a single producer
+// (main loop or ISR) while deflog_task() consumes.
+void deflog_write(const char *fmt, const uint16_t *args, uint8_t nargs);
+
+// Drain buffered records to the console once the loop is idle
+// (call from housekeeping_task_user)
+void deflog_task(void);
+
+#else
+
+#define DEFLOG(fmt, ...) ((void)0)
+#define deflog_task() ((void)0)
+
+#endif
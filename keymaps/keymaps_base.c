@@ -1,5 +1,6 @@
 #include QMK_KEYBOARD_H
 
+#include "deflog.c"
 #include "hooks_base.c"
 
 const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
@@ -8,9 +8,15 @@
 #define TAPPING_TERM 180              // 180ms tap/hold threshold for layer switches (fast typing optimized)
 #define QUICK_TAP_TERM 0              // Disable quick tap
 #define HOLD_ON_OTHER_KEY_PRESS       // Activate hold immediately when another key is pressed (optimal for fast typing)
+#define TAPPING_TERM_PER_KEY          // get_tapping_term() returns self-tuned terms (tap_tune.c)
 #define ONESHOT_TAP_TOGGLE 2          // Double-tap to lock one-shot modifiers (not used - using Callum style)
 #define ONESHOT_TIMEOUT 3000          // 3 second one-shot timeout (not used - using Callum style)
 
+// Speculative tap for ESC_EXT/TAB_SYM during typing streaks (speculative_tap.c)
+// Pressed within STREAK_TERM of a letter/digit while typing faster than RHYTHM_TERM = instant tap
+#define SPECULATIVE_TAP_STREAK_TERM 125 // ms since last alphanumeric press
+#define SPECULATIVE_TAP_RHYTHM_TERM 170 // Average ms between alphanumeric presses
+
 // Flow system oneshot configuration (PR #16174)
 // Enhanced oneshot with timer support for auto-timeout and hold detection
 #define FLOW_ONESHOT_TERM 500           // Auto-release oneshot after 500ms
@@ -25,3 +31,46 @@
 
 // Layer lock configuration
 #define LAYER_LOCK_IDLE_TIMEOUT 60000  // 60 second timeout for layer lock
+
+// Self-tuning per-key terms (tap_tune.c)
+// Terms derived from on-device tap/hold histograms, persisted in the EECONFIG user datablock
+#define TAP_TUNE_SLOT_COUNT 8               // ESC_EXT, TAB_SYM, FUN_KEY, OS_SHFT, OS_CTRL, OS_ALT, OS_GUI, OS_ALTGR
+#define TAP_TUNE_MIN_TERM 100               // Never tune below 100ms
+#define TAP_TUNE_MAX_TERM 500               // Never tune above 500ms
+#define TAP_TUNE_SAVE_INTERVAL 600000       // Write changed terms at most every 10 minutes
+#define EECONFIG_USER_DATA_SIZE 500         // tap_tune: first 16 bytes, keymap_overlay: the next 484
+
+// RAM keymap overlay (keymap_overlay.c, KEYMAP_OVERLAY_ENABLE in rules.mk)
+// Layouts uploaded over raw HID by tools/keymap_overlay.py replace keymaps[] without flashing
+#define KEYMAP_OVERLAY_LAYERS 5             // Layers in keymaps[] (checked in keymap.c)
+#define KEYMAP_OVERLAY_EEPROM_OFFSET 16     // Persisted overlay after the tap_tune terms
+
+// Pin-edge key timestamps (key_timestamps.c, KEY_TIMESTAMPS_ENABLE in rules.mk)
+// Event times come from a 2 kHz pin sampler, so timing terms ignore main loop stalls
+#define KEY_TIMESTAMPS_INTERVAL_US 500      // Sampling period (timestamp resolution)
+#define KEY_TIMESTAMPS_MAX_AGE 100          // Edges older than this (ms) are not applied
+#define SPLIT_TRANSACTION_IDS_USER KEY_TIMESTAMPS_SYNC, KEY_INDICATORS_SYNC  // Edge ages, indicator state
+
+// Per-key state indicators (key_indicators.c, KEY_INDICATORS_ENABLE in rules.mk)
+// Overlay rebuilt only when oneshot / layer / caps word state changes, changed bits sent to the other half
+#define KEY_INDICATORS_MAX_LEDS 12          // Oneshots + FUN_KEY + 2x LLOCK on one half, with room to spare
+
+// Fast boot (fast_boot.c, FAST_BOOT_ENABLE in rules.mk)
+// Both halves scan from the first loop. A missing other half is retried from the main loop every
+// SPLIT_CONNECTION_CHECK_TIMEOUT (800 ms, keyboard config.h), each retry blocking the scan for up to
+// SERIAL_USART_TIMEOUT (20 ms), so the interval is left long
+
+// Fixed-point mouse keys (mouse_keys.c)
+// Motion ticks are timed independently of the scan loop, speeds follow a smoothstep table
+#define MOUSE_KEYS_INTERVAL 4               // 250 Hz motion reports
+#define MOUSE_KEYS_SPEED_MIN 60             // px/s on press (precise positioning)
+#define MOUSE_KEYS_SPEED_MAX 1600           // px/s after MOUSE_KEYS_TIME_TO_MAX
+#define MOUSE_KEYS_TIME_TO_MAX 1000
+#define POINTING_DEVICE_HIRES_SCROLL_ENABLE         // Resolution multiplier in the mouse descriptor
+#define POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER 120 // Wheel units per detent
+#define WHEEL_EXTENDED_REPORT                       // 16-bit wheel fields (hi-res values exceed int8)
+
+// Status display (status_display.c, needs QUANTUM_PAINTER_ENABLE)
+#define STATUS_DISPLAY_SPI_DIVISOR 4        // 12 MHz SPI clock
+#define STATUS_DISPLAY_OFFSET_X 26          // 0.96" 80x160 ST7735 panel RAM offset
+#define STATUS_DISPLAY_OFFSET_Y 1
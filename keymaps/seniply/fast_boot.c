@@ -0,0 +1,88 @@
+#include "fast_boot.h"
+
+#include <ch.h>
+#include <hal.h>
+
+#ifdef SPLIT_KEYBOARD
+#include "transactions.h"
+#endif
+
+#ifndef USB_DRIVER
+#define USB_DRIVER USBD1
+#endif
+
+// ============================================================================
+// BOOT CLOCK
+// ============================================================================
+// timer_read32() restarts at timer_init() inside keyboard_init, so phases
+// before that would not share its origin. The 16-bit system time is
+// extended here instead; it only has to be sampled every few seconds until
+// the last phase is stamped.
+
+static uint32_t boot_ticks = 0;
+static systime_t last_sample = 0;
+static uint16_t phase_ms[FAST_BOOT_PHASE_COUNT] = {
+    [0 ... FAST_BOOT_PHASE_COUNT - 1] = FAST_BOOT_NOT_REACHED,
+};
+
+static uint16_t boot_ms(void) {
+    systime_t now = chVTGetSystemTimeX();
+    if (boot_ticks < TIME_MS2I(FAST_BOOT_NOT_REACHED)) {
+        boot_ticks += chTimeDiffX(last_sample, now);  // Stops once saturated (no wrap)
+    }
+    last_sample = now;
+    uint32_t ms = TIME_I2MS(boot_ticks);
+    return ms < FAST_BOOT_NOT_REACHED ? ms : FAST_BOOT_NOT_REACHED - 1;
+}
+
+void fast_boot_mark(uint8_t phase) {
+    uint16_t now = boot_ms();
+    if (phase < FAST_BOOT_PHASE_COUNT && phase_ms[phase] == FAST_BOOT_NOT_REACHED) {
+        phase_ms[phase] = now;
+    }
+}
+
+static bool reached(uint8_t phase) {
+    return phase_ms[phase] != FAST_BOOT_NOT_REACHED;
+}
+
+// ============================================================================
+// MAIN LOOP
+// ============================================================================
+
+void fast_boot_task(void) {
+    fast_boot_mark(FAST_BOOT_FIRST_SCAN);  // Also keeps the extended clock sampled
+
+    bool master = is_keyboard_master();
+    if (master && !reached(FAST_BOOT_USB_ACTIVE) && USB_DRIVER.state == USB_ACTIVE) {
+        fast_boot_mark(FAST_BOOT_USB_ACTIVE);
+    }
+#ifdef SPLIT_KEYBOARD
+    if (master && !reached(FAST_BOOT_SPLIT_CONNECTED) && is_transport_connected()) {
+        fast_boot_mark(FAST_BOOT_SPLIT_CONNECTED);
+    }
+#endif
+
+    // The other half has no host to wait for
+    if (!reached(FAST_BOOT_DEFERRED_DONE) && (!master || reached(FAST_BOOT_USB_ACTIVE))) {
+        fast_boot_deferred_init();
+        fast_boot_mark(FAST_BOOT_DEFERRED_DONE);
+    }
+}
+
+// ============================================================================
+// RAW HID
+// ============================================================================
+// Request: [cmd]
+// Reply:   [cmd, phase count, u16 ms per phase (FAST_BOOT_NOT_REACHED if not)]
+
+void fast_boot_raw_hid(uint8_t *data, uint8_t length) {
+    if (length < 2 + 2 * FAST_BOOT_PHASE_COUNT) {
+        return;
+    }
+    data[1] = FAST_BOOT_PHASE_COUNT;
+    for (uint8_t i = 0; i < FAST_BOOT_PHASE_COUNT; i++) {
+        data[2 + 2 * i] = phase_ms[i] & 0xFF;
+        data[3 + 2 * i] = phase_ms[i] >> 8;
+    }
+}
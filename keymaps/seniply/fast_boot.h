@@ -0,0 +1,40 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Boot phase timing and deferred initialisation
+// Every phase is stamped in ms since reset (ChibiOS system time), so the
+// time from power-up to the first possible keystroke can be read back over
+// raw HID (tools/boot_timing.py) after a replug or KVM switch.
+//
+// Work that is not needed to send keystrokes (EEPROM-backed settings, RGB
+// effect start, display) is moved out of keyboard_post_init_user into
+// fast_boot_deferred_init(), which runs once USB is configured (the master)
+// or straight after the first scan (the other half).
+
+enum fast_boot_phases {
+    FAST_BOOT_PRE_INIT,        // keyboard_pre_init_user: clocks and HAL up
+    FAST_BOOT_MATRIX_INIT,     // matrix_init_user: hand detection, matrix pins
+    FAST_BOOT_POST_INIT,       // keyboard_post_init_user: end of keyboard_init
+    FAST_BOOT_FIRST_SCAN,      // First main loop iteration
+    FAST_BOOT_USB_ACTIVE,      // USB configured by the host (master only)
+    FAST_BOOT_SPLIT_CONNECTED, // First successful transaction with the other half
+    FAST_BOOT_DEFERRED_DONE,   // fast_boot_deferred_init() returned
+    FAST_BOOT_FIRST_KEY,       // First key press processed
+    FAST_BOOT_PHASE_COUNT,
+};
+
+#define FAST_BOOT_NOT_REACHED 0xFFFF
+
+void fast_boot_mark(uint8_t phase);
+
+// Stamps the phases seen from the main loop and runs the deferred init
+// (call every main loop iteration)
+void fast_boot_task(void);
+
+// Raw HID: reply with the phase times (little-endian u16 ms per phase)
+void fast_boot_raw_hid(uint8_t *data, uint8_t length);
+
+// To be implemented by the consumer. Initialisation that can wait until
+// keystrokes can already be sent.
+void fast_boot_deferred_init(void);
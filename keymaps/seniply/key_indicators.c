@@ -0,0 +1,162 @@
+#include "key_indicators.h"
+
+#include <string.h>
+
+#ifdef SPLIT_KEYBOARD
+#include "transactions.h"
+#endif
+
+_Static_assert(KEY_INDICATORS_SLOTS * 2 <= 16, "Slot values must fit bits 0-15 of the state word");
+
+typedef struct {
+    uint8_t led;
+    rgb_t color;
+} overlay_t;
+
+// Published state word and keymap generation, the only things the renderer
+// reads. The overlay belongs to the renderer (main loop, or the RGB thread
+// of rgb_thread.c).
+static volatile uint32_t current_state = 0;
+static volatile uint8_t keymap_generation = 0;
+static overlay_t overlay[KEY_INDICATORS_MAX_LEDS];
+static uint8_t overlay_count = 0;
+static uint32_t overlay_state = UINT32_MAX;  // Bits 24-31 are never set
+static uint8_t overlay_generation = 0;
+
+// ============================================================================
+// OVERLAY
+// ============================================================================
+
+// Keycode of a position as QMK would resolve it for the given layer state
+static uint16_t keycode_for(layer_state_t layers, uint8_t row, uint8_t col) {
+    keypos_t pos = {.row = row, .col = col};
+    for (int8_t layer = get_highest_layer(layers); layer > 0; layer--) {
+        if (layers & ((layer_state_t)1 << layer)) {
+            uint16_t keycode = keymap_key_to_keycode(layer, pos);
+            if (keycode != KC_TRANSPARENT) {
+                return keycode;
+            }
+        }
+    }
+    return keymap_key_to_keycode(0, pos);
+}
+
+// Only runs on the first frame after the state word or the keymap changed
+static void build_overlay(uint32_t state, uint8_t generation) {
+    layer_state_t layers = KEY_INDICATORS_LAYER_STATE(state);
+    uint8_t first_row = 0;
+    uint8_t rows = MATRIX_ROWS;
+#ifdef SPLIT_KEYBOARD
+    rows = MATRIX_ROWS / 2;
+    first_row = is_keyboard_left() ? 0 : rows;
+#endif
+
+    overlay_count = 0;
+    for (uint8_t row = first_row; row < first_row + rows; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS && overlay_count < KEY_INDICATORS_MAX_LEDS; col++) {
+            uint8_t led = g_led_config.matrix_co[row][col];
+            if (led == NO_LED) {
+                continue;
+            }
+            uint8_t slot = key_indicators_slot(keycode_for(layers, row, col));
+            if (slot >= KEY_INDICATORS_SLOTS) {
+                continue;
+            }
+            hsv_t hsv = key_indicators_color(slot, state);
+            if (hsv.v == 0) {
+                continue;
+            }
+            overlay[overlay_count].led = led;
+            overlay[overlay_count].color = rgb_matrix_hsv_to_rgb(hsv);
+            overlay_count++;
+        }
+    }
+    overlay_state = state;
+    overlay_generation = generation;
+}
+
+void key_indicators_render(uint8_t led_min, uint8_t led_max) {
+    uint32_t state = current_state;
+    uint8_t generation = keymap_generation;
+    if (state != overlay_state || generation != overlay_generation) {
+        build_overlay(state, generation);
+    }
+    for (uint8_t i = 0; i < overlay_count; i++) {
+        const overlay_t *entry = &overlay[i];
+        if (entry->led >= led_min && entry->led < led_max) {
+            rgb_matrix_set_color(entry->led, entry->color.r, entry->color.g, entry->color.b);
+        }
+    }
+}
+
+#ifdef SPLIT_KEYBOARD
+// ============================================================================
+// OTHER HALF (split RPC)
+// ============================================================================
+// Changed bits as mask + values: applying a message twice is harmless, so
+// a transaction that fails after the slave applied it can just be resent.
+
+typedef struct {
+    uint32_t mask;
+    uint32_t bits;
+} sync_msg_t;
+
+_Static_assert(sizeof(sync_msg_t) <= RPC_M2S_BUFFER_SIZE, "sync_msg_t does not fit the RPC buffer");
+
+static uint32_t unsent_mask = 0;
+static bool was_connected = false;
+
+static void sync_handler(uint8_t in_len, const void *in_data, uint8_t out_len, void *out_data) {
+    if (in_len < sizeof(sync_msg_t)) {
+        return;
+    }
+    sync_msg_t msg;
+    memcpy(&msg, in_data, sizeof(msg));
+    current_state = (current_state & ~msg.mask) | (msg.bits & msg.mask);
+}
+#endif
+
+// ============================================================================
+// API
+// ============================================================================
+
+void key_indicators_init(void) {
+#ifdef SPLIT_KEYBOARD
+    transaction_register_rpc(KEY_INDICATORS_SYNC, sync_handler);
+#endif
+}
+
+void key_indicators_update(uint32_t state) {
+    if (state == current_state || !is_keyboard_master()) {
+        return;
+    }
+#ifdef SPLIT_KEYBOARD
+    unsent_mask |= state ^ current_state;
+#endif
+    current_state = state;
+}
+
+void key_indicators_invalidate(void) {
+    keymap_generation++;
+}
+
+void key_indicators_task(void) {
+#ifdef SPLIT_KEYBOARD
+    if (!is_keyboard_master()) {
+        return;
+    }
+    // A half that (re)connects starts from an empty state word
+    bool connected = is_transport_connected();
+    if (connected && !was_connected) {
+        unsent_mask = UINT32_MAX;
+    }
+    was_connected = connected;
+
+    if (unsent_mask && connected) {
+        sync_msg_t msg = {.mask = unsent_mask, .bits = current_state & unsent_mask};
+        if (transaction_rpc_send(KEY_INDICATORS_SYNC, sizeof(msg), &msg)) {
+            unsent_mask = 0;
+        }
+    }
+#endif
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Per-key state indicators on the RGB matrix (oneshots, layer, caps word)
+// The keymap packs everything the indicators show (a 2-bit value per
+// indicator slot and the layer state) into one 32-bit state word and calls
+// key_indicators_update() from the hooks where that state changes
+// (process_record, layer / caps word / layer lock callbacks, oneshot
+// timeouts). Only a changed word does any work: on the next frame, the LEDs
+// of this half whose key on the top layer has an indicator slot get their
+// colour resolved once into a short overlay list. Every other frame just
+// copies that list over the effect, a few rgb_matrix_set_color() calls at
+// any state. The word is all the renderer reads, so it can run in its own
+// thread (RGB_MATRIX_THREAD_ENABLE).
+//
+// The master sends the changed bits (mask + values) to the other half over
+// a split RPC from key_indicators_task(), so a lost transaction is simply
+// sent again and the other half needs no keymap state of its own.
+
+#ifndef KEY_INDICATORS_MAX_LEDS
+#define KEY_INDICATORS_MAX_LEDS 12  // Overlay entries per half
+#endif
+
+#define KEY_INDICATORS_SLOTS 8
+#define KEY_INDICATORS_NO_SLOT 0xFF
+
+// Slot values (2 bits per slot)
+enum key_indicator_values {
+    KEY_INDICATOR_OFF = 0,
+    KEY_INDICATOR_QUEUED,  // Oneshot waiting for the next key
+    KEY_INDICATOR_HELD,
+    KEY_INDICATOR_LOCKED,  // Caps word, layer lock
+};
+
+// State word: slot values in bits 0-15, layer state in bits 16-23
+#define KEY_INDICATOR(slot, value) ((uint32_t)(value) << ((slot) * 2))
+#define KEY_INDICATOR_VALUE(state, slot) (((state) >> ((slot) * 2)) & 3)
+#define KEY_INDICATORS_LAYERS(layers) ((uint32_t)((layers) & 0xFF) << 16)
+#define KEY_INDICATORS_LAYER_STATE(state) ((layer_state_t)(((state) >> 16) & 0xFF))
+
+// Register the split RPC (call from keyboard_post_init_user, on both halves)
+void key_indicators_init(void);
+
+// New state word (master). Publishes it for the next frame and queues the
+// changed bits for the other half when it differs from the current one.
+void key_indicators_update(uint32_t state);
+
+// The keymap changed under the same state word (keymap_overlay.c swap): the
+// next frame rebuilds the overlay from the new keycodes
+void key_indicators_invalidate(void);
+
+// Send queued changes to the other half (call from housekeeping_task_user)
+void key_indicators_task(void);
+
+// Paint the overlay (call from rgb_matrix_indicators_advanced_user)
+void key_indicators_render(uint8_t led_min, uint8_t led_max);
+
+// To be implemented by the consumer. Indicator slot of a keycode, or
+// KEY_INDICATORS_NO_SLOT.
+uint8_t key_indicators_slot(uint16_t keycode);
+
+// To be implemented by the consumer. Colour of a slot in the given state
+// word; a value of 0 leaves the effect underneath visible.
+hsv_t key_indicators_color(uint8_t slot, uint32_t state);
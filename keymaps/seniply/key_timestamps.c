@@ -0,0 +1,285 @@
+#include "key_timestamps.h"
+
+#include <ch.h>
+#include <string.h>
+
+#ifdef SPLIT_KEYBOARD
+#include "transactions.h"
+#define LOCAL_ROWS (MATRIX_ROWS / 2)
+#else
+#define LOCAL_ROWS MATRIX_ROWS
+#endif
+
+#define LOCAL_KEYS (LOCAL_ROWS * MATRIX_COLS)
+#define ALL_KEYS (MATRIX_ROWS * MATRIX_COLS)
+
+#define SAMPLE_TICKS (TIME_US2I(KEY_TIMESTAMPS_INTERVAL_US) > 0 ? TIME_US2I(KEY_TIMESTAMPS_INTERVAL_US) : 1)
+#define LOCKOUT_SAMPLES (KEY_TIMESTAMPS_LOCKOUT_MS * 1000 / KEY_TIMESTAMPS_INTERVAL_US)
+
+#define EDGE_PRESSED 0x80  // In edge_t.key
+
+_Static_assert(LOCAL_KEYS <= 32, "Local key bitmasks are 32-bit");
+_Static_assert(LOCKOUT_SAMPLES <= UINT8_MAX, "KEY_TIMESTAMPS_LOCKOUT_MS too long for the sample rate");
+_Static_assert((KEY_TIMESTAMPS_QUEUE_SIZE & (KEY_TIMESTAMPS_QUEUE_SIZE - 1)) == 0 && KEY_TIMESTAMPS_QUEUE_SIZE <= 128,
+               "KEY_TIMESTAMPS_QUEUE_SIZE must be a power of two <= 128");
+
+// ============================================================================
+// EDGE QUEUE (ISR -> main loop)
+// ============================================================================
+// Single producer (sampler ISR) writes the entry, then publishes it by
+// advancing head; single consumer reads it, then frees it by advancing tail.
+// 8-bit index stores are atomic on the M0, so no lock is needed.
+
+typedef struct {
+    uint8_t key;      // Local key index | EDGE_PRESSED
+    systime_t time;   // System time at the sample that saw the edge
+} edge_t;
+
+static volatile edge_t queue[KEY_TIMESTAMPS_QUEUE_SIZE];
+static volatile uint8_t queue_head = 0;  // Written by the ISR only
+static volatile uint8_t queue_tail = 0;  // Written by the main loop only
+
+static bool queue_push(uint8_t key, systime_t time) {
+    uint8_t head = queue_head;
+    if ((uint8_t)(head - queue_tail) >= KEY_TIMESTAMPS_QUEUE_SIZE) {
+        return false;
+    }
+    queue[head % KEY_TIMESTAMPS_QUEUE_SIZE].key = key;
+    queue[head % KEY_TIMESTAMPS_QUEUE_SIZE].time = time;
+    queue_head = head + 1;
+    return true;
+}
+
+// ============================================================================
+// PIN SAMPLER (virtual timer, ISR context)
+// ============================================================================
+// Per key: stable state, a lockout after each edge (bounce), and a pending
+// edge when the queue was full. A pending key is not sampled again until its
+// edge is queued, so its next edge cannot overtake it.
+
+static const pin_t direct_pins[LOCAL_ROWS][MATRIX_COLS] = DIRECT_PINS;
+#if defined(SPLIT_KEYBOARD) && defined(DIRECT_PINS_RIGHT)
+static const pin_t direct_pins_right[LOCAL_ROWS][MATRIX_COLS] = DIRECT_PINS_RIGHT;
+#endif
+
+static pin_t pins[LOCAL_KEYS];
+static virtual_timer_t sampler;
+static uint32_t stable = 0;   // Bit per local key, set = pressed
+static uint32_t pending = 0;
+static systime_t pending_time[LOCAL_KEYS];
+static uint8_t lockout[LOCAL_KEYS];
+
+static void sample(virtual_timer_t *vtp, void *arg) {
+    systime_t now = chVTGetSystemTimeX();
+
+    for (uint8_t key = 0; pending && key < LOCAL_KEYS; key++) {
+        uint32_t bit = (uint32_t)1 << key;
+        if (pending & bit) {
+            if (!queue_push(key | ((stable & bit) ? EDGE_PRESSED : 0), pending_time[key])) {
+                break;
+            }
+            pending &= ~bit;
+        }
+    }
+
+    for (uint8_t key = 0; key < LOCAL_KEYS; key++) {
+        uint32_t bit = (uint32_t)1 << key;
+        if (lockout[key]) {
+            lockout[key]--;
+            continue;
+        }
+        if ((pending & bit) || pins[key] == NO_PIN) {
+            continue;
+        }
+        bool pressed = !gpio_read_pin(pins[key]);  // Direct pins, active low
+        if (pressed == !!(stable & bit)) {
+            continue;
+        }
+        stable ^= bit;
+        lockout[key] = LOCKOUT_SAMPLES;
+        if (!queue_push(key | (pressed ? EDGE_PRESSED : 0), now)) {
+            pending |= bit;
+            pending_time[key] = now;
+        }
+    }
+
+    chSysLockFromISR();
+    chVTSetI(&sampler, SAMPLE_TICKS, sample, NULL);
+    chSysUnlockFromISR();
+}
+
+// ============================================================================
+// PER-KEY EDGE TABLE (main loop)
+// ============================================================================
+// Latest edge of every key (both halves) in timer_read() milliseconds.
+// FRESH until applied to an event.
+
+#define EDGE_FRESH 0x01
+#define EDGE_DOWN 0x02
+
+static uint16_t edge_time[ALL_KEYS];
+static uint8_t edge_flags[ALL_KEYS];
+static uint8_t row_offset = 0;  // First matrix row of this half
+static uint16_t last_time = 0;  // Time of the last key event processed
+
+static void record_edge(uint8_t key, bool pressed, uint16_t time) {
+    edge_time[key] = time;
+    edge_flags[key] = EDGE_FRESH | (pressed ? EDGE_DOWN : 0);
+}
+
+static void drain(void) {
+    uint16_t now_ms = timer_read();
+    systime_t now = chVTGetSystemTimeX();
+    uint8_t head = queue_head;
+
+    while (queue_tail != head) {
+        uint8_t tail = queue_tail;
+        uint8_t key = queue[tail % KEY_TIMESTAMPS_QUEUE_SIZE].key;
+        systime_t time = queue[tail % KEY_TIMESTAMPS_QUEUE_SIZE].time;
+        queue_tail = tail + 1;
+
+        uint16_t age = TIME_I2MS(chTimeDiffX(time, now));
+        record_edge(row_offset * MATRIX_COLS + (key & ~EDGE_PRESSED), key & EDGE_PRESSED, now_ms - age);
+    }
+}
+
+static bool edge_matches(uint8_t key, bool pressed, uint16_t event_time) {
+    return (edge_flags[key] & EDGE_FRESH) && !!(edge_flags[key] & EDGE_DOWN) == pressed &&
+           TIMER_DIFF_16(event_time, edge_time[key]) <= KEY_TIMESTAMPS_MAX_AGE;
+}
+
+// Earlier than the last processed event (within the age window, so an idle
+// wrap of the 16-bit timer does not count)
+static bool before_last(uint16_t time) {
+    return time != last_time && TIMER_DIFF_16(last_time, time) <= KEY_TIMESTAMPS_MAX_AGE;
+}
+
+#ifdef SPLIT_KEYBOARD
+// ============================================================================
+// OTHER HALF (split RPC)
+// ============================================================================
+// Only when the other half's rows changed in the scan the master just did:
+// the slave's debounced matrix changes DEBOUNCE ms after the edge, so its
+// edge is already known, and the events for the change are generated
+// after matrix_scan_user(). The master asks for the keys that changed, the
+// slave answers with the age of each one's edge in ms at the time of the
+// reply (no shared clock needed).
+
+#define SYNC_UNKNOWN 0xFF  // No edge in the direction of the change
+
+typedef struct {
+    uint8_t age[KEY_TIMESTAMPS_SYNC_MAX_KEYS];  // Per changed key, in key order
+} sync_reply_t;
+
+_Static_assert(sizeof(uint32_t) <= RPC_M2S_BUFFER_SIZE && sizeof(sync_reply_t) <= RPC_S2M_BUFFER_SIZE,
+               "KEY_TIMESTAMPS_SYNC_MAX_KEYS does not fit the RPC buffers");
+
+static void sync_handler(uint8_t in_len, const void *in_data, uint8_t out_len, void *out_data) {
+    sync_reply_t *reply = out_data;
+    uint32_t changed = 0;
+    if (in_len >= sizeof(changed)) {
+        memcpy(&changed, in_data, sizeof(changed));
+    }
+
+    drain();
+    uint16_t now = timer_read();
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < LOCAL_KEYS && count < KEY_TIMESTAMPS_SYNC_MAX_KEYS; i++) {
+        if (!(changed & ((uint32_t)1 << i))) {
+            continue;
+        }
+        uint8_t key = row_offset * MATRIX_COLS + i;
+        bool down = matrix_is_on(key / MATRIX_COLS, key % MATRIX_COLS);
+        uint16_t age = TIMER_DIFF_16(now, edge_time[key]);
+        bool known = (edge_flags[key] & EDGE_FRESH) && !!(edge_flags[key] & EDGE_DOWN) == down && age < SYNC_UNKNOWN;
+        reply->age[count++] = known ? age : SYNC_UNKNOWN;
+    }
+}
+
+static matrix_row_t synced_rows[LOCAL_ROWS];  // Other half as of the last sync
+
+static void sync_other_half(void) {
+    uint8_t first_row = row_offset ? 0 : LOCAL_ROWS;
+    uint32_t changed = 0;
+    for (uint8_t row = 0; row < LOCAL_ROWS; row++) {
+        matrix_row_t state = matrix_get_row(first_row + row);
+        changed |= (uint32_t)(state ^ synced_rows[row]) << (row * MATRIX_COLS);
+        synced_rows[row] = state;
+    }
+    sync_reply_t reply;
+    if (!changed || !transaction_rpc_exec(KEY_TIMESTAMPS_SYNC, sizeof(changed), &changed, sizeof(reply), &reply)) {
+        return;
+    }
+    uint16_t now = timer_read();
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < LOCAL_KEYS && count < KEY_TIMESTAMPS_SYNC_MAX_KEYS; i++) {
+        if (!(changed & ((uint32_t)1 << i))) {
+            continue;
+        }
+        uint8_t age = reply.age[count++];
+        if (age != SYNC_UNKNOWN) {
+            uint8_t key = first_row * MATRIX_COLS + i;
+            record_edge(key, synced_rows[i / MATRIX_COLS] & (1 << (i % MATRIX_COLS)), now - age);
+        }
+    }
+}
+#endif
+
+// ============================================================================
+// API
+// ============================================================================
+
+void key_timestamps_init(void) {
+#ifdef SPLIT_KEYBOARD
+    row_offset = is_keyboard_left() ? 0 : LOCAL_ROWS;
+    transaction_register_rpc(KEY_TIMESTAMPS_SYNC, sync_handler);
+#endif
+    const pin_t(*half_pins)[MATRIX_COLS] = direct_pins;
+#if defined(SPLIT_KEYBOARD) && defined(DIRECT_PINS_RIGHT)
+    if (!is_keyboard_left()) {
+        half_pins = direct_pins_right;
+    }
+#endif
+
+    // Start from the current pin state so held keys do not produce edges
+    for (uint8_t key = 0; key < LOCAL_KEYS; key++) {
+        pins[key] = half_pins[key / MATRIX_COLS][key % MATRIX_COLS];
+        if (pins[key] != NO_PIN && !gpio_read_pin(pins[key])) {
+            stable |= (uint32_t)1 << key;
+        }
+    }
+
+    chVTObjectInit(&sampler);
+    chVTSet(&sampler, SAMPLE_TICKS, sample, NULL);
+}
+
+void key_timestamps_task(void) {
+    drain();  // Keeps queued ages well inside the 16-bit system time range
+}
+
+void key_timestamps_scan(void) {
+#ifdef SPLIT_KEYBOARD
+    if (is_keyboard_master()) {
+        sync_other_half();
+    }
+#endif
+}
+
+void key_timestamps_apply(keyrecord_t *record) {
+    keypos_t pos = record->event.key;
+    if (pos.row >= MATRIX_ROWS || pos.col >= MATRIX_COLS) {
+        return;  // Tick and combo events
+    }
+    uint8_t key = pos.row * MATRIX_COLS + pos.col;
+    bool pressed = record->event.pressed;
+
+    drain();
+    if (edge_matches(key, pressed, record->event.time)) {
+        uint16_t time = before_last(edge_time[key]) ? last_time : edge_time[key];
+        record->event.time = time ? time : 1;  // 0 reads as "no event" in older QMK
+        edge_flags[key] &= ~EDGE_FRESH;
+    }
+    if (!before_last(record->event.time)) {
+        last_time = record->event.time;
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Matrix edge timestamps taken at the pins instead of at the scan
+// A virtual timer samples the direct pins every KEY_TIMESTAMPS_INTERVAL_US
+// and pushes each edge (key, direction, system time) into a lock-free
+// single-producer / single-consumer queue. When QMK later reports the
+// debounced event, key_timestamps_apply() replaces record->event.time with
+// the edge time, so tap-hold and oneshot timing no longer depends on how
+// long the main loop was busy (RGB frames, split transactions, tap_code
+// delays). Edges from the other half are fetched over a split RPC as ages,
+// only in a scan where the other half's matrix changed, for the keys that
+// changed: the slave reports a key DEBOUNCE ms after its edge, so the edge
+// is known by then, and a scan without a new edge never waits on the link
+// for it. Stamped times never go back before the previous event's time, so
+// edges that arrive out of order between the halves cannot make a
+// TIMER_DIFF_16 wrap.
+//
+// Edges are never dropped: if the queue is full the ISR keeps the edge per
+// key and stops sampling that key until it fits.
+
+#ifndef KEY_TIMESTAMPS_INTERVAL_US
+#define KEY_TIMESTAMPS_INTERVAL_US 500  // Pin sampling period (2 kHz)
+#endif
+
+#ifndef KEY_TIMESTAMPS_LOCKOUT_MS
+#define KEY_TIMESTAMPS_LOCKOUT_MS DEBOUNCE  // Ignore bounce after an edge
+#endif
+
+#ifndef KEY_TIMESTAMPS_QUEUE_SIZE
+#define KEY_TIMESTAMPS_QUEUE_SIZE 64  // Edges, power of two <= 128
+#endif
+
+#ifndef KEY_TIMESTAMPS_MAX_AGE
+#define KEY_TIMESTAMPS_MAX_AGE 100  // ms, older edges are not applied to events
+#endif
+
+#ifndef KEY_TIMESTAMPS_SYNC_MAX_KEYS
+#define KEY_TIMESTAMPS_SYNC_MAX_KEYS 8  // Other half keys timed per scan, more changes get the scan time
+#endif
+
+// Start sampling (call from keyboard_post_init_user, on both halves)
+void key_timestamps_init(void);
+
+// Move queued edges into the per-key table (call every main loop iteration)
+void key_timestamps_task(void);
+
+// On the master, fetch the other half's edges when its matrix changed (call
+// from matrix_scan_user: after the split transport, before the events)
+void key_timestamps_scan(void);
+
+// Call first in pre_process_record_user: rewrites record->event.time with
+// the edge time of this key press/release when one is known
+void key_timestamps_apply(keyrecord_t *record);
@@ -1,5 +1,35 @@
 #include QMK_KEYBOARD_H
 #include "oneshot.h"
+#include "speculative_tap.h"
+#include "tap_tune.h"
+#include "mouse_keys.h"
+#ifdef TRIE_ENABLE
+#include "trie.h"
+#endif
+#include "fast_boot.h"
+#ifdef KEY_TIMESTAMPS_ENABLE
+#include "key_timestamps.h"
+#endif
+#include "raw_hid_cmds.h"
+#include "raw_hid.h"
+#ifdef QUANTUM_PAINTER_ENABLE
+#include "status_display.h"
+#endif
+#ifdef KEY_INDICATORS_ENABLE
+#include "key_indicators.h"
+#endif
+#ifdef PROTOCOL_CHIBIOS
+#include "rgb_thread.h"  // Main loop profile, with or without the RGB matrix
+#endif
+#ifdef MEMORY_MAP_ENABLE
+#include "memory_map.h"
+#endif
+#ifdef KEYMAP_OVERLAY_ENABLE
+#include "keymap_overlay.h"
+#endif
+#ifdef USB_SOF_SCHEDULE_ENABLE
+#include "usb_sof.h"
+#endif
 
 // Layer definitions
 enum layers {
@@ -36,6 +66,15 @@ enum custom_keycodes {
 
     // Common shortcuts (macOS - hardcoded)
     MY_SAVE,   // Cmd+S
+
+    // Mouse keys (mouse_keys.c)
+    MK_MODE,   // Toggle mouse mode: EXTEND arrows move the cursor, PgUp/PgDn/Home/End scroll
+    MK_BTN1,   // Left click
+    MK_BTN2,   // Right click
+    MK_BTN3,   // Middle click
+
+    // Autocorrect / abbreviations (trie.c)
+    TR_TOGG,   // Turn expansion off and on (not saved)
 };
 
 // Layer lock key (provided by QMK)
@@ -88,13 +127,15 @@ const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
     //       Home row: A=Shift/R=Alt/S=Gui/T=Ctrl/D=AltGr (consistent with SYM/NUM/FUN)
     // Right: PgUp/Home/↑/End/Caps, PgDn/←/↓/→/Del, F13
     // Clipboard: Undo/Cut/Copy/Paste/Redo on bottom row
+    // Mouse: MK_MODE turns the arrows into cursor keys and PgUp/PgDn/Home/End
+    //        into the wheel, clicks below PgDn/↓/→
     [_EXTEND] = LAYOUT_split_3x6_3(
   //┌────────┬────────┬────────┬────────┬────────┬────────┐                    ┌────────┬────────┬────────┬────────┬────────┬────────┐
-      KC_ESC,  KC_NO,   VIM_STA, VIM_FST, VIM_END, KC_NO,                        KC_PGUP, KC_HOME, KC_UP,   KC_END,  KC_CAPS, FUN_KEY,
+      KC_ESC,  KC_NO,   VIM_STA, VIM_FST, VIM_END, MK_MODE,                      KC_PGUP, KC_HOME, KC_UP,   KC_END,  KC_CAPS, FUN_KEY,
   //├────────┼────────┼────────┼────────┼────────┼────────┤                    ├────────┼────────┼────────┼────────┼────────┼────────┤
       MY_HYPR, OS_SHFT, OS_ALT,  OS_GUI,  OS_CTRL, OS_ALTGR,                     KC_PGDN, KC_LEFT, KC_DOWN, KC_RGHT, KC_DEL,  MY_MEH,
   //├────────┼────────┼────────┼────────┼────────┼────────┤                    ├────────┼────────┼────────┼────────┼────────┼────────┤
-      LLOCK,   MY_UNDO, MY_CUT,  MY_COPY, MY_PASTE,MY_REDO,                      KC_NO,   KC_F13,  KC_NO,   KC_NO,   KC_NO,   LLOCK,
+      LLOCK,   MY_UNDO, MY_CUT,  MY_COPY, MY_PASTE,MY_REDO,                      MK_BTN1, KC_F13,  MK_BTN2, MK_BTN3, KC_NO,   LLOCK,
   //└────────┴────────┴────────┼────────┼────────┼────────┤                    ├────────┼────────┼────────┼────────┴────────┴────────┘
                                  _______, _______, _______,                      _______, _______, _______
   //                            └────────┴────────┴────────┘                    └────────┴────────┴────────┘
@@ -148,7 +189,7 @@ const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
     // Right: Numpad-style F-keys (F7-9, F4-6, F1-3)
     [_FUN] = LAYOUT_split_3x6_3(
   //┌────────┬────────┬────────┬────────┬────────┬────────┐                    ┌────────┬────────┬────────┬────────┬────────┬────────┐
-      KC_NO,   KC_NO,   KC_NO,   KC_NO,   KC_F14,  KC_NO,                        KC_NO,   KC_F7,   KC_F8,   KC_F9,   KC_F10,  KC_NO,
+      KC_NO,   KC_NO,   KC_NO,   KC_NO,   KC_F14,  KC_NO,                        TR_TOGG, KC_F7,   KC_F8,   KC_F9,   KC_F10,  KC_NO,
   //├────────┼────────┼────────┼────────┼────────┼────────┤                    ├────────┼────────┼────────┼────────┼────────┼────────┤
       MY_HYPR, OS_SHFT, OS_ALT,  OS_GUI,  OS_CTRL, OS_ALTGR,                     KC_NO,   KC_F4,   KC_F5,   KC_F6,   KC_F11,  MY_MEH,
   //├────────┼────────┼────────┼────────┼────────┼────────┤                    ├────────┼────────┼────────┼────────┼────────┼────────┤
@@ -159,6 +200,10 @@ const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
     ),
 };
 
+#ifdef KEYMAP_OVERLAY_ENABLE
+_Static_assert(ARRAY_SIZE(keymaps) == KEYMAP_OVERLAY_LAYERS, "KEYMAP_OVERLAY_LAYERS (config.h) must match the layers in keymaps[]");
+#endif
+
 // ============================================================================
 // ONESHOT IMPLEMENTATION (Callum style, no timers)
 // ============================================================================
@@ -203,9 +248,135 @@ static oneshot_timers_t os_fun_timers = {0};
 // Hold FUN_KEY = momentary FUN layer (active while held)
 
 static bool fun_key_held = false;
+static bool fun_key_used = false;  // Another key was pressed while held (hold, for tap_tune)
 static bool fun_oneshot_active = false;
 static uint16_t fun_key_timer = 0;
 
+// ============================================================================
+// SELF-TUNING TIMING TERMS (tap_tune.c)
+// ============================================================================
+// Each dual-function key has its own histogram slot and derived term.
+// OS_SHFT tunes the caps word double-tap window (gap between two taps),
+// every other slot tunes its tap/hold threshold.
+
+enum tap_tune_slots {
+    TT_ESC_EXT = 0,
+    TT_TAB_SYM,
+    TT_FUN_KEY,
+    TT_OS_SHFT,
+    TT_OS_CTRL,
+    TT_OS_ALT,
+    TT_OS_GUI,
+    TT_OS_ALTGR,
+    TT_NONE = TAP_TUNE_SLOT_COUNT,
+};
+
+static bool shift_tap_pending = false;  // Last OS_SHFT tap may start a double-tap
+static uint16_t shift_tap_time = 0;
+_Static_assert(TAP_TUNE_SLOT_COUNT <= 8, "held_slots/used_slots hold one bit per slot");
+static uint8_t held_slots = 0;  // Bit per slot whose key is down
+static uint8_t used_slots = 0;  // ... with another key pressed since
+
+static uint8_t tap_tune_slot(uint16_t keycode) {
+    switch (keycode) {
+    case ESC_EXT:  return TT_ESC_EXT;
+    case TAB_SYM:  return TT_TAB_SYM;
+    case FUN_KEY:  return TT_FUN_KEY;
+    case OS_SHFT:  return TT_OS_SHFT;
+    case OS_CTRL:  return TT_OS_CTRL;
+    case OS_ALT:   return TT_OS_ALT;
+    case OS_GUI:   return TT_OS_GUI;
+    case OS_ALTGR: return TT_OS_ALTGR;
+    default:       return TT_NONE;
+    }
+}
+
+static oneshot_state *oneshot_state_for(uint16_t keycode) {
+    switch (keycode) {
+    case OS_SHFT:  return &os_shft_state;
+    case OS_CTRL:  return &os_ctrl_state;
+    case OS_ALT:   return &os_alt_state;
+    case OS_GUI:   return &os_gui_state;
+    case OS_ALTGR: return &os_altgr_state;
+    default:       return NULL;
+    }
+}
+
+// Classify a dual-function key event as tap or hold and feed its slot.
+// `before` is the key's oneshot state before update_oneshot* ran.
+// Samples are the real press duration on both sides of the term: a press
+// that outlasted it is still a tap when nothing else was pressed meanwhile
+// (a slow tap), and an unused oneshot is a hold once it outlasted its term.
+static void tap_tune_record(uint16_t keycode, keyrecord_t *record, oneshot_state before) {
+    uint8_t slot = tap_tune_slot(keycode);
+    uint16_t time = record->event.time;
+
+    if (record->event.pressed) {
+        used_slots |= held_slots;
+    }
+    if (slot == TT_NONE) {
+        // Consuming the queued shift ends any pending double-tap
+        if (os_shft_state == os_up_unqueued) {
+            shift_tap_pending = false;
+        }
+        return;
+    }
+
+    uint8_t bit = 1 << slot;
+    if (record->event.pressed) {
+        held_slots |= bit;
+        used_slots &= ~bit;
+        tap_tune_press(slot, time);
+        return;
+    }
+    held_slots &= ~bit;
+    bool used = used_slots & bit;
+    uint16_t held = tap_tune_held(slot, time);
+
+    switch (keycode) {
+    case ESC_EXT:
+    case TAB_SYM:
+        // A layer hold with no key pressed on the layer was meant as a tap
+        tap_tune_release(slot, time, record->tap.count == 0 && (used || held > TAP_TUNE_MAX_TERM));
+        break;
+    case FUN_KEY:
+        // Same guard: a hold past the longest term was not a tap whatever
+        // came of it, and would drag the tap percentile up
+        tap_tune_release(slot, time, fun_key_used || held > TAP_TUNE_MAX_TERM);
+        break;
+    case OS_SHFT:
+        // Clean tap: the gap to the previous tap is a double-tap sample if caps
+        // word toggled (state went back to unqueued), a separate tap otherwise
+        if (before == os_down_unused) {
+            bool double_tap = (os_shft_state == os_up_unqueued);
+            if (shift_tap_pending) {
+                tap_tune_sample(slot, TIMER_DIFF_16(time, shift_tap_time), !double_tap);
+            }
+            shift_tap_pending = !double_tap;
+            shift_tap_time = time;
+        }
+        break;
+    default:
+        if (before == os_down_unused || before == os_down_used) {
+            tap_tune_release(slot, time, before == os_down_used || held > get_oneshot_wait_term(keycode));
+        }
+        break;
+    }
+}
+
+uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record) {
+    uint8_t slot = tap_tune_slot(keycode);
+    return slot == TT_NONE ? TAPPING_TERM : tap_tune_term(slot, TAPPING_TERM);
+}
+
+uint16_t get_oneshot_wait_term(uint16_t trigger) {
+    return tap_tune_term(tap_tune_slot(trigger), FLOW_ONESHOT_WAIT_TERM);
+}
+
+uint16_t get_caps_word_double_tap_term(void) {
+    return tap_tune_term(TT_OS_SHFT, CAPS_WORD_DOUBLE_TAP_TERM);
+}
+
 // Define keys that cancel oneshot mods
 // Note: Layer-tap keys (ESC_EXT, TAB_SYM) are NOT cancel keys
 // They should consume oneshot mods when tapped, not cancel them
@@ -244,17 +415,214 @@ bool is_oneshot_ignored_key(uint16_t keycode) {
     // Other layer switching keys (FUN_KEY and LLOCK don't send characters, so safe to ignore)
     case FUN_KEY:
     case LLOCK:
+    case MK_MODE:
         return true;
     default:
         return false;
     }
 }
 
+// Layer-tap keys that resolve to a tap immediately during a typing streak
+bool is_speculative_tap_key(uint16_t keycode) {
+    switch (keycode) {
+    case ESC_EXT:
+    case TAB_SYM:
+        return true;
+    default:
+        return false;
+    }
+}
+
+#ifdef TRIE_ENABLE
+// Layer keys that neither feed nor reset the autocorrect matcher (trie.c)
+bool is_trie_ignored_key(uint16_t keycode) {
+    switch (keycode) {
+    case FUN_KEY:
+    case LLOCK:
+    case MK_MODE:
+        return true;
+    default:
+        return false;
+    }
+}
+#endif
+
+// ============================================================================
+// MOUSE KEYS (mouse_keys.c)
+// ============================================================================
+// Mouse mode reuses the EXTEND navigation cluster: arrows move the cursor,
+// PgUp/PgDn scroll vertically, Home/End horizontally. It ends with EXTEND.
+
+static bool mouse_mode = false;
+
+static uint8_t mouse_keys_action(uint16_t keycode, bool navigation) {
+    switch (keycode) {
+    case MK_BTN1: return MOUSE_KEYS_BTN1;
+    case MK_BTN2: return MOUSE_KEYS_BTN2;
+    case MK_BTN3: return MOUSE_KEYS_BTN3;
+    }
+    if (!navigation) {
+        return MOUSE_KEYS_NONE;
+    }
+    switch (keycode) {
+    case KC_UP:   return MOUSE_KEYS_UP;
+    case KC_DOWN: return MOUSE_KEYS_DOWN;
+    case KC_LEFT: return MOUSE_KEYS_LEFT;
+    case KC_RGHT: return MOUSE_KEYS_RIGHT;
+    case KC_PGUP: return MOUSE_KEYS_WHEEL_UP;
+    case KC_PGDN: return MOUSE_KEYS_WHEEL_DOWN;
+    case KC_HOME: return MOUSE_KEYS_WHEEL_LEFT;
+    case KC_END:  return MOUSE_KEYS_WHEEL_RIGHT;
+    default:      return MOUSE_KEYS_NONE;
+    }
+}
+
+// Returns false when the event drove the mouse
+static bool process_mouse_keys(uint16_t keycode, keyrecord_t *record) {
+    if (keycode == MK_MODE) {
+        if (record->event.pressed) {
+            mouse_mode = !mouse_mode;
+        }
+        return false;
+    }
+
+    if (record->event.pressed) {
+        uint8_t action = mouse_keys_action(keycode, mouse_mode);
+        if (action == MOUSE_KEYS_NONE) {
+            return true;
+        }
+        mouse_keys_press(action);
+        return false;
+    }
+
+    // Release what was pressed as a mouse action, even if the mode changed since
+    uint8_t action = mouse_keys_action(keycode, true);
+    if (!mouse_keys_is_held(action)) {
+        return true;
+    }
+    mouse_keys_release(action);
+    return false;
+}
+
+// ============================================================================
+// PRE PROCESS RECORD USER (Before tap-hold resolution)
+// ============================================================================
+// Runs before the tapping state machine, so ESC_EXT/TAB_SYM can be sent as
+// Esc/Tab on keydown while typing instead of waiting for release, and so the
+// pin-edge timestamp is in place before any timing decision reads it
+
+bool pre_process_record_user(uint16_t keycode, keyrecord_t *record) {
+#ifdef KEY_TIMESTAMPS_ENABLE
+    key_timestamps_apply(record);  // Pin edge time instead of scan time, before any timing decision
+#endif
+#ifdef TRIE_ENABLE
+    if (!trie_defer(record)) {
+        return false;  // Replayed once a pending expansion is sent
+    }
+#endif
+    return process_speculative_tap(keycode, record);
+}
+
+// ============================================================================
+// KEY INDICATORS (key_indicators.c)
+// ============================================================================
+// LEDs under the oneshot keys show queued / held, OS_SHFT shows caps word,
+// FUN_KEY shows oneshot / held / locked FUN and LLOCK takes the colour of
+// the top layer, bright once it is locked. indicators_refresh() is called
+// wherever one of these can change; the state word is only rebuilt there.
+
+#ifdef KEY_INDICATORS_ENABLE
+enum indicator_slots {
+    IND_OS_SHFT = 0,
+    IND_OS_CTRL,
+    IND_OS_ALT,
+    IND_OS_GUI,
+    IND_OS_ALTGR,
+    IND_FUN_KEY,
+    IND_LLOCK,
+};
+
+static uint8_t oneshot_indicator(oneshot_state state) {
+    switch (state) {
+    case os_down_unused:
+    case os_down_used:      return KEY_INDICATOR_HELD;
+    case os_up_queued:
+    case os_up_queued_used: return KEY_INDICATOR_QUEUED;
+    default:                return KEY_INDICATOR_OFF;
+    }
+}
+
+uint8_t key_indicators_slot(uint16_t keycode) {
+    switch (keycode) {
+    case OS_SHFT:  return IND_OS_SHFT;
+    case OS_CTRL:  return IND_OS_CTRL;
+    case OS_ALT:   return IND_OS_ALT;
+    case OS_GUI:   return IND_OS_GUI;
+    case OS_ALTGR: return IND_OS_ALTGR;
+    case FUN_KEY:  return IND_FUN_KEY;
+    case LLOCK:    return IND_LLOCK;
+    default:       return KEY_INDICATORS_NO_SLOT;
+    }
+}
+
+hsv_t key_indicators_color(uint8_t slot, uint32_t state) {
+    uint8_t value = KEY_INDICATOR_VALUE(state, slot);
+
+    if (slot == IND_LLOCK) {
+        static const uint8_t layer_hues[] = {
+            [_BASE] = 0, [_EXTEND] = 85, [_SYM] = 170, [_NUM] = 43, [_FUN] = 213,
+        };
+        uint8_t layer = get_highest_layer(KEY_INDICATORS_LAYER_STATE(state));
+        if (layer == _BASE || layer >= ARRAY_SIZE(layer_hues)) {
+            return (hsv_t){0, 0, 0};
+        }
+        return (hsv_t){layer_hues[layer], 255, value == KEY_INDICATOR_LOCKED ? 255 : 80};
+    }
+
+    switch (value) {
+    case KEY_INDICATOR_QUEUED: return (hsv_t){128, 255, 120};  // Dim cyan
+    case KEY_INDICATOR_HELD:   return (hsv_t){128, 255, 255};  // Cyan
+    case KEY_INDICATOR_LOCKED: return (hsv_t){21, 255, 255};   // Orange (caps word, locked FUN)
+    default:                   return (hsv_t){0, 0, 0};        // Effect shows through
+    }
+}
+#endif
+
+static void indicators_refresh(layer_state_t layers) {
+#ifdef KEY_INDICATORS_ENABLE
+    uint8_t fun = KEY_INDICATOR_OFF;
+    if (fun_key_held) {
+        fun = KEY_INDICATOR_HELD;
+    } else if (fun_oneshot_active) {
+        fun = KEY_INDICATOR_QUEUED;
+    } else if (is_layer_locked(_FUN)) {
+        fun = KEY_INDICATOR_LOCKED;
+    }
+
+    uint32_t state = KEY_INDICATORS_LAYERS(layers);
+    state |= KEY_INDICATOR(IND_OS_SHFT, is_caps_word_on() ? KEY_INDICATOR_LOCKED : oneshot_indicator(os_shft_state));
+    state |= KEY_INDICATOR(IND_OS_CTRL, oneshot_indicator(os_ctrl_state));
+    state |= KEY_INDICATOR(IND_OS_ALT, oneshot_indicator(os_alt_state));
+    state |= KEY_INDICATOR(IND_OS_GUI, oneshot_indicator(os_gui_state));
+    state |= KEY_INDICATOR(IND_OS_ALTGR, oneshot_indicator(os_altgr_state));
+    state |= KEY_INDICATOR(IND_FUN_KEY, fun);
+    if (is_layer_locked(get_highest_layer(layers))) {
+        state |= KEY_INDICATOR(IND_LLOCK, KEY_INDICATOR_LOCKED);
+    }
+    key_indicators_update(state);
+#endif
+}
+
 // ============================================================================
 // PROCESS RECORD USER (Custom key handling)
 // ============================================================================
 
 bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    speculative_tap_processed(record);  // Tapping buffer bookkeeping, before any early return
+#ifdef TRIE_ENABLE
+    trie_catch_up();  // From the tapping buffer: past trie_defer, must not overtake the queue
+#endif
+
     // ========================================================================
     // LLOCK (QMK Layer Lock) - Pass through to QMK for native handling
     // ========================================================================
@@ -264,6 +632,20 @@ bool process_record_user(uint16_t keycode, keyrecord_t *record) {
         return true;  // Let QMK's process_layer_lock() handle it
     }
 
+    // Oneshot state of this key before the update, for tap/hold classification
+    oneshot_state *trigger_state = oneshot_state_for(keycode);
+    oneshot_state trigger_before = trigger_state ? *trigger_state : os_up_unqueued;
+
+#ifdef FAST_BOOT_ENABLE
+    if (record->event.pressed) {
+        fast_boot_mark(FAST_BOOT_FIRST_KEY);
+    }
+#endif
+
+    if (fun_key_held && keycode != FUN_KEY && record->event.pressed) {
+        fun_key_used = true;
+    }
+
     // ========================================================================
     // ONESHOT SYSTEM (Custom implementation)
     // ========================================================================
@@ -279,6 +661,9 @@ bool process_record_user(uint16_t keycode, keyrecord_t *record) {
     // Oneshot layer with PR #16174 (independent timer and layer origin detection)
     update_oneshot_layer(&os_fun_state, &os_fun_timers, _FUN, OS_FUN, keycode, record);
 
+    tap_tune_record(keycode, record, trigger_before);
+    indicators_refresh(layer_state);
+
     // Prevent oneshot trigger keys from being processed further by QMK
     // The update_oneshot* functions handle the modifier registration/unregistration
     switch (keycode) {
@@ -291,6 +676,17 @@ bool process_record_user(uint16_t keycode, keyrecord_t *record) {
             return false;  // Don't let QMK process these custom keycodes
     }
 
+    if (!process_mouse_keys(keycode, record)) {
+        return false;
+    }
+
+#ifdef TRIE_ENABLE
+    // Autocorrect / abbreviation expansion (trie.c, dictionary in tools/trie_dict.txt)
+    if (!process_trie(keycode, record)) {
+        return false;
+    }
+#endif
+
     // Handle custom keycodes
     switch (keycode) {
         // ====================================================================
@@ -332,18 +728,27 @@ bool process_record_user(uint16_t keycode, keyrecord_t *record) {
             }
             return false;
 
+#ifdef TRIE_ENABLE
+        case TR_TOGG:
+            if (record->event.pressed) {
+                trie_toggle();
+            }
+            break;  // Its release still ends oneshot FUN below
+#endif
+
         // ====================================================================
         // FUN_KEY: Dual-function (Tap = one-shot FUN, Hold = momentary FUN)
         // ====================================================================
         case FUN_KEY:
             if (record->event.pressed) {
                 // Key pressed - start timer and activate layer
-                fun_key_timer = timer_read();
+                fun_key_timer = record->event.time;
                 fun_key_held = true;
+                fun_key_used = false;
                 layer_on(_FUN);
             } else {
                 // Key released
-                if (fun_key_held && timer_elapsed(fun_key_timer) < TAPPING_TERM) {
+                if (fun_key_held && TIMER_DIFF_16(record->event.time, fun_key_timer) < tap_tune_term(TT_FUN_KEY, TAPPING_TERM)) {
                     // Quick tap - activate one-shot layer
                     fun_oneshot_active = true;
                     // Layer stays on for next keypress
@@ -353,6 +758,7 @@ bool process_record_user(uint16_t keycode, keyrecord_t *record) {
                 }
                 fun_key_held = false;
             }
+            indicators_refresh(layer_state);
             return false;
     }
 
@@ -376,16 +782,25 @@ bool process_record_user(uint16_t keycode, keyrecord_t *record) {
 // ============================================================================
 
 void matrix_scan_user(void) {
+#ifdef KEY_TIMESTAMPS_ENABLE
+    key_timestamps_scan();  // Other half's edges, before its changes become events
+#endif
+
     // Shift uses Callum (no timeout check needed - waits indefinitely)
 
     // Check other modifier timeouts with independent timers
     // Auto-release after FLOW_ONESHOT_TERM (500ms) if unused
-    check_oneshot_timeout(&os_ctrl_state, &os_ctrl_timers, KC_LCTL);
-    check_oneshot_timeout(&os_alt_state, &os_alt_timers, KC_LALT);
-    check_oneshot_timeout(&os_gui_state, &os_gui_timers, KC_LGUI);
-    check_oneshot_timeout(&os_altgr_state, &os_altgr_timers, KC_RALT);
+    bool expired = false;
+    expired |= check_oneshot_timeout(&os_ctrl_state, &os_ctrl_timers, KC_LCTL);
+    expired |= check_oneshot_timeout(&os_alt_state, &os_alt_timers, KC_LALT);
+    expired |= check_oneshot_timeout(&os_gui_state, &os_gui_timers, KC_LGUI);
+    expired |= check_oneshot_timeout(&os_altgr_state, &os_altgr_timers, KC_RALT);
+    if (expired) {
+        indicators_refresh(layer_state);
+    }
 
     // Check oneshot layer timeout with independent timer
+    // (layer_off reaches indicators_refresh through layer_state_set_user)
     check_oneshot_layer_timeout(&os_fun_state, &os_fun_timers, _FUN);
 }
 
@@ -395,7 +810,18 @@ void matrix_scan_user(void) {
 
 layer_state_t layer_state_set_user(layer_state_t state) {
     // When both EXTEND and SYM are active, activate NUM layer
-    return update_tri_layer_state(state, _EXTEND, _SYM, _NUM);
+    state = update_tri_layer_state(state, _EXTEND, _SYM, _NUM);
+
+    if (!layer_state_cmp(state, _EXTEND)) {
+        mouse_mode = false;
+    }
+    indicators_refresh(state);
+    return state;
+}
+
+bool layer_lock_set_user(layer_state_t locked_layers) {
+    indicators_refresh(layer_state);
+    return true;
 }
 
 // ============================================================================
@@ -424,3 +850,161 @@ bool caps_word_press_user(uint16_t keycode) {
             return false;
     }
 }
+
+void caps_word_set_user(bool active) {
+    indicators_refresh(layer_state);
+}
+
+// ============================================================================
+// INIT / HOUSEKEEPING
+// ============================================================================
+// Only what is needed to send keystrokes runs in keyboard_post_init_user;
+// the rest waits in fast_boot_deferred_init() until USB is configured.
+
+#ifdef RGB_MATRIX_ENABLE
+static bool rgb_deferred = false;  // Effect was on at boot, restarted by the deferred init
+#endif
+
+#ifdef FAST_BOOT_ENABLE
+void keyboard_pre_init_user(void) {
+    fast_boot_mark(FAST_BOOT_PRE_INIT);
+}
+
+void matrix_init_user(void) {
+    fast_boot_mark(FAST_BOOT_MATRIX_INIT);
+}
+#endif
+
+void keyboard_post_init_user(void) {
+#ifdef KEYMAP_OVERLAY_ENABLE
+    keymap_overlay_init();  // Persisted layout, before the first keystroke
+#endif
+#ifdef KEY_TIMESTAMPS_ENABLE
+    key_timestamps_init();
+#endif
+#ifdef KEY_INDICATORS_ENABLE
+    key_indicators_init();  // Split RPC, registered on both halves before the first transaction
+#endif
+#ifdef RGB_MATRIX_ENABLE
+    rgb_deferred = rgb_matrix_is_enabled();
+    if (rgb_deferred) {
+        rgb_matrix_disable_noeeprom();
+    }
+#endif
+#ifdef FAST_BOOT_ENABLE
+    fast_boot_mark(FAST_BOOT_POST_INIT);
+#else
+    fast_boot_deferred_init();
+#endif
+}
+
+void fast_boot_deferred_init(void) {
+    tap_tune_init();  // EEPROM read
+#ifdef QUANTUM_PAINTER_ENABLE
+    status_display_init();
+#endif
+#ifdef RGB_MATRIX_ENABLE
+    if (rgb_deferred) {
+        rgb_thread_lock();  // Housekeeping, outside the main loop entry points that lock
+        rgb_matrix_enable_noeeprom();
+        rgb_thread_unlock();
+    }
+#endif
+}
+
+void housekeeping_task_user(void) {
+#ifdef FAST_BOOT_ENABLE
+    fast_boot_task();
+#endif
+#ifdef KEY_TIMESTAMPS_ENABLE
+    key_timestamps_task();
+#endif
+#ifdef KEYMAP_OVERLAY_ENABLE
+    if (keymap_overlay_task()) {
+#ifdef KEY_INDICATORS_ENABLE
+        key_indicators_invalidate();  // Indicator LEDs follow their keys to the new positions
+#endif
+    }
+#endif
+    tap_tune_task();
+    mouse_keys_task();
+#ifdef TRIE_ENABLE
+    trie_task();
+#endif
+#ifdef QUANTUM_PAINTER_ENABLE
+    status_display_task();
+#endif
+#ifdef KEY_INDICATORS_ENABLE
+    key_indicators_task();
+#endif
+}
+
+#ifdef KEY_INDICATORS_ENABLE
+bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {
+    key_indicators_render(led_min, led_max);
+    return false;
+}
+#endif
+
+#ifdef QUANTUM_PAINTER_ENABLE
+// ============================================================================
+// STATUS DISPLAY
+// ============================================================================
+
+const char *status_display_layer_name(uint8_t layer) {
+    switch (layer) {
+    case _BASE:   return "BASE";
+    case _EXTEND: return "EXTEND";
+    case _SYM:    return "SYM";
+    case _NUM:    return "NUM";
+    case _FUN:    return "FUN";
+    default:      return "";
+    }
+}
+#endif
+
+// ============================================================================
+// RAW HID (host tools in tools/)
+// ============================================================================
+
+void raw_hid_receive(uint8_t *data, uint8_t length) {
+    switch (data[0]) {
+        case RAW_CMD_TAP_TUNE:
+            tap_tune_raw_hid(data, length);
+            break;
+#ifdef FAST_BOOT_ENABLE
+        case RAW_CMD_BOOT:
+            fast_boot_raw_hid(data, length);
+            break;
+#endif
+#ifdef QUANTUM_PAINTER_ENABLE
+        case RAW_CMD_DISPLAY:
+            status_display_raw_hid(data, length);
+            break;
+#endif
+#ifdef KEYMAP_OVERLAY_ENABLE
+        case RAW_CMD_KEYMAP:
+            keymap_overlay_raw_hid(data, length);
+            break;
+#endif
+#ifdef MEMORY_MAP_ENABLE
+        case RAW_CMD_MEMORY:
+            memory_map_raw_hid(data, length);
+            break;
+#endif
+#ifdef PROTOCOL_CHIBIOS
+        case RAW_CMD_RGB_LOOP:
+            rgb_thread_raw_hid(data, length);
+            break;
+#endif
+#ifdef USB_SOF_SCHEDULE_ENABLE
+        case RAW_CMD_USB_SOF:
+            usb_sof_raw_hid(data, length);
+            break;
+#endif
+        default:
+            data[0] = RAW_CMD_UNKNOWN;
+            break;
+    }
+    raw_hid_send(data, length);
+}
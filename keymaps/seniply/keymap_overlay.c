@@ -0,0 +1,190 @@
+#include "keymap_overlay.h"
+
+#include <string.h>
+
+#define KEYMAP_OVERLAY_MAGIC 0x4B  // 'K' - marks a persisted overlay
+
+typedef uint16_t layer_t[MATRIX_ROWS][MATRIX_COLS];
+
+typedef struct {
+    uint8_t  magic;
+    uint8_t  layers;
+    uint16_t crc;
+} overlay_header_t;
+
+#define BANK_BYTES sizeof(layer_t[KEYMAP_OVERLAY_LAYERS])
+
+_Static_assert(KEYMAP_OVERLAY_EEPROM_OFFSET + sizeof(overlay_header_t) + BANK_BYTES <= EECONFIG_USER_DATA_SIZE, "EECONFIG_USER_DATA_SIZE too small for the persisted keymap overlay");
+
+extern const uint16_t keymaps[][MATRIX_ROWS][MATRIX_COLS];
+
+// ============================================================================
+// STATE
+// ============================================================================
+
+static layer_t banks[2][KEYMAP_OVERLAY_LAYERS];
+
+static const layer_t *active  = keymaps;  // What keycode lookups read
+static const layer_t *pending = NULL;     // Swap target, waiting for all keys up
+static uint8_t        staging = 0;        // Bank the host writes, never the active one
+static uint16_t       active_crc = 0;
+static bool           persisted  = false;
+
+// CRC-16/CCITT-FALSE (binascii.crc_hqx(data, 0xFFFF) on the host)
+static uint16_t crc16(const uint8_t *data, uint16_t length) {
+    uint16_t crc = 0xFFFF;
+    for (uint16_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+// ============================================================================
+// KEYCODE LOOKUP (replaces QMK's weak keymap_introspection.c version)
+// ============================================================================
+
+uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
+    if (layer_num < KEYMAP_OVERLAY_LAYERS && row < MATRIX_ROWS && column < MATRIX_COLS) {
+        return active[layer_num][row][column];
+    }
+    return KC_TRNS;
+}
+
+// ============================================================================
+// SWAP AND PERSISTENCE (EECONFIG user datablock)
+// ============================================================================
+
+void keymap_overlay_init(void) {
+    overlay_header_t header;
+    eeconfig_read_user_datablock(&header, KEYMAP_OVERLAY_EEPROM_OFFSET, sizeof(header));
+    if (header.magic != KEYMAP_OVERLAY_MAGIC || header.layers != KEYMAP_OVERLAY_LAYERS) {
+        return;
+    }
+    eeconfig_read_user_datablock(banks[0], KEYMAP_OVERLAY_EEPROM_OFFSET + sizeof(header), BANK_BYTES);
+    if (crc16((const uint8_t *)banks[0], BANK_BYTES) != header.crc) {
+        return;  // Torn write - keep the compiled keymap
+    }
+    active     = banks[0];
+    active_crc = header.crc;
+    staging    = 1;
+    persisted  = true;
+}
+
+static bool matrix_idle(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (matrix_get_row(row)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool keymap_overlay_task(void) {
+    if (pending == NULL || !matrix_idle()) {
+        return false;
+    }
+    active = pending;
+    if (pending == banks[staging]) {
+        staging ^= 1;
+    }
+    pending = NULL;
+    return true;
+}
+
+static void persist(uint16_t crc) {
+    overlay_header_t header = {KEYMAP_OVERLAY_MAGIC, KEYMAP_OVERLAY_LAYERS, crc};
+    eeconfig_update_user_datablock(banks[staging], KEYMAP_OVERLAY_EEPROM_OFFSET + sizeof(header), BANK_BYTES);
+    eeconfig_update_user_datablock(&header, KEYMAP_OVERLAY_EEPROM_OFFSET, sizeof(header));  // Header last
+    persisted = true;
+}
+
+static void forget(void) {
+    overlay_header_t header = {0, 0, 0};
+    eeconfig_update_user_datablock(&header, KEYMAP_OVERLAY_EEPROM_OFFSET, sizeof(header));
+    persisted = false;
+}
+
+// ============================================================================
+// RAW HID (host tool: tools/keymap_overlay.py)
+// ============================================================================
+
+static uint8_t op_write(const uint8_t *data, uint16_t offset, uint8_t count) {
+    if (count > KEYMAP_OVERLAY_CHUNK || offset + count > BANK_BYTES) {
+        return KEYMAP_OVERLAY_BAD_RANGE;
+    }
+    if (pending == banks[staging]) {
+        pending = NULL;  // Overwritten before the swap, the next apply decides
+    }
+    memcpy((uint8_t *)banks[staging] + offset, &data[6], count);
+    return KEYMAP_OVERLAY_OK;
+}
+
+static uint8_t op_read(uint8_t *data, uint16_t offset, uint8_t count) {
+    if (count > KEYMAP_OVERLAY_CHUNK || offset + count > BANK_BYTES) {
+        return KEYMAP_OVERLAY_BAD_RANGE;
+    }
+    memcpy(&data[6], (const uint8_t *)active + offset, count);
+    return KEYMAP_OVERLAY_OK;
+}
+
+static uint8_t op_apply(uint16_t crc, uint8_t flags) {
+    if (crc16((const uint8_t *)banks[staging], BANK_BYTES) != crc) {
+        return KEYMAP_OVERLAY_BAD_CRC;
+    }
+    if (flags & 1) {
+        persist(crc);
+    }
+    pending    = banks[staging];
+    active_crc = crc;
+    return KEYMAP_OVERLAY_OK;
+}
+
+static uint8_t op_revert(uint8_t flags) {
+    if (flags & 1) {
+        forget();
+    }
+    pending    = keymaps;
+    active_crc = 0;
+    return KEYMAP_OVERLAY_OK;
+}
+
+void keymap_overlay_raw_hid(uint8_t *data, uint8_t length) {
+    if (length < 6 + KEYMAP_OVERLAY_CHUNK) {
+        return;
+    }
+    uint8_t  op     = data[1];
+    uint16_t offset = data[3] | data[4] << 8;
+    uint8_t  count  = data[5];
+    uint8_t  status = KEYMAP_OVERLAY_OK;
+
+    switch (op) {
+        case KEYMAP_OVERLAY_INFO:
+            data[3]  = KEYMAP_OVERLAY_LAYERS;
+            data[4]  = MATRIX_ROWS;
+            data[5]  = MATRIX_COLS;
+            data[6]  = active != keymaps;
+            data[7]  = (pending != NULL) | persisted << 1;
+            data[8]  = active_crc & 0xFF;
+            data[9]  = active_crc >> 8;
+            break;
+        case KEYMAP_OVERLAY_WRITE:
+            status = op_write(data, offset, count);
+            break;
+        case KEYMAP_OVERLAY_APPLY:
+            status = op_apply(data[3] | data[4] << 8, data[5]);
+            break;
+        case KEYMAP_OVERLAY_REVERT:
+            status = op_revert(data[3]);
+            break;
+        case KEYMAP_OVERLAY_READ:
+            status = op_read(data, offset, count);
+            break;
+        default:
+            status = KEYMAP_OVERLAY_BAD_OP;
+            break;
+    }
+    data[2] = status;
+}
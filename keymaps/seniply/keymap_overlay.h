@@ -0,0 +1,51 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// RAM keymap overlay, hot-loaded over raw HID
+// Layout iteration without DFU: tools/keymap_overlay.py compiles keymap.c
+// on the host (sim/ shim, same keycode values), uploads the keycodes into a
+// RAM bank and applies it:
+//   upload   chunks written to the staging bank, never the active one
+//   apply    CRC-16 of the whole bank checked, then the swap is queued
+//   swap     one pointer store in keymap_overlay_task(), once no key is
+//            down, so a held key is never released on another layout
+// keycode_at_keymap_location() reads through that pointer: the compiled
+// keymaps[] in flash or a RAM bank, the same load either way. Two banks of
+// KEYMAP_OVERLAY_LAYERS x MATRIX_ROWS x MATRIX_COLS keycodes (960 bytes).
+// An applied overlay can be persisted in the EECONFIG user datablock and is
+// loaded again at boot; only the half with USB (the master) uses it.
+
+#ifndef KEYMAP_OVERLAY_EEPROM_OFFSET
+#define KEYMAP_OVERLAY_EEPROM_OFFSET 16  // Offset in the EECONFIG user datablock
+#endif
+
+#define KEYMAP_OVERLAY_CHUNK 26  // Keycode bytes per raw HID report (13 keycodes)
+
+enum keymap_overlay_ops {
+    KEYMAP_OVERLAY_INFO,    // -> layers, rows, cols, source, flags, active CRC
+    KEYMAP_OVERLAY_WRITE,   // offset u16, length, bytes -> staging bank
+    KEYMAP_OVERLAY_APPLY,   // CRC u16, flags (bit 0: persist) -> swap queued
+    KEYMAP_OVERLAY_REVERT,  // flags (bit 0: forget the persisted one)
+    KEYMAP_OVERLAY_READ,    // offset u16, length -> bytes of the active keymap
+};
+
+enum keymap_overlay_status {
+    KEYMAP_OVERLAY_OK,
+    KEYMAP_OVERLAY_BAD_RANGE,
+    KEYMAP_OVERLAY_BAD_CRC,
+    KEYMAP_OVERLAY_BAD_OP,
+};
+
+// Load a persisted overlay (call before the first scan, keystrokes use it)
+void keymap_overlay_init(void);
+
+// Queued swap, once all keys are up (call from housekeeping_task_user).
+// True when the active keymap changed.
+bool keymap_overlay_task(void);
+
+// Raw HID: [cmd, op, status, offset u16, length, bytes...]; INFO replies
+// [cmd, op, status, layers, rows, cols, source (0 flash, 1 RAM), flags
+// (bit 0 swap pending, bit 1 persisted), CRC u16 of the last applied
+// overlay, 0 for the compiled keymap]
+void keymap_overlay_raw_hid(uint8_t *data, uint8_t length);
@@ -0,0 +1,131 @@
+#include "memory_map.h"
+#include "stopwatch.h"
+
+#include <ch.h>
+#include <string.h>
+
+#if __has_include("ram_map_data.h")
+#include "ram_map_data.h"
+#else
+#define RAM_MAP_STATIC_BYTES 0  // Not generated yet (tools/ram_map.py --header)
+#define RAM_MAP_ENTRIES 0
+#endif
+
+#if CH_DBG_FILL_THREADS != TRUE || CH_DBG_ENABLE_STACK_CHECK != TRUE
+#error "memory_map.c needs CH_DBG_FILL_THREADS and CH_DBG_ENABLE_STACK_CHECK (keyboard chconf.h)"
+#endif
+
+#define STACK_FILL 0x55  // CRT0_STACKS_FILL_PATTERN and CH_DBG_STACK_FILL_VALUE
+
+// ChibiOS linker script symbols
+extern uint8_t __main_stack_base__[], __main_stack_end__[];        // ISRs
+extern uint8_t __process_stack_base__[], __process_stack_end__[];  // Main thread
+extern uint8_t __data_base__[], __data_end__[];
+extern uint8_t __bss_base__[], __bss_end__[];
+extern uint8_t __heap_base__[], __heap_end__[];
+
+typedef struct {
+    const char *name;
+    uint16_t a;
+    uint16_t b;
+} entry_t;
+
+// ============================================================================
+// STACKS
+// ============================================================================
+
+// Stacks grow down: the fill pattern left at the bottom was never reached
+static uint16_t stack_used(const uint8_t *base, const uint8_t *end) {
+    const uint8_t *p = base;
+    while (p < end && *p == STACK_FILL) {
+        p++;
+    }
+    return end - p;
+}
+
+// Entry 0 is the ISR stack, then the threads in registry order. A thread's
+// working area ends at its thread_t, the main thread runs on the process
+// stack instead.
+static uint8_t stack_entry(uint8_t index, entry_t *entry) {
+    uint8_t count = 1;
+    if (index == 0) {
+        *entry = (entry_t){"isr", __main_stack_end__ - __main_stack_base__,
+                           stack_used(__main_stack_base__, __main_stack_end__)};
+    }
+    for (thread_t *tp = chRegFirstThread(); tp != NULL; tp = chRegNextThread(tp), count++) {
+        if (count != index) {
+            continue;
+        }
+        const uint8_t *base = (const uint8_t *)tp->wabase;
+        const uint8_t *end = base == __process_stack_base__ ? __process_stack_end__ : (const uint8_t *)tp;
+        const char *name = chRegGetThreadNameX(tp);
+        *entry = (entry_t){name ? name : "?", end - base, stack_used(base, end)};
+    }
+    return count;
+}
+
+// ============================================================================
+// REGIONS AND STATIC MAP
+// ============================================================================
+
+static uint16_t static_bytes(void) {
+    return (__data_end__ - __data_base__) + (__bss_end__ - __bss_base__);
+}
+
+static uint8_t region_entry(uint8_t index, entry_t *entry) {
+    const entry_t regions[] = {
+        {"data", __data_end__ - __data_base__, 0},
+        {"bss", __bss_end__ - __bss_base__, 0},
+        {"heap", __heap_end__ - __heap_base__, chCoreGetStatusX()},
+        {"isr stack", __main_stack_end__ - __main_stack_base__, 0},
+        {"main stack", __process_stack_end__ - __process_stack_base__, 0},
+    };
+    if (index < ARRAY_SIZE(regions)) {
+        *entry = regions[index];
+    }
+    return ARRAY_SIZE(regions);
+}
+
+static uint8_t static_entry(uint8_t index, entry_t *entry) {
+#if RAM_MAP_ENTRIES > 0
+    if (index < RAM_MAP_ENTRIES) {
+        *entry = (entry_t){ram_map[index].name, ram_map[index].bytes, 0};
+    }
+#endif
+    return RAM_MAP_ENTRIES;
+}
+
+// ============================================================================
+// RAW HID
+// ============================================================================
+
+void memory_map_raw_hid(uint8_t *data, uint8_t length) {
+    if (length < 9 + MEMORY_MAP_NAME_LENGTH) {
+        return;
+    }
+    uint8_t page = data[1];
+    uint8_t index = data[2];
+    entry_t entry = {"", 0, 0};
+    uint8_t count = 0;
+    uint8_t flags = 0;
+
+    switch (page) {
+        case MEMORY_MAP_STACKS:
+            count = stack_entry(index, &entry);
+            break;
+        case MEMORY_MAP_REGIONS:
+            count = region_entry(index, &entry);
+            break;
+        case MEMORY_MAP_STATIC:
+            count = static_entry(index, &entry);
+            flags = RAM_MAP_STATIC_BYTES == static_bytes();
+            break;
+    }
+
+    data[3] = count;
+    uint8_t i = stopwatch_put_u16(data, 4, entry.a);
+    i = stopwatch_put_u16(data, i, entry.b);
+    data[i] = flags;
+    memset(&data[9], 0, MEMORY_MAP_NAME_LENGTH);
+    strncpy((char *)&data[9], entry.name, MEMORY_MAP_NAME_LENGTH - 1);
+}
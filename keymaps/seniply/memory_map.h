@@ -0,0 +1,35 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// RAM use on the device: stack high-water marks and a static map
+// The 16 KB of SRAM hold .data/.bss, the ChibiOS core heap, the ISR stack
+// and one stack per thread (main loop, idle, RGB render, split slave). An
+// overflowing stack runs into static data without any error, so:
+//   stacks   crt0 fills the ISR and main stacks and ChibiOS every thread
+//            working area with 0x55 (CH_DBG_FILL_THREADS, keyboard
+//            chconf.h); the untouched part from the bottom up gives the
+//            deepest use so far. Threads come from the ChibiOS registry.
+//   regions  .data, .bss, heap and stacks from the linker symbols
+//   static   .data + .bss per subsystem (RGB, split, EEPROM cache, oneshot,
+//            ...), generated from the ELF by tools/ram_map.py into
+//            ram_map_data.h and flagged when it does not match the build
+// All three are read over raw HID by tools/ram_map.py --device.
+
+enum memory_map_pages {
+    MEMORY_MAP_STACKS,   // a = size, b = high-water mark
+    MEMORY_MAP_REGIONS,  // a = bytes, b = bytes free (heap)
+    MEMORY_MAP_STATIC,   // a = bytes
+};
+
+#define MEMORY_MAP_NAME_LENGTH 16
+
+typedef struct {
+    char name[MEMORY_MAP_NAME_LENGTH];
+    uint16_t bytes;
+} memory_map_entry_t;
+
+// Raw HID: [cmd, page, index] -> [cmd, page, index, entry count, a u16,
+// b u16, flags, name (NUL padded)]. flags bit 0 on the static page: the
+// generated map matches the running build.
+void memory_map_raw_hid(uint8_t *data, uint8_t length);
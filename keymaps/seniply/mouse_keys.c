@@ -0,0 +1,183 @@
+#include "mouse_keys.h"
+
+// ============================================================================
+// ACCELERATION CURVES
+// ============================================================================
+// Speeds are Q8.8 units per tick, sampled at CURVE_STEPS + 1 points of a
+// smoothstep from SPEED_MIN to SPEED_MAX over TIME_TO_MAX and linearly
+// interpolated in between. Everything is folded at compile time.
+
+#define CURVE_STEPS 16
+
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+#define WHEEL_UNITS POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER  // Report units per detent
+#else
+#define WHEEL_UNITS 1
+#endif
+
+#define PER_TICK(per_second) ((uint32_t)(per_second) * 256 * MOUSE_KEYS_INTERVAL / 1000)
+#define CURVE(lo, hi, i) \
+    (PER_TICK(lo) + (PER_TICK(hi) - PER_TICK(lo)) * (i) * (i) * (3 * CURVE_STEPS - 2 * (i)) / (CURVE_STEPS * CURVE_STEPS * CURVE_STEPS))
+#define CURVE_TABLE(lo, hi) \
+    { CURVE(lo, hi, 0),  CURVE(lo, hi, 1),  CURVE(lo, hi, 2),  CURVE(lo, hi, 3),  CURVE(lo, hi, 4),  CURVE(lo, hi, 5), \
+      CURVE(lo, hi, 6),  CURVE(lo, hi, 7),  CURVE(lo, hi, 8),  CURVE(lo, hi, 9),  CURVE(lo, hi, 10), CURVE(lo, hi, 11), \
+      CURVE(lo, hi, 12), CURVE(lo, hi, 13), CURVE(lo, hi, 14), CURVE(lo, hi, 15), CURVE(lo, hi, 16) }
+
+_Static_assert(PER_TICK(MOUSE_KEYS_SPEED_MAX) <= UINT16_MAX, "MOUSE_KEYS_SPEED_MAX too high for the Q8.8 table");
+_Static_assert(PER_TICK(MOUSE_KEYS_WHEEL_SPEED_MAX * WHEEL_UNITS) <= UINT16_MAX, "MOUSE_KEYS_WHEEL_SPEED_MAX too high for the Q8.8 table");
+
+static const uint16_t cursor_curve[CURVE_STEPS + 1] = CURVE_TABLE(MOUSE_KEYS_SPEED_MIN, MOUSE_KEYS_SPEED_MAX);
+static const uint16_t wheel_curve[CURVE_STEPS + 1] =
+    CURVE_TABLE(MOUSE_KEYS_WHEEL_SPEED_MIN * WHEEL_UNITS, MOUSE_KEYS_WHEEL_SPEED_MAX * WHEEL_UNITS);
+
+static uint16_t curve_speed(const uint16_t *curve, uint16_t held_ms, uint16_t time_to_max) {
+    if (held_ms >= time_to_max) {
+        return curve[CURVE_STEPS];
+    }
+    uint32_t pos = (uint32_t)held_ms * CURVE_STEPS * 256 / time_to_max;  // Q8 table index
+    uint8_t i = pos >> 8;
+    return curve[i] + (((int32_t)curve[i + 1] - curve[i]) * (int32_t)(pos & 0xFF) >> 8);
+}
+
+// ============================================================================
+// MOTION
+// ============================================================================
+
+typedef struct {
+    const uint16_t *curve;
+    uint16_t time_to_max;
+    uint8_t neg_x, pos_x, neg_y, pos_y;  // Actions driving each axis
+    int32_t acc_x;                       // Q8.8 sub-unit remainders
+    int32_t acc_y;
+    uint16_t start;                      // Tick time the motion started
+    bool active;
+} motion_t;
+
+static motion_t cursor = {
+    .curve = cursor_curve, .time_to_max = MOUSE_KEYS_TIME_TO_MAX,
+    .neg_x = MOUSE_KEYS_LEFT, .pos_x = MOUSE_KEYS_RIGHT, .neg_y = MOUSE_KEYS_UP, .pos_y = MOUSE_KEYS_DOWN,
+};
+static motion_t wheel = {
+    .curve = wheel_curve, .time_to_max = MOUSE_KEYS_WHEEL_TIME_TO_MAX,
+    .neg_x = MOUSE_KEYS_WHEEL_LEFT, .pos_x = MOUSE_KEYS_WHEEL_RIGHT, .neg_y = MOUSE_KEYS_WHEEL_DOWN, .pos_y = MOUSE_KEYS_WHEEL_UP,
+};
+
+static uint16_t held = 0;  // Bit per action
+static uint8_t buttons = 0;
+static uint16_t last_tick = 0;
+
+#define MOTION_MASK ((1 << MOUSE_KEYS_BTN1) - 1)
+
+bool mouse_keys_is_held(uint8_t action) {
+    return action < MOUSE_KEYS_ACTION_COUNT && (held & (1 << action));
+}
+
+static int8_t axis(uint8_t neg, uint8_t pos) {
+    return (int8_t)mouse_keys_is_held(pos) - (int8_t)mouse_keys_is_held(neg);
+}
+
+// Whole units moved out of the accumulator, remainder kept
+static int32_t take_whole(int32_t *acc) {
+    int32_t whole = *acc / 256;
+    *acc -= whole * 256;
+    return whole;
+}
+
+// One tick of motion at tick time `now`
+static void step(motion_t *m, uint16_t now, int32_t *out_x, int32_t *out_y) {
+    int8_t dx = axis(m->neg_x, m->pos_x);
+    int8_t dy = axis(m->neg_y, m->pos_y);
+
+    if (!dx && !dy) {
+        m->active = false;
+        m->acc_x = m->acc_y = 0;
+        return;
+    }
+    if (!m->active) {
+        m->active = true;
+        m->start = now;
+    }
+
+    int32_t speed = curve_speed(m->curve, TIMER_DIFF_16(now, m->start), m->time_to_max);
+    if (dx && dy) {
+        speed = speed * 181 >> 8;  // 1/sqrt(2): diagonals move at the same speed
+    }
+    m->acc_x += dx * speed;
+    m->acc_y += dy * speed;
+    *out_x += take_whole(&m->acc_x);
+    *out_y += take_whole(&m->acc_y);
+}
+
+// ============================================================================
+// REPORTS
+// ============================================================================
+
+#define XY_MAX ((1L << (8 * sizeof(mouse_xy_report_t) - 1)) - 1)
+#define HV_MAX ((1L << (8 * sizeof(mouse_hv_report_t) - 1)) - 1)
+
+static int32_t clamp(int32_t value, int32_t limit) {
+    return value > limit ? limit : value < -limit ? -limit : value;
+}
+
+static void send_report(int32_t x, int32_t y, int32_t h, int32_t v) {
+    report_mouse_t report = {0};
+    report.buttons = buttons;
+    report.x = clamp(x, XY_MAX);
+    report.y = clamp(y, XY_MAX);
+    report.h = clamp(h, HV_MAX);
+    report.v = clamp(v, HV_MAX);
+    host_mouse_send(&report);
+}
+
+void mouse_keys_press(uint8_t action) {
+    if (action >= MOUSE_KEYS_ACTION_COUNT) {
+        return;
+    }
+    if (!(held & MOTION_MASK) && action < MOUSE_KEYS_BTN1) {
+        last_tick = timer_read();  // Start ticking from the press, not from the last motion
+    }
+    held |= 1 << action;
+    if (action >= MOUSE_KEYS_BTN1) {
+        buttons |= 1 << (action - MOUSE_KEYS_BTN1);
+        send_report(0, 0, 0, 0);
+    }
+}
+
+void mouse_keys_release(uint8_t action) {
+    if (action >= MOUSE_KEYS_ACTION_COUNT) {
+        return;
+    }
+    held &= ~(1 << action);
+    if (action >= MOUSE_KEYS_BTN1) {
+        buttons &= ~(1 << (action - MOUSE_KEYS_BTN1));
+        send_report(0, 0, 0, 0);
+    }
+}
+
+void mouse_keys_task(void) {
+    if (!(held & MOTION_MASK)) {
+        return;
+    }
+
+    uint16_t now = timer_read();
+    uint16_t ticks = TIMER_DIFF_16(now, last_tick) / MOUSE_KEYS_INTERVAL;
+    if (ticks == 0) {
+        return;
+    }
+    if (ticks > MOUSE_KEYS_MAX_CATCHUP) {
+        // Stalled far too long (e.g. EEPROM write): drop the backlog instead of jumping
+        last_tick = now - MOUSE_KEYS_MAX_CATCHUP * MOUSE_KEYS_INTERVAL;
+        ticks = MOUSE_KEYS_MAX_CATCHUP;
+    }
+
+    int32_t x = 0, y = 0, h = 0, v = 0;
+    for (uint16_t i = 0; i < ticks; i++) {
+        last_tick += MOUSE_KEYS_INTERVAL;
+        step(&cursor, last_tick, &x, &y);
+        step(&wheel, last_tick, &h, &v);
+    }
+
+    if (x || y || h || v) {
+        send_report(x, y, h, v);
+    }
+}
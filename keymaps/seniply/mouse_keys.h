@@ -0,0 +1,74 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Fixed-point mouse keys
+// Cursor and wheel motion are integrated in Q8.8 (1/256 unit) so slow speeds
+// move smoothly instead of stepping, and the speed follows an acceleration
+// curve stored as a precomputed table (no floating point on the F072).
+//
+// Motion is advanced in fixed MOUSE_KEYS_INTERVAL ticks measured against the
+// timer, not per scan: a slow scan catches up on the ticks it missed, so
+// distance only depends on how long a key is held. Reports are sent from the
+// main loop only: with NKRO the mouse report shares its endpoint with the
+// keyboard and extrakey reports, and QMK's send path is not safe against a
+// thread preempting it.
+//
+// With POINTING_DEVICE_HIRES_SCROLL_ENABLE the wheel reports in
+// 1/POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER detents for smooth scrolling.
+
+#ifndef MOUSE_KEYS_INTERVAL
+#define MOUSE_KEYS_INTERVAL 4  // ms per motion tick / report (250 Hz)
+#endif
+
+#ifndef MOUSE_KEYS_MAX_CATCHUP
+#define MOUSE_KEYS_MAX_CATCHUP 8  // Ticks integrated at once after a slow scan
+#endif
+
+#ifndef MOUSE_KEYS_SPEED_MIN
+#define MOUSE_KEYS_SPEED_MIN 60  // Cursor px/s when a key is first pressed
+#endif
+
+#ifndef MOUSE_KEYS_SPEED_MAX
+#define MOUSE_KEYS_SPEED_MAX 1600  // Cursor px/s at full acceleration
+#endif
+
+#ifndef MOUSE_KEYS_TIME_TO_MAX
+#define MOUSE_KEYS_TIME_TO_MAX 1000  // ms from first press to full speed
+#endif
+
+#ifndef MOUSE_KEYS_WHEEL_SPEED_MIN
+#define MOUSE_KEYS_WHEEL_SPEED_MIN 4  // Wheel detents/s when first pressed
+#endif
+
+#ifndef MOUSE_KEYS_WHEEL_SPEED_MAX
+#define MOUSE_KEYS_WHEEL_SPEED_MAX 30  // Wheel detents/s at full acceleration
+#endif
+
+#ifndef MOUSE_KEYS_WHEEL_TIME_TO_MAX
+#define MOUSE_KEYS_WHEEL_TIME_TO_MAX 1500
+#endif
+
+// Motion and button actions (keymap keycodes map onto these)
+enum mouse_keys_actions {
+    MOUSE_KEYS_UP,
+    MOUSE_KEYS_DOWN,
+    MOUSE_KEYS_LEFT,
+    MOUSE_KEYS_RIGHT,
+    MOUSE_KEYS_WHEEL_UP,
+    MOUSE_KEYS_WHEEL_DOWN,
+    MOUSE_KEYS_WHEEL_LEFT,
+    MOUSE_KEYS_WHEEL_RIGHT,
+    MOUSE_KEYS_BTN1,
+    MOUSE_KEYS_BTN2,
+    MOUSE_KEYS_BTN3,
+    MOUSE_KEYS_ACTION_COUNT,
+    MOUSE_KEYS_NONE = MOUSE_KEYS_ACTION_COUNT,
+};
+
+void mouse_keys_press(uint8_t action);
+void mouse_keys_release(uint8_t action);
+bool mouse_keys_is_held(uint8_t action);
+
+// Advance motion and send reports (call every main loop iteration)
+void mouse_keys_task(void);
@@ -1,5 +1,19 @@
 #include "oneshot.h"
 
+// ============================================================================
+// TIMING TERMS (overridable per key)
+// ============================================================================
+// All terms are measured between event timestamps (record->event.time), not
+// against timer_read() when the event happens to be processed
+
+__attribute__((weak)) uint16_t get_oneshot_wait_term(uint16_t trigger) {
+    return FLOW_ONESHOT_WAIT_TERM;
+}
+
+__attribute__((weak)) uint16_t get_caps_word_double_tap_term(void) {
+    return CAPS_WORD_DOUBLE_TAP_TERM;
+}
+
 // ============================================================================
 // ORIGINAL CALLUM ONESHOT IMPLEMENTATION (No Timers)
 // ============================================================================
@@ -22,7 +36,7 @@ void update_oneshot_callum(
     if (keycode == trigger && mod == KC_LSFT) {
         if (record->event.pressed) {
             // KEYDOWN: Reset expired tap state
-            if (shift_tapped && timer_elapsed(last_shift_tap_time) >= CAPS_WORD_DOUBLE_TAP_TERM) {
+            if (shift_tapped && TIMER_DIFF_16(record->event.time, last_shift_tap_time) >= get_caps_word_double_tap_term()) {
                 shift_tapped = false;
             }
             // Normal keydown handling
@@ -34,7 +48,7 @@ void update_oneshot_callum(
             // KEYUP: Check for double-tap (only if this was a clean tap)
             if (*state == os_down_unused) {
                 // This was a tap (not hold+use)
-                if (shift_tapped && timer_elapsed(last_shift_tap_time) < CAPS_WORD_DOUBLE_TAP_TERM) {
+                if (shift_tapped && TIMER_DIFF_16(record->event.time, last_shift_tap_time) < get_caps_word_double_tap_term()) {
                     // Double-tap detected!
                     caps_word_toggle();
                     shift_tapped = false;
@@ -45,7 +59,7 @@ void update_oneshot_callum(
                 // Single tap - queue oneshot and mark for potential double-tap
                 *state = os_up_queued;
                 shift_tapped = true;
-                last_shift_tap_time = timer_read();
+                last_shift_tap_time = record->event.time;
             } else if (*state == os_down_used) {
                 // Was used while held - not a tap, reset double-tap state
                 shift_tapped = false;
@@ -134,13 +148,13 @@ void update_oneshot(
                 register_code(mod);
             }
             *state = os_down_unused;
-            timers->wait_timer = timer_read();  // Start wait timer for hold detection
+            timers->wait_timer = record->event.time;  // Start wait timer for hold detection
         } else {
             // Trigger keyup
-            uint16_t hold_time = timer_elapsed(timers->wait_timer);
+            uint16_t hold_time = TIMER_DIFF_16(record->event.time, timers->wait_timer);
 
             // Hold detection: if held >FLOW_ONESHOT_WAIT_TERM, treat as normal mod
-            if (hold_time > FLOW_ONESHOT_WAIT_TERM) {
+            if (hold_time > get_oneshot_wait_term(trigger)) {
                 *state = os_up_unqueued;
                 unregister_code(mod);
             } else {
@@ -148,7 +162,7 @@ void update_oneshot(
                 case os_down_unused:
                     // Quick tap - queue oneshot
                     *state = os_up_queued;
-                    timers->timeout_timer = timer_read();  // Start timeout timer
+                    timers->timeout_timer = record->event.time;  // Start timeout timer
                     timers->timeout_active = true;         // Enable auto-timeout
                     break;
                 case os_down_used:
@@ -225,13 +239,13 @@ void update_oneshot_layer(
                 layer_on(layer);
             }
             *state = os_down_unused;
-            timers->wait_timer = timer_read();  // Start wait timer
+            timers->wait_timer = record->event.time;  // Start wait timer
         } else {
             // Trigger keyup
-            uint16_t hold_time = timer_elapsed(timers->wait_timer);
+            uint16_t hold_time = TIMER_DIFF_16(record->event.time, timers->wait_timer);
 
             // Hold detection: if held >FLOW_ONESHOT_WAIT_TERM, treat as normal layer
-            if (hold_time > FLOW_ONESHOT_WAIT_TERM) {
+            if (hold_time > get_oneshot_wait_term(trigger)) {
                 *state = os_up_unqueued;
                 layer_off(layer);
             } else {
@@ -239,7 +253,7 @@ void update_oneshot_layer(
                 case os_down_unused:
                     // Quick tap - queue oneshot layer
                     *state = os_up_queued;
-                    timers->timeout_timer = timer_read();
+                    timers->timeout_timer = record->event.time;
                     timers->timeout_active = true;
                     break;
                 case os_down_used:
@@ -32,6 +32,13 @@ typedef struct {
 #define CAPS_WORD_DOUBLE_TAP_TERM 150  // ms between taps for caps word toggle (fast, less accidental)
 #endif
 
+// Per-trigger hold detection term (weak, defaults to FLOW_ONESHOT_WAIT_TERM)
+// Override to tune the tap/hold threshold per oneshot key
+uint16_t get_oneshot_wait_term(uint16_t trigger);
+
+// Shift double-tap window for caps word (weak, defaults to CAPS_WORD_DOUBLE_TAP_TERM)
+uint16_t get_caps_word_double_tap_term(void);
+
 // Original Callum oneshot implementation (no timers, no auto-timeout)
 // Pure sticky behavior: tap queues modifier until next key, no timeout
 // Perfect for shift with caps word integration
@@ -0,0 +1,16 @@
+#pragma once
+
+// Raw HID command IDs (first byte of every 32-byte report)
+// The keyboard answers each request in place: the reply echoes the command
+// byte, unknown commands are answered with RAW_CMD_UNKNOWN.
+// Host tools in tools/ use the same IDs.
+enum raw_hid_cmds {
+    RAW_CMD_BOOT     = 0x42,  // 'B' - boot phase times (fast_boot.c)
+    RAW_CMD_DISPLAY  = 0x44,  // 'D' - status display refresh cost (status_display.c)
+    RAW_CMD_KEYMAP   = 0x4B,  // 'K' - RAM keymap overlay upload (keymap_overlay.c)
+    RAW_CMD_MEMORY   = 0x4D,  // 'M' - stack high-water marks, RAM map (memory_map.c)
+    RAW_CMD_RGB_LOOP = 0x52,  // 'R' - main loop jitter, RGB frames when built (rgb_thread.c)
+    RAW_CMD_TAP_TUNE = 0x54,  // 'T' - per-key timing histograms (tap_tune.c)
+    RAW_CMD_USB_SOF  = 0x55,  // 'U' - report timing vs the USB frame (usb_sof.c)
+    RAW_CMD_UNKNOWN  = 0xFF,
+};
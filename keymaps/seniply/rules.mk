@@ -1,6 +1,6 @@
 SERIAL_DRIVER = usart           # Keep existing serial driver
 RGB_MATRIX_ENABLE = no          # No RGB support per user request
-MOUSEKEY_ENABLE = yes           # Mouse key support
+MOUSEKEY_ENABLE = yes           # Mouse endpoint (motion itself comes from mouse_keys.c)
 CAPS_WORD_ENABLE = yes          # Enable caps word (double-tap shift)
 LAYER_LOCK_ENABLE = yes         # Lock NAV/SYM layers with LLOCK
 CONSOLE_ENABLE = no             # Disable console for size optimization
@@ -8,9 +8,72 @@ VIA_ENABLE = no                 # Disabled - using keymap.c only (was causing LL
 VIAL_ENABLE = no                # Disabled - using keymap.c only (was causing keycode remapping issues)
 VIAL_INSECURE = no              # Not needed (Vial disabled)
 VIALRGB_ENABLE = no             # No RGB control via Vial (RGB disabled)
+RAW_ENABLE = yes                # Raw HID for host tools (tools/)
+KEY_TIMESTAMPS_ENABLE = yes     # Time key events at the pin edge (key_timestamps.c)
+FAST_BOOT_ENABLE = yes          # Boot phase timing, non-critical init after USB (fast_boot.c)
+KEY_INDICATORS_ENABLE = yes     # Oneshot / layer / caps word LEDs (key_indicators.c, only with RGB_MATRIX_ENABLE)
+MEMORY_MAP_ENABLE = yes         # Stack high-water marks and RAM map over raw HID (memory_map.c)
+KEYMAP_OVERLAY_ENABLE = yes     # Layouts hot-loaded over raw HID into RAM (keymap_overlay.c)
+TRIE_ENABLE = yes               # Autocorrect / abbreviations, TR_TOGG on FUN turns it off (trie.c)
 
 # Include custom oneshot implementation (Callum style)
 SRC += oneshot.c
 
 # Note: Using Callum-style one-shots (no timers, queue until used)
 # Advantages: No timeout, stackable modifiers, layer-aware behavior
+
+# Speculative tap for layer-tap keys during typing streaks
+SRC += speculative_tap.c
+
+# Self-tuning per-key tapping terms
+SRC += tap_tune.c
+
+# Fixed-point mouse keys (EXTEND mouse mode)
+SRC += mouse_keys.c
+
+# Pin-edge timestamps for key events (ChibiOS virtual timer + split RPC)
+ifeq ($(strip $(KEY_TIMESTAMPS_ENABLE)), yes)
+    SRC += key_timestamps.c
+    OPT_DEFS += -DKEY_TIMESTAMPS_ENABLE
+endif
+
+# Boot phase timing and deferred init (ChibiOS system time, tools/boot_timing.py)
+ifeq ($(strip $(FAST_BOOT_ENABLE)), yes)
+    SRC += fast_boot.c
+    OPT_DEFS += -DFAST_BOOT_ENABLE
+endif
+
+# Per-key state indicators on the RGB matrix (split RPC for the other half)
+ifeq ($(strip $(RGB_MATRIX_ENABLE))-$(strip $(KEY_INDICATORS_ENABLE)), yes-yes)
+    SRC += key_indicators.c
+    OPT_DEFS += -DKEY_INDICATORS_ENABLE
+endif
+
+# Stack painting and RAM map (ChibiOS stack fill and check, tools/ram_map.py)
+ifeq ($(strip $(MEMORY_MAP_ENABLE)), yes)
+    SRC += memory_map.c
+    OPT_DEFS += -DMEMORY_MAP_ENABLE
+endif
+
+# RAM keymap overlay (replaces keycode_at_keymap_location, tools/keymap_overlay.py)
+# Needs VIA_ENABLE = no: dynamic keymaps override the same lookup
+ifeq ($(strip $(KEYMAP_OVERLAY_ENABLE)), yes)
+    SRC += keymap_overlay.c
+    OPT_DEFS += -DKEYMAP_OVERLAY_ENABLE
+endif
+
+# Autocorrect / abbreviations from a flash trie (trie_data.h from tools/trie_gen.py)
+ifeq ($(strip $(TRIE_ENABLE)), yes)
+    SRC += trie.c
+    OPT_DEFS += -DTRIE_ENABLE
+endif
+
+# Status display (80x160 ST7735 LCD, status_display.c)
+# The LCD pin map in the keyboard config.h (A0-A2, A5-A7) overlaps the direct
+# matrix pins, so only enable this on a board with the LCD wired in
+QUANTUM_PAINTER_ENABLE = no
+ifeq ($(strip $(QUANTUM_PAINTER_ENABLE)), yes)
+    QUANTUM_PAINTER_DRIVERS += st7735_spi
+    SRC += status_display.c
+endif
+
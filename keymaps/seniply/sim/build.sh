@@ -0,0 +1,52 @@
+#!/bin/sh
+# Build the seniply simulator (Linux, gcc or clang)
+# Usage: sim/build.sh [output]   (default: sim/seniply-sim)
+# SIM_MAIN replaces the host side (uhid backend + sim_main.c), SIM_CFLAGS adds
+# compiler flags (tools/trie_bench.py builds its benchmark this way)
+set -e
+
+SIM_DIR=$(cd "$(dirname "$0")" && pwd)
+KEYMAP_DIR=$(dirname "$SIM_DIR")
+OUT=${1:-$SIM_DIR/seniply-sim}
+CC=${CC:-cc}
+CHECK=${SIM_MAIN:+no}
+SIM_MAIN=${SIM_MAIN:-"$SIM_DIR/uhid_backend.c $SIM_DIR/sim_main.c"}
+
+# build <output> <extra flags and sources...>
+build() {
+    out=$1
+    shift
+    $CC -std=gnu11 -O2 -g -Wall -Wno-unused-parameter \
+        -DQMK_KEYBOARD_H='"qmk_shim.h"' -DTRIE_ENABLE $SIM_CFLAGS \
+        -I"$SIM_DIR" -I"$KEYMAP_DIR" \
+        "$SIM_DIR/keymap_introspection.c" \
+        "$KEYMAP_DIR/oneshot.c" \
+        "$KEYMAP_DIR/speculative_tap.c" \
+        "$KEYMAP_DIR/tap_tune.c" \
+        "$KEYMAP_DIR/mouse_keys.c" \
+        "$KEYMAP_DIR/trie.c" \
+        "$SIM_DIR/qmk_shim.c" \
+        "$@" \
+        -o "$out"
+}
+
+build "$OUT" $SIM_MAIN
+
+# Checks (default build only). key_indicators.c is only in the firmware
+# with RGB_MATRIX_ENABLE (off in rules.mk): build it against the shim's RGB
+# stubs, with keymap_overlay.c for layout swaps. serial_dma.c is built
+# against the ChibiOS stand-ins in chibios/ and its matrix pipeline checked
+# byte for byte against QMK's serial protocol.
+if [ "$CHECK" != no ]; then
+    CHECK_OUT=$(mktemp)
+    trap 'rm -f "$CHECK_OUT"' EXIT
+    build "$CHECK_OUT" -DKEY_INDICATORS_ENABLE -DKEYMAP_OVERLAY_ENABLE \
+        "$KEYMAP_DIR/key_indicators.c" "$KEYMAP_DIR/keymap_overlay.c" "$SIM_DIR/indicators_check.c"
+    "$CHECK_OUT"
+    $CC -std=gnu11 -O2 -g -Wall -Wno-unused-parameter -DSPLIT_KEYBOARD -DSERIAL_DMA_ENABLE \
+        -I"$SIM_DIR/chibios" \
+        "$KEYMAP_DIR/../../serial_dma.c" \
+        "$SIM_DIR/serial_dma_check.c" \
+        -o "$CHECK_OUT"
+    "$CHECK_OUT"
+fi
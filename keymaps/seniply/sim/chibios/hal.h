@@ -0,0 +1,94 @@
+#pragma once
+
+// Host-side stand-in for the ChibiOS HAL as serial_dma.c uses it
+// Just enough to build serial_dma.c natively for serial_dma_check.c: the
+// DMA streams, USART1 and the system timer are plain variables and
+// functions implemented by the check, which plays the wire and the slave.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// System time in us ticks, moved only by the check (and by waits that time out)
+typedef uint32_t systime_t;
+typedef uint32_t sysinterval_t;
+
+#define TIME_INFINITE ((sysinterval_t)-1)
+#define TIME_MS2I(ms) ((sysinterval_t)(ms) * 1000)
+#define TIME_US2I(us) ((sysinterval_t)(us))
+
+systime_t chVTGetSystemTimeX(void);
+sysinterval_t chVTTimeElapsedSinceX(systime_t start);
+
+#define chSysLock()
+#define chSysUnlock()
+
+// DMA: a TX transfer reaches the slave when it is enabled, RX is the ring
+// the slave's bytes are written into
+typedef struct {
+    void *memory;
+    size_t size;
+} stm32_dma_stream_t;
+
+extern stm32_dma_stream_t dma_streams[2];
+
+#define STM32_DMA_STREAM(n) (&dma_streams[0])
+#define STM32_DMA1_STREAM4 (&dma_streams[0])
+#define STM32_DMA1_STREAM5 (&dma_streams[1])
+#define STM32_DMA_CR_DIR_M2P 0
+#define STM32_DMA_CR_DIR_P2M 0
+#define STM32_DMA_CR_PSIZE_BYTE 0
+#define STM32_DMA_CR_MSIZE_BYTE 0
+#define STM32_DMA_CR_MINC 0
+#define STM32_DMA_CR_CIRC 0
+#define STM32_DMA_CR_PL(n) 0
+
+#define dmaStreamAlloc(id, priority, func, param)
+#define dmaStreamSetPeripheral(stream, address)
+#define dmaStreamSetMode(stream, mode)
+#define dmaStreamDisable(stream)
+#define dmaStreamSetMemory0(stream, address) ((stream)->memory = (void *)(address))
+#define dmaStreamSetTransactionSize(stream, count) ((stream)->size = (count))
+
+size_t dmaStreamGetTransactionSize(stm32_dma_stream_t *stream);
+void dmaStreamEnable(stm32_dma_stream_t *stream);
+
+// USART1 and its pins
+typedef struct {
+    uint32_t CR1, CR2, CR3, BRR, ISR, RDR, TDR;
+} USART_TypeDef;
+
+typedef struct {
+    uint32_t CFGR1;
+} SYSCFG_TypeDef;
+
+extern USART_TypeDef usart1;
+extern SYSCFG_TypeDef syscfg;
+
+#define USART1 (&usart1)
+#define SYSCFG (&syscfg)
+#define STM32_USART1CLK 48000000
+#define USART_CR1_UE 0x01
+#define USART_CR1_RE 0x04
+#define USART_CR1_TE 0x08
+#define USART_CR3_DMAR 0x40
+#define USART_CR3_DMAT 0x80
+#define USART_CR3_OVRDIS 0x1000
+#define USART_ISR_RXNE 0x20
+#define USART_ISR_BUSY 0x10000
+#define SYSCFG_CFGR1_USART1TX_DMA_RMP 0x200
+#define SYSCFG_CFGR1_USART1RX_DMA_RMP 0x400
+
+#define rccEnableUSART1(low_power)
+#define PAL_MODE_ALTERNATE(n) 0
+#define PAL_STM32_OTYPE_PUSHPULL 0
+#define PAL_STM32_OSPEED_HIGHEST 0
+#define PAL_STM32_PUPDR_PULLUP 0
+#define PAL_EVENT_MODE_FALLING_EDGE 0
+#define palSetLineMode(line, mode)
+#define palEnableLineEventI(line, mode)
+#define palDisableLineEventI(line)
+
+// No byte arrives while the master waits (the slave answers as soon as a
+// request is sent), so a wait for a start bit runs into its timeout
+void palWaitLineTimeoutS(uint32_t line, sysinterval_t timeout);
@@ -0,0 +1,21 @@
+#pragma once
+
+// Host-side stand-in for quantum.h as serial_dma.c uses it (serial_dma_check.c)
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+// Keyboard config.h, the parts serial_dma.c reads
+#define SERIAL_USART_FULL_DUPLEX
+#define SERIAL_USART_SPEED 460800
+#define SERIAL_USART_TX_PIN 9
+#define SERIAL_USART_RX_PIN 10
+#define SERIAL_USART_TX_PAL_MODE 1
+#define SERIAL_USART_RX_PAL_MODE 1
+
+typedef uint8_t matrix_row_t;
+
+bool is_transport_connected(void);
@@ -0,0 +1,4 @@
+#pragma once
+
+// Host-side stand-in for QMK's serial.h (serial_dma_check.c): serial_dma.c
+// only needs the driver it implements, declared by its own definitions
@@ -0,0 +1,26 @@
+#pragma once
+
+// Host-side stand-in for QMK's transactions.h (serial_dma_check.c)
+// The transaction table with the two matrix reads serial_dma.c prefetches
+// and one write, sized as in QMK for a 4-row half.
+
+#include <stdint.h>
+
+enum serial_transaction_id {
+    GET_SLAVE_MATRIX_CHECKSUM,
+    GET_SLAVE_MATRIX_DATA,
+    PUT_RPC_INFO,
+    NUM_TRANSACTIONS,
+};
+
+typedef struct {
+    uint8_t initiator2target_buffer_size;
+    uint8_t target2initiator_buffer_size;
+    uint8_t *initiator2target_buffer;
+    uint8_t *target2initiator_buffer;
+} split_transaction_desc_t;
+
+extern split_transaction_desc_t split_transaction_table[NUM_TRANSACTIONS];
+
+#define split_trans_initiator2target_buffer(trans) ((trans)->initiator2target_buffer)
+#define split_trans_target2initiator_buffer(trans) ((trans)->target2initiator_buffer)
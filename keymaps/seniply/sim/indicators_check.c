@@ -0,0 +1,117 @@
+// Behaviour check for key_indicators.c (built and run by sim/build.sh)
+// The firmware only builds key_indicators.c with RGB_MATRIX_ENABLE, which
+// rules.mk leaves off, so this is where it gets compiled and exercised:
+// keymap.c drives the state word, frames are read back from the shim's RGB
+// stubs. Covers a oneshot lighting its key, clearing on the next key, and
+// the overlay following the key when keymap_overlay.c swaps the layout.
+
+#include "qmk_shim.h"
+#include "keymap_overlay.h"
+#include "raw_hid.h"
+#include "raw_hid_cmds.h"
+#include "sim.h"
+
+#include <stdio.h>
+
+#define OS_SHFT_ROW 3  // Left thumb, outer (basics.txt)
+#define OS_SHFT_COL 0
+#define MOVED_ROW 2    // Where the swapped layout puts it
+#define MOVED_COL 0
+
+static const uint8_t queued[3] = {128, 255, 120};  // key_indicators_color(): oneshot queued
+
+static uint16_t bank[KEYMAP_OVERLAY_LAYERS][MATRIX_ROWS][MATRIX_COLS];
+static uint8_t colors[SIM_RGB_LED_COUNT][3];
+static uint32_t failures = 0;
+
+static void on_keyboard(const uint8_t report[SIM_KEYBOARD_REPORT_SIZE]) {}
+static void on_consumer(uint16_t usage) {}
+static void on_mouse(uint8_t buttons, int8_t x, int8_t y, int16_t v, int16_t h) {}
+static void on_raw_hid(const uint8_t *data, uint8_t length) {}
+
+static const sim_host_t host = {on_keyboard, on_consumer, on_mouse, on_raw_hid};
+
+static void tap(uint8_t row, uint8_t col) {
+    sim_key_event(row, col, true);
+    sim_advance(30);
+    sim_key_event(row, col, false);
+    sim_advance(30);
+}
+
+// Only the LED under row/col shows the oneshot as queued, or none when lit is false
+static void expect(const char *step, uint8_t row, uint8_t col, bool lit) {
+    uint8_t led = g_led_config.matrix_co[row][col];
+    sim_rgb_frame(colors);
+    for (uint8_t i = 0; i < SIM_RGB_LED_COUNT; i++) {
+        bool want = lit && i == led;
+        bool is_queued = memcmp(colors[i], queued, sizeof(queued)) == 0;
+        bool is_black = !colors[i][0] && !colors[i][1] && !colors[i][2];
+        if (want ? !is_queued : !is_black) {
+            printf("%s: LED %u is %u/%u/%u\n", step, i, colors[i][0], colors[i][1], colors[i][2]);
+            failures++;
+        }
+    }
+}
+
+// CRC-16/CCITT-FALSE, as keymap_overlay.c checks the bank
+static uint16_t crc16(const uint8_t *data, uint16_t length) {
+    uint16_t crc = 0xFFFF;
+    for (uint16_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+// Upload and apply a layout the way tools/keymap_overlay.py does
+static void apply_overlay(void) {
+    uint8_t data[32];
+    const uint8_t *bytes = (const uint8_t *)bank;
+    for (uint16_t offset = 0; offset < sizeof(bank); offset += KEYMAP_OVERLAY_CHUNK) {
+        uint8_t count = sizeof(bank) - offset < KEYMAP_OVERLAY_CHUNK ? sizeof(bank) - offset : KEYMAP_OVERLAY_CHUNK;
+        memset(data, 0, sizeof(data));
+        data[0] = RAW_CMD_KEYMAP;
+        data[1] = KEYMAP_OVERLAY_WRITE;
+        data[3] = offset & 0xFF;
+        data[4] = offset >> 8;
+        data[5] = count;
+        memcpy(&data[6], bytes + offset, count);
+        raw_hid_receive(data, sizeof(data));
+    }
+    uint16_t crc = crc16(bytes, sizeof(bank));
+    memset(data, 0, sizeof(data));
+    data[0] = RAW_CMD_KEYMAP;
+    data[1] = KEYMAP_OVERLAY_APPLY;
+    data[3] = crc & 0xFF;
+    data[4] = crc >> 8;
+    raw_hid_receive(data, sizeof(data));
+    if (data[2] != KEYMAP_OVERLAY_OK) {
+        printf("overlay apply: status %u\n", data[2]);
+        failures++;
+    }
+}
+
+int main(void) {
+    sim_init(&host, true);
+    sim_advance(10);
+
+    expect("idle", OS_SHFT_ROW, OS_SHFT_COL, false);
+    tap(OS_SHFT_ROW, OS_SHFT_COL);
+    expect("OS_SHFT queued", OS_SHFT_ROW, OS_SHFT_COL, true);
+
+    // Same state word, new layout: OS_SHFT trades places with the key above
+    memcpy(bank, keymaps, sizeof(bank));
+    bank[0][OS_SHFT_ROW][OS_SHFT_COL] = keymaps[0][MOVED_ROW][MOVED_COL];
+    bank[0][MOVED_ROW][MOVED_COL] = keymaps[0][OS_SHFT_ROW][OS_SHFT_COL];
+    apply_overlay();
+    sim_advance(1);  // keymap_overlay_task() swaps, all keys are up
+    expect("layout swapped", MOVED_ROW, MOVED_COL, true);
+
+    tap(1, 3);  // Any letter uses up the oneshot
+    expect("oneshot used", MOVED_ROW, MOVED_COL, false);
+
+    printf("indicators: %s\n", failures ? "FAIL" : "ok");
+    return failures ? 1 : 0;
+}
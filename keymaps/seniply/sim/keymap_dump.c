@@ -0,0 +1,33 @@
+// Keymap blob for the RAM overlay (built by tools/keymap_overlay.py)
+// Writes keymaps[] as keymap_overlay.c takes it: keycodes little-endian,
+// [layer][row][col], so the firmware's CRC covers the same bytes.
+//
+// Usage: keymap_dump <output file>
+
+#include "qmk_shim.h"
+
+#include <stdio.h>
+
+uint8_t keymap_layer_count(void);  // keymap_introspection.c
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <output file>\n", argv[0]);
+        return 2;
+    }
+    FILE *f = fopen(argv[1], "wb");
+    if (!f) {
+        perror(argv[1]);
+        return 1;
+    }
+    for (uint8_t layer = 0; layer < keymap_layer_count(); layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                uint16_t keycode = keymaps[layer][row][col];
+                fputc(keycode & 0xFF, f);
+                fputc(keycode >> 8, f);
+            }
+        }
+    }
+    return fclose(f) ? 1 : 0;
+}
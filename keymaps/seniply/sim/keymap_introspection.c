@@ -0,0 +1,12 @@
+// Same trick as QMK's keymap_introspection.c: compile the keymap in this
+// translation unit so the layer count can be taken from keymaps[]
+// (KEYMAP_C builds another keymap file, tools/keymap_overlay.py)
+#ifdef KEYMAP_C
+#include KEYMAP_C
+#else
+#include "../keymap.c"
+#endif
+
+uint8_t keymap_layer_count(void) {
+    return sizeof(keymaps) / sizeof(keymaps[0]);
+}
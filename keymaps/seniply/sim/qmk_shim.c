@@ -0,0 +1,757 @@
+#include "qmk_shim.h"
+#include "raw_hid.h"
+#include "sim.h"
+
+#include <stdio.h>
+#include <time.h>
+
+// Host-side engine for qmk_shim.h
+// Follows the parts of QMK's action/keyboard pipeline the seniply keymap
+// depends on: pre_process_record_user -> tapping (LT with per-key terms and
+// HOLD_ON_OTHER_KEY_PRESS) -> caps word -> process_record_user -> layer lock
+// -> default key actions -> post_process_record_user.
+
+uint8_t keymap_layer_count(void);  // keymap_introspection.c
+
+static const sim_host_t *host;
+static bool virtual_time;
+
+// ============================================================================
+// TIMER
+// ============================================================================
+
+static uint32_t clock_ms;           // Virtual clock
+static struct timespec clock_start; // Real clock origin
+
+uint32_t sim_now(void) {
+    if (virtual_time) {
+        return clock_ms;
+    }
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((ts.tv_sec - clock_start.tv_sec) * 1000 + (ts.tv_nsec - clock_start.tv_nsec) / 1000000);
+}
+
+uint16_t timer_read(void) {
+    return (uint16_t)sim_now();
+}
+
+uint32_t timer_read32(void) {
+    return sim_now();
+}
+
+uint16_t timer_elapsed(uint16_t last) {
+    return TIMER_DIFF_16(timer_read(), last);
+}
+
+uint32_t timer_elapsed32(uint32_t last) {
+    return TIMER_DIFF_32(timer_read32(), last);
+}
+
+// Blocking like on the MCU: nothing else runs during the wait
+void wait_ms(uint16_t ms) {
+    if (virtual_time) {
+        clock_ms += ms;
+        return;
+    }
+    struct timespec ts = {.tv_sec = ms / 1000, .tv_nsec = (long)(ms % 1000) * 1000000};
+    nanosleep(&ts, NULL);
+}
+
+// ============================================================================
+// HID REPORTS
+// ============================================================================
+
+static uint8_t real_mods = 0;
+static uint8_t weak_mods = 0;
+static uint8_t report_keys[6];
+static uint8_t last_report[SIM_KEYBOARD_REPORT_SIZE];
+static uint16_t consumer_usage = 0;
+static uint8_t host_leds = 0;
+
+static uint16_t keycode_to_consumer(uint8_t code) {
+    switch (code) {
+    case KC_AUDIO_MUTE:       return 0x00E2;
+    case KC_AUDIO_VOL_UP:     return 0x00E9;
+    case KC_AUDIO_VOL_DOWN:   return 0x00EA;
+    case KC_MEDIA_NEXT_TRACK: return 0x00B5;
+    case KC_MEDIA_PREV_TRACK: return 0x00B6;
+    case KC_MEDIA_STOP:       return 0x00B7;
+    case KC_MEDIA_PLAY_PAUSE: return 0x00CD;
+    default:                  return 0;
+    }
+}
+
+static void send_consumer(uint16_t usage) {
+    if (usage != consumer_usage) {
+        consumer_usage = usage;
+        if (host && host->consumer) {
+            host->consumer(usage);
+        }
+    }
+}
+
+void send_keyboard_report(void) {
+    uint8_t report[SIM_KEYBOARD_REPORT_SIZE] = {real_mods | weak_mods, 0};
+#ifdef CAPS_WORD_INVERT_ON_SHIFT
+    // Holding shift during caps word cancels the caps word shift
+    if (is_caps_word_on() && (real_mods & MOD_MASK_SHIFT) && (weak_mods & MOD_MASK_SHIFT)) {
+        report[0] &= ~MOD_MASK_SHIFT;
+    }
+#endif
+    memcpy(&report[2], report_keys, sizeof(report_keys));
+
+    if (memcmp(report, last_report, sizeof(report)) != 0) {
+        memcpy(last_report, report, sizeof(report));
+        if (host && host->keyboard) {
+            host->keyboard(report);
+        }
+    }
+}
+
+void register_code(uint8_t code) {
+    if (code == KC_NO) {
+        return;
+    }
+    if (IS_MODIFIER_KEYCODE(code)) {
+        real_mods |= MOD_BIT(code);
+    } else if (keycode_to_consumer(code)) {
+        send_consumer(keycode_to_consumer(code));
+        return;
+    } else {
+        for (uint8_t i = 0; i < sizeof(report_keys); i++) {
+            if (report_keys[i] == code) {
+                break;
+            }
+            if (report_keys[i] == KC_NO) {
+                report_keys[i] = code;
+                break;
+            }
+        }
+    }
+    send_keyboard_report();
+}
+
+void unregister_code(uint8_t code) {
+    if (code == KC_NO) {
+        return;
+    }
+    if (IS_MODIFIER_KEYCODE(code)) {
+        real_mods &= ~MOD_BIT(code);
+    } else if (keycode_to_consumer(code)) {
+        send_consumer(0);
+        return;
+    } else {
+        for (uint8_t i = 0; i < sizeof(report_keys); i++) {
+            if (report_keys[i] == code) {
+                memmove(&report_keys[i], &report_keys[i + 1], sizeof(report_keys) - i - 1);
+                report_keys[sizeof(report_keys) - 1] = KC_NO;
+                break;
+            }
+        }
+    }
+    send_keyboard_report();
+}
+
+void tap_code(uint8_t code) {
+    register_code(code);
+#ifdef TAP_CODE_DELAY
+    wait_ms(TAP_CODE_DELAY);
+#endif
+    unregister_code(code);
+}
+
+// 5-bit QMK mods (bit 4 = right hand) to an 8-bit HID modifier byte
+static uint8_t mod_config_to_bits(uint8_t mods) {
+    return (mods & 0x10) ? (uint8_t)((mods & 0x0F) << 4) : (mods & 0x0F);
+}
+
+void register_code16(uint16_t code) {
+    uint8_t basic = code & 0xFF;
+    uint8_t mods = IS_QK_MODS(code) ? mod_config_to_bits(QK_MODS_GET_MODS(code)) : 0;
+
+    // Mods with a real key are weak (released with the key), mod-only codes
+    // such as KC_MEH / KC_HYPR hold real mods
+    if (basic == KC_NO || IS_MODIFIER_KEYCODE(basic)) {
+        real_mods |= mods;
+    } else {
+        weak_mods |= mods;
+    }
+    if (basic == KC_NO) {
+        send_keyboard_report();
+    } else {
+        register_code(basic);
+    }
+}
+
+void unregister_code16(uint16_t code) {
+    uint8_t basic = code & 0xFF;
+    uint8_t mods = IS_QK_MODS(code) ? mod_config_to_bits(QK_MODS_GET_MODS(code)) : 0;
+
+    if (basic == KC_NO || IS_MODIFIER_KEYCODE(basic)) {
+        real_mods &= ~mods;
+    } else {
+        weak_mods &= ~mods;
+    }
+    if (basic == KC_NO) {
+        send_keyboard_report();
+    } else {
+        unregister_code(basic);
+    }
+}
+
+void tap_code16(uint16_t code) {
+    register_code16(code);
+#ifdef TAP_CODE_DELAY
+    wait_ms(TAP_CODE_DELAY);
+#endif
+    unregister_code16(code);
+}
+
+uint8_t get_mods(void) {
+    return real_mods;
+}
+
+void add_weak_mods(uint8_t mods) {
+    weak_mods |= mods;
+}
+
+void del_weak_mods(uint8_t mods) {
+    weak_mods &= ~mods;
+}
+
+void clear_weak_mods(void) {
+    weak_mods = 0;
+}
+
+void sim_set_host_leds(uint8_t leds) {
+    host_leds = leds;
+}
+
+uint8_t host_keyboard_leds(void) {
+    return host_leds;
+}
+
+void host_mouse_send(report_mouse_t *report) {
+    if (host && host->mouse) {
+        host->mouse(report->buttons, report->x, report->y, report->v, report->h);
+    }
+}
+
+void raw_hid_send(uint8_t *data, uint8_t length) {
+    if (host && host->raw_hid) {
+        host->raw_hid(data, length);
+    }
+}
+
+// ============================================================================
+// LAYERS
+// ============================================================================
+
+layer_state_t layer_state = 0;
+static layer_state_t locked_layers = 0;
+static uint8_t source_layers[MATRIX_ROWS][MATRIX_COLS];
+
+static void layer_state_set(layer_state_t state) {
+    layer_state = layer_state_set_user(state);
+}
+
+void layer_on(uint8_t layer) {
+    layer_state_set(layer_state | ((layer_state_t)1 << layer));
+}
+
+void layer_off(uint8_t layer) {
+    layer_state_set(layer_state & ~((layer_state_t)1 << layer));
+}
+
+uint8_t get_highest_layer(layer_state_t state) {
+    for (int8_t layer = 31; layer > 0; layer--) {
+        if (state & ((layer_state_t)1 << layer)) {
+            return layer;
+        }
+    }
+    return 0;
+}
+
+bool layer_state_cmp(layer_state_t state, uint8_t layer) {
+    return layer == 0 ? state == 0 || (state & 1) : (state & ((layer_state_t)1 << layer)) != 0;
+}
+
+bool layer_state_is(uint8_t layer) {
+    return layer == 0 ? layer_state == 0 || (layer_state & 1) : (layer_state & ((layer_state_t)1 << layer)) != 0;
+}
+
+layer_state_t update_tri_layer_state(layer_state_t state, uint8_t layer1, uint8_t layer2, uint8_t layer3) {
+    layer_state_t mask12 = ((layer_state_t)1 << layer1) | ((layer_state_t)1 << layer2);
+    layer_state_t mask3 = (layer_state_t)1 << layer3;
+    return (state & mask12) == mask12 ? (state | mask3) : (state & ~mask3);
+}
+
+// QMK's weak version reads keymaps[]; keymap_overlay.c replaces it
+__attribute__((weak)) uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
+    if (layer_num >= keymap_layer_count() || row >= MATRIX_ROWS || column >= MATRIX_COLS) {
+        return KC_NO;
+    }
+    return keymaps[layer_num][row][column];
+}
+
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key) {
+    return keycode_at_keymap_location(layer, key.row, key.col);
+}
+
+// Highest active layer with a non-transparent keycode (default layer is 0)
+static uint8_t layer_switch_get_layer(keypos_t key) {
+    for (int8_t layer = keymap_layer_count() - 1; layer > 0; layer--) {
+        if ((layer_state & ((layer_state_t)1 << layer)) && keymap_key_to_keycode(layer, key) != KC_TRANSPARENT) {
+            return layer;
+        }
+    }
+    return 0;
+}
+
+uint8_t read_source_layers_cache(keypos_t key) {
+    return source_layers[key.row][key.col];
+}
+
+// Keycode of an event: presses resolve through the layer stack, releases
+// use the layer the press came from
+static uint16_t get_event_keycode(keyevent_t event, bool update_cache) {
+    uint8_t layer;
+    if (event.pressed) {
+        layer = layer_switch_get_layer(event.key);
+        if (update_cache) {
+            source_layers[event.key.row][event.key.col] = layer;
+        }
+    } else {
+        layer = read_source_layers_cache(event.key);
+    }
+    return keymap_key_to_keycode(layer, event.key);
+}
+
+// ============================================================================
+// LAYER LOCK
+// ============================================================================
+
+static uint32_t layer_lock_timer = 0;
+
+bool is_layer_locked(uint8_t layer) {
+    return (locked_layers & ((layer_state_t)1 << layer)) != 0;
+}
+
+static void layer_lock_invert(uint8_t layer) {
+    layer_state_t mask = (layer_state_t)1 << layer;
+    locked_layers ^= mask;
+    if (locked_layers & mask) {
+        layer_on(layer);
+    } else {
+        layer_off(layer);
+    }
+    layer_lock_set_user(locked_layers);
+}
+
+static bool process_layer_lock(uint16_t keycode, keyrecord_t *record) {
+    layer_lock_timer = timer_read32();
+    if (keycode == QK_LAYER_LOCK) {
+        if (record->event.pressed) {
+            layer_lock_invert(get_highest_layer(layer_state));
+        }
+        return false;
+    }
+    return true;
+}
+
+static void layer_lock_task(void) {
+#if defined(LAYER_LOCK_IDLE_TIMEOUT) && LAYER_LOCK_IDLE_TIMEOUT > 0
+    if (locked_layers && timer_elapsed32(layer_lock_timer) > LAYER_LOCK_IDLE_TIMEOUT) {
+        layer_state_set(layer_state & ~locked_layers);
+        locked_layers = 0;
+        layer_lock_set_user(locked_layers);
+    }
+#endif
+}
+
+// ============================================================================
+// CAPS WORD
+// ============================================================================
+
+static bool caps_word_active = false;
+static uint32_t caps_word_timer = 0;
+
+void caps_word_on(void) {
+    if (caps_word_active) {
+        return;
+    }
+    clear_weak_mods();
+    caps_word_active = true;
+    caps_word_timer = timer_read32();
+    caps_word_set_user(true);
+}
+
+void caps_word_off(void) {
+    if (!caps_word_active) {
+        return;
+    }
+    clear_weak_mods();
+    caps_word_active = false;
+    send_keyboard_report();
+    caps_word_set_user(false);
+}
+
+void caps_word_toggle(void) {
+    if (caps_word_active) {
+        caps_word_off();
+    } else {
+        caps_word_on();
+    }
+}
+
+bool is_caps_word_on(void) {
+    return caps_word_active;
+}
+
+static void process_caps_word(uint16_t keycode, keyrecord_t *record) {
+    if (!caps_word_active || !record->event.pressed) {
+        return;
+    }
+    caps_word_timer = timer_read32();
+
+    // Any mod other than shift / AltGr ends caps word
+    if (real_mods & ~(MOD_MASK_SHIFT | MOD_BIT(KC_RALT))) {
+        caps_word_off();
+        return;
+    }
+
+    if (IS_MODIFIER_KEYCODE(keycode)) {
+        if (!(MOD_BIT(keycode) & MOD_MASK_SHIFT)) {
+            caps_word_off();
+        }
+        return;
+    }
+    if (IS_QK_MODS(keycode) && (QK_MODS_GET_MODS(keycode) & ~0x12)) {
+        caps_word_off();
+        return;
+    }
+    if (IS_QK_LAYER_TAP(keycode)) {
+        if (record->tap.count == 0) {
+            return;  // Layer hold
+        }
+        keycode = QK_LAYER_TAP_GET_TAP_KEYCODE(keycode);
+    } else if (IS_QK_MOMENTARY(keycode) || keycode == QK_LAYER_LOCK) {
+        return;
+    }
+
+    clear_weak_mods();
+    if (!caps_word_press_user(keycode)) {
+        caps_word_off();
+    }
+}
+
+static void caps_word_task(void) {
+#if defined(CAPS_WORD_IDLE_TIMEOUT) && CAPS_WORD_IDLE_TIMEOUT > 0
+    if (caps_word_active && timer_elapsed32(caps_word_timer) > CAPS_WORD_IDLE_TIMEOUT) {
+        caps_word_off();
+    }
+#endif
+}
+
+// ============================================================================
+// RECORD PROCESSING
+// ============================================================================
+
+static void process_action(uint16_t keycode, keyrecord_t *record) {
+    bool pressed = record->event.pressed;
+
+    if (keycode <= 0xFF) {
+        pressed ? register_code(keycode) : unregister_code(keycode);
+    } else if (IS_QK_MODS(keycode)) {
+        pressed ? register_code16(keycode) : unregister_code16(keycode);
+    } else if (IS_QK_LAYER_TAP(keycode)) {
+        uint8_t layer = QK_LAYER_TAP_GET_LAYER(keycode);
+        if (record->tap.count > 0) {
+            uint8_t tap = QK_LAYER_TAP_GET_TAP_KEYCODE(keycode);
+            pressed ? register_code(tap) : unregister_code(tap);
+        } else if (pressed) {
+            layer_on(layer);
+        } else if (!is_layer_locked(layer)) {
+            layer_off(layer);
+        }
+    } else if (IS_QK_MOMENTARY(keycode)) {
+        uint8_t layer = keycode & 0x1F;
+        if (pressed) {
+            layer_on(layer);
+        } else if (!is_layer_locked(layer)) {
+            layer_off(layer);
+        }
+    }
+}
+
+void process_record(keyrecord_t *record) {
+    uint16_t keycode = get_event_keycode(record->event, true);
+    record->keycode = keycode;
+
+    process_caps_word(keycode, record);
+    if (process_record_user(keycode, record) && process_layer_lock(keycode, record)) {
+        process_action(keycode, record);
+    }
+    post_process_record_user(keycode, record);
+}
+
+// ============================================================================
+// TAPPING (layer-tap keys)
+// ============================================================================
+// A layer-tap press is held back until it resolves: release within the term
+// = tap, term expiry or another key press (HOLD_ON_OTHER_KEY_PRESS) = hold.
+// Events arriving while it is unresolved are queued and replayed in order.
+
+#define TAPPING_QUEUE_SIZE 8
+
+static keyrecord_t tapping_key;
+static bool tapping_pending = false;
+static keyrecord_t tapping_queue[TAPPING_QUEUE_SIZE];
+static uint8_t tapping_queue_len = 0;
+
+static void process_tapping(keyrecord_t *record);
+
+static void resolve_tapping_key(bool tap) {
+    tapping_pending = false;
+    tapping_key.tap.count = tap ? 1 : 0;
+    process_record(&tapping_key);
+
+    // Replay queued events (they may start a new tapping key)
+    keyrecord_t queue[TAPPING_QUEUE_SIZE];
+    uint8_t len = tapping_queue_len;
+    memcpy(queue, tapping_queue, sizeof(queue));
+    tapping_queue_len = 0;
+    for (uint8_t i = 0; i < len; i++) {
+        process_tapping(&queue[i]);
+    }
+}
+
+static void process_tapping(keyrecord_t *record) {
+    if (tapping_pending) {
+        if (!record->event.pressed && KEYEQ(record->event.key, tapping_key.event.key)) {
+            resolve_tapping_key(true);
+            record->tap.count = 1;
+            process_record(record);
+            return;
+        }
+#ifdef HOLD_ON_OTHER_KEY_PRESS
+        if (record->event.pressed) {
+            resolve_tapping_key(false);
+            process_tapping(record);
+            return;
+        }
+#endif
+        if (!record->event.pressed && tapping_queue_len == 0) {
+            // Release of a key pressed before the tapping key
+            process_record(record);
+            return;
+        }
+
+        if (tapping_queue_len < TAPPING_QUEUE_SIZE) {
+            tapping_queue[tapping_queue_len++] = *record;
+        } else {
+            resolve_tapping_key(false);
+            process_tapping(record);
+        }
+        return;
+    }
+
+    if (record->event.pressed && IS_QK_LAYER_TAP(get_event_keycode(record->event, false))) {
+        tapping_key = *record;
+        tapping_key.keycode = get_event_keycode(record->event, false);
+        tapping_pending = true;
+        return;
+    }
+    process_record(record);
+}
+
+static void tapping_task(void) {
+    if (tapping_pending && timer_elapsed(tapping_key.event.time) >= get_tapping_term(tapping_key.keycode, &tapping_key)) {
+        resolve_tapping_key(false);
+    }
+}
+
+// ============================================================================
+// MATRIX AND RGB MATRIX
+// ============================================================================
+// One unsplit keyboard that is always the master. The RGB matrix only has
+// what key_indicators.c uses: the keyboard's key -> LED table and a frame
+// buffer. rgb_matrix_hsv_to_rgb() passes h, s, v through unchanged, so a
+// frame read back by sim_rgb_frame() holds the HSV each LED was given.
+
+static matrix_row_t matrix[MATRIX_ROWS];
+
+matrix_row_t matrix_get_row(uint8_t row) {
+    return row < MATRIX_ROWS ? matrix[row] : 0;
+}
+
+bool is_keyboard_master(void) {
+    return true;
+}
+
+// Key matrix to LED index (keymaps/keymaps_base.c)
+led_config_t g_led_config = {{
+    {19, 18, 13, 12, 5, 4},
+    {20, 17, 14, 11, 6, 3},
+    {21, 16, 15, 10, 7, 2},
+    {9, 8, 1},
+    {44, 43, 38, 37, 30, 29},
+    {45, 42, 39, 36, 31, 28},
+    {46, 41, 40, 35, 32, 27},
+    {34, 33, 26},
+}};
+
+static rgb_t frame[RGB_MATRIX_LED_COUNT];
+
+rgb_t rgb_matrix_hsv_to_rgb(hsv_t hsv) {
+    return (rgb_t){hsv.h, hsv.s, hsv.v};
+}
+
+void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
+        frame[index] = (rgb_t){red, green, blue};
+    }
+}
+
+void sim_rgb_frame(uint8_t colors[SIM_RGB_LED_COUNT][3]) {
+    memset(frame, 0, sizeof(frame));
+    rgb_matrix_indicators_advanced_user(0, RGB_MATRIX_LED_COUNT);
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        colors[i][0] = frame[i].r;
+        colors[i][1] = frame[i].g;
+        colors[i][2] = frame[i].b;
+    }
+}
+
+// ============================================================================
+// EECONFIG USER DATABLOCK
+// ============================================================================
+
+#ifndef EECONFIG_USER_DATA_SIZE
+#define EECONFIG_USER_DATA_SIZE 0
+#endif
+
+static uint8_t user_datablock[EECONFIG_USER_DATA_SIZE + 1];
+static const char *eeconfig_path = NULL;
+
+void sim_eeconfig_file(const char *path) {
+    eeconfig_path = path;
+    FILE *f = fopen(path, "rb");
+    if (f) {
+        size_t n = fread(user_datablock, 1, EECONFIG_USER_DATA_SIZE, f);
+        (void)n;
+        fclose(f);
+    }
+}
+
+void eeconfig_read_user_datablock(void *data, uint32_t offset, uint32_t length) {
+    if (offset + length <= EECONFIG_USER_DATA_SIZE) {
+        memcpy(data, &user_datablock[offset], length);
+    } else {
+        memset(data, 0, length);
+    }
+}
+
+void eeconfig_update_user_datablock(const void *data, uint32_t offset, uint32_t length) {
+    if (offset + length > EECONFIG_USER_DATA_SIZE) {
+        return;
+    }
+    memcpy(&user_datablock[offset], data, length);
+    if (eeconfig_path) {
+        FILE *f = fopen(eeconfig_path, "wb");
+        if (f) {
+            fwrite(user_datablock, 1, EECONFIG_USER_DATA_SIZE, f);
+            fclose(f);
+        }
+    }
+}
+
+// ============================================================================
+// WEAK USER HOOKS
+// ============================================================================
+
+__attribute__((weak)) bool pre_process_record_user(uint16_t keycode, keyrecord_t *record) {
+    return true;
+}
+
+__attribute__((weak)) bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    return true;
+}
+
+__attribute__((weak)) void post_process_record_user(uint16_t keycode, keyrecord_t *record) {}
+
+__attribute__((weak)) layer_state_t layer_state_set_user(layer_state_t state) {
+    return state;
+}
+
+__attribute__((weak)) bool caps_word_press_user(uint16_t keycode) {
+    return true;
+}
+
+__attribute__((weak)) void caps_word_set_user(bool active) {}
+
+__attribute__((weak)) bool layer_lock_set_user(layer_state_t locked_layers) {
+    return true;
+}
+
+__attribute__((weak)) uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record) {
+    return TAPPING_TERM;
+}
+
+__attribute__((weak)) void keyboard_post_init_user(void) {}
+
+__attribute__((weak)) void matrix_scan_user(void) {}
+
+__attribute__((weak)) void housekeeping_task_user(void) {}
+
+__attribute__((weak)) void raw_hid_receive(uint8_t *data, uint8_t length) {}
+
+__attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {
+    return true;
+}
+
+// ============================================================================
+// SIMULATOR ENTRY POINTS
+// ============================================================================
+
+void sim_init(const sim_host_t *sim_host, bool use_virtual_time) {
+    host = sim_host;
+    virtual_time = use_virtual_time;
+    clock_ms = 0;
+    clock_gettime(CLOCK_MONOTONIC, &clock_start);
+    keyboard_post_init_user();
+}
+
+void action_exec(keyevent_t event) {
+    keyrecord_t record = {.event = event};
+    uint16_t keycode = get_event_keycode(record.event, false);
+
+    if (!pre_process_record_user(keycode, &record)) {
+        return;
+    }
+    process_tapping(&record);
+}
+
+void sim_key_event(uint8_t row, uint8_t col, bool pressed) {
+    if (row < MATRIX_ROWS && col < MATRIX_COLS) {
+        matrix[row] = pressed ? matrix[row] | (1 << col) : matrix[row] & ~(1 << col);
+    }
+    // Event times are never 0 (QMK reserves 0 for "no event")
+    action_exec((keyevent_t){.key = {.col = col, .row = row}, .pressed = pressed, .time = timer_read() | 1});
+}
+
+void sim_task(void) {
+    tapping_task();
+    caps_word_task();
+    layer_lock_task();
+    matrix_scan_user();
+    housekeeping_task_user();
+}
+
+void sim_advance(uint32_t ms) {
+    for (uint32_t i = 0; i < ms; i++) {
+        clock_ms++;
+        sim_task();
+    }
+}
@@ -0,0 +1,362 @@
+#pragma once
+
+// Host-side stand-in for QMK_KEYBOARD_H
+// Provides just enough of the QMK API (types, keycodes with their real QMK
+// values, layers, tapping, caps word, layer lock) to build keymap.c,
+// oneshot.c and friends natively. The engine lives in qmk_shim.c.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define pgm_read_byte(address) (*(const uint8_t *)(address))
+#define ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
+#define MATRIX_ROWS 8
+#define MATRIX_COLS 6
+
+// ============================================================================
+// KEYCODES (values match QMK's keycodes.h)
+// ============================================================================
+
+enum qk_keycode_defines {
+    KC_NO = 0x0000,
+    KC_TRANSPARENT = 0x0001,
+    KC_A = 0x0004, KC_B, KC_C, KC_D, KC_E, KC_F, KC_G, KC_H, KC_I, KC_J, KC_K, KC_L, KC_M,
+    KC_N, KC_O, KC_P, KC_Q, KC_R, KC_S, KC_T, KC_U, KC_V, KC_W, KC_X, KC_Y, KC_Z,
+    KC_1 = 0x001E, KC_2, KC_3, KC_4, KC_5, KC_6, KC_7, KC_8, KC_9, KC_0,
+    KC_ENTER = 0x0028,
+    KC_ESCAPE = 0x0029,
+    KC_BACKSPACE = 0x002A,
+    KC_TAB = 0x002B,
+    KC_SPACE = 0x002C,
+    KC_MINUS = 0x002D,
+    KC_EQUAL = 0x002E,
+    KC_LEFT_BRACKET = 0x002F,
+    KC_RIGHT_BRACKET = 0x0030,
+    KC_BACKSLASH = 0x0031,
+    KC_SEMICOLON = 0x0033,
+    KC_QUOTE = 0x0034,
+    KC_GRAVE = 0x0035,
+    KC_COMMA = 0x0036,
+    KC_DOT = 0x0037,
+    KC_SLASH = 0x0038,
+    KC_CAPS_LOCK = 0x0039,
+    KC_F1 = 0x003A, KC_F2, KC_F3, KC_F4, KC_F5, KC_F6, KC_F7, KC_F8, KC_F9, KC_F10, KC_F11, KC_F12,
+    KC_HOME = 0x004A,
+    KC_PAGE_UP = 0x004B,
+    KC_DELETE = 0x004C,
+    KC_END = 0x004D,
+    KC_PAGE_DOWN = 0x004E,
+    KC_RIGHT = 0x004F,
+    KC_LEFT = 0x0050,
+    KC_DOWN = 0x0051,
+    KC_UP = 0x0052,
+    KC_F13 = 0x0068, KC_F14, KC_F15, KC_F16, KC_F17, KC_F18, KC_F19, KC_F20, KC_F21, KC_F22, KC_F23, KC_F24,
+    KC_AUDIO_MUTE = 0x00A8,
+    KC_AUDIO_VOL_UP = 0x00A9,
+    KC_AUDIO_VOL_DOWN = 0x00AA,
+    KC_MEDIA_NEXT_TRACK = 0x00AB,
+    KC_MEDIA_PREV_TRACK = 0x00AC,
+    KC_MEDIA_STOP = 0x00AD,
+    KC_MEDIA_PLAY_PAUSE = 0x00AE,
+    KC_LEFT_CTRL = 0x00E0,
+    KC_LEFT_SHIFT = 0x00E1,
+    KC_LEFT_ALT = 0x00E2,
+    KC_LEFT_GUI = 0x00E3,
+    KC_RIGHT_CTRL = 0x00E4,
+    KC_RIGHT_SHIFT = 0x00E5,
+    KC_RIGHT_ALT = 0x00E6,
+    KC_RIGHT_GUI = 0x00E7,
+
+    QK_MODS = 0x0100,
+    QK_MOD_TAP = 0x2000,
+    QK_LAYER_TAP = 0x4000,
+    QK_LAYER_TAP_MAX = 0x4FFF,
+    QK_MOMENTARY = 0x5220,
+    QK_LAYER_LOCK = 0x7C7B,
+    QK_KB = 0x7E00,
+    QK_USER = 0x7E40,
+};
+
+#define SAFE_RANGE QK_USER
+
+#define XXXXXXX KC_NO
+#define _______ KC_TRANSPARENT
+#define KC_TRNS KC_TRANSPARENT
+#define KC_ENT KC_ENTER
+#define KC_ESC KC_ESCAPE
+#define KC_BSPC KC_BACKSPACE
+#define KC_SPC KC_SPACE
+#define KC_MINS KC_MINUS
+#define KC_EQL KC_EQUAL
+#define KC_LBRC KC_LEFT_BRACKET
+#define KC_RBRC KC_RIGHT_BRACKET
+#define KC_BSLS KC_BACKSLASH
+#define KC_SCLN KC_SEMICOLON
+#define KC_QUOT KC_QUOTE
+#define KC_GRV KC_GRAVE
+#define KC_COMM KC_COMMA
+#define KC_SLSH KC_SLASH
+#define KC_CAPS KC_CAPS_LOCK
+#define KC_PGUP KC_PAGE_UP
+#define KC_PGDN KC_PAGE_DOWN
+#define KC_DEL KC_DELETE
+#define KC_RGHT KC_RIGHT
+#define KC_MUTE KC_AUDIO_MUTE
+#define KC_VOLU KC_AUDIO_VOL_UP
+#define KC_VOLD KC_AUDIO_VOL_DOWN
+#define KC_MNXT KC_MEDIA_NEXT_TRACK
+#define KC_MPRV KC_MEDIA_PREV_TRACK
+#define KC_MSTP KC_MEDIA_STOP
+#define KC_MPLY KC_MEDIA_PLAY_PAUSE
+#define KC_LCTL KC_LEFT_CTRL
+#define KC_LSFT KC_LEFT_SHIFT
+#define KC_LALT KC_LEFT_ALT
+#define KC_LGUI KC_LEFT_GUI
+#define KC_RCTL KC_RIGHT_CTRL
+#define KC_RSFT KC_RIGHT_SHIFT
+#define KC_RALT KC_RIGHT_ALT
+#define KC_RGUI KC_RIGHT_GUI
+
+// Modded keycodes: QK_MODS | (mod bits << 8) | basic keycode
+#define QK_LCTL 0x0100
+#define QK_LSFT 0x0200
+#define QK_LALT 0x0400
+#define QK_LGUI 0x0800
+#define QK_RMODS_MIN 0x1000
+#define LCTL(kc) (QK_LCTL | (kc))
+#define LSFT(kc) (QK_LSFT | (kc))
+#define LALT(kc) (QK_LALT | (kc))
+#define LGUI(kc) (QK_LGUI | (kc))
+#define S(kc) LSFT(kc)
+#define SGUI(kc) (QK_LGUI | QK_LSFT | (kc))
+#define MEH(kc) (QK_LCTL | QK_LSFT | QK_LALT | (kc))
+#define HYPR(kc) (QK_LCTL | QK_LSFT | QK_LALT | QK_LGUI | (kc))
+#define KC_MEH MEH(KC_NO)
+#define KC_HYPR HYPR(KC_NO)
+
+#define KC_EXLM LSFT(KC_1)
+#define KC_AT LSFT(KC_2)
+#define KC_HASH LSFT(KC_3)
+#define KC_DLR LSFT(KC_4)
+#define KC_PERC LSFT(KC_5)
+#define KC_CIRC LSFT(KC_6)
+#define KC_AMPR LSFT(KC_7)
+#define KC_ASTR LSFT(KC_8)
+#define KC_LPRN LSFT(KC_9)
+#define KC_RPRN LSFT(KC_0)
+#define KC_UNDS LSFT(KC_MINUS)
+#define KC_PLUS LSFT(KC_EQUAL)
+#define KC_LCBR LSFT(KC_LEFT_BRACKET)
+#define KC_RCBR LSFT(KC_RIGHT_BRACKET)
+#define KC_PIPE LSFT(KC_BACKSLASH)
+#define KC_COLN LSFT(KC_SEMICOLON)
+#define KC_TILD LSFT(KC_GRAVE)
+
+#define LT(layer, kc) (QK_LAYER_TAP | (((layer) & 0xF) << 8) | ((kc) & 0xFF))
+#define MO(layer) (QK_MOMENTARY | ((layer) & 0x1F))
+#define QK_LLCK QK_LAYER_LOCK
+
+#define IS_QK_MODS(code) ((code) >= QK_MODS && (code) < QK_MOD_TAP)
+#define IS_QK_MOD_TAP(code) ((code) >= QK_MOD_TAP && (code) < QK_LAYER_TAP)
+#define IS_QK_LAYER_TAP(code) ((code) >= QK_LAYER_TAP && (code) <= QK_LAYER_TAP_MAX)
+#define IS_QK_MOMENTARY(code) ((code) >= QK_MOMENTARY && (code) <= (QK_MOMENTARY | 0x1F))
+#define QK_MODS_GET_MODS(kc) (((kc) >> 8) & 0x1F)
+#define QK_MODS_GET_BASIC_KEYCODE(kc) ((kc) & 0xFF)
+#define QK_LAYER_TAP_GET_LAYER(kc) (((kc) >> 8) & 0xF)
+#define QK_LAYER_TAP_GET_TAP_KEYCODE(kc) ((kc) & 0xFF)
+#define IS_MODIFIER_KEYCODE(code) ((code) >= KC_LEFT_CTRL && (code) <= KC_RIGHT_GUI)
+
+#define MOD_BIT(code) (1 << ((code) & 0x07))
+#define MOD_MASK_SHIFT (MOD_BIT(KC_LSFT) | MOD_BIT(KC_RSFT))
+#define MOD_LSFT 0x02  // 5-bit mods as in QK_MODS keycodes
+
+// ============================================================================
+// LAYOUT (LAYOUT_split_3x6_3 from keyboard.json)
+// ============================================================================
+
+// clang-format off
+#define LAYOUT_split_3x6_3( \
+    L00, L01, L02, L03, L04, L05,      R05, R04, R03, R02, R01, R00, \
+    L10, L11, L12, L13, L14, L15,      R15, R14, R13, R12, R11, R10, \
+    L20, L21, L22, L23, L24, L25,      R25, R24, R23, R22, R21, R20, \
+                   L30, L31, L32,      R32, R31, R30 \
+) { \
+    { L00, L01, L02, L03, L04, L05 }, \
+    { L10, L11, L12, L13, L14, L15 }, \
+    { L20, L21, L22, L23, L24, L25 }, \
+    { L30, L31, L32, KC_NO, KC_NO, KC_NO }, \
+    { R00, R01, R02, R03, R04, R05 }, \
+    { R10, R11, R12, R13, R14, R15 }, \
+    { R20, R21, R22, R23, R24, R25 }, \
+    { R30, R31, R32, KC_NO, KC_NO, KC_NO } \
+}
+// clang-format on
+
+// ============================================================================
+// EVENTS AND RECORDS
+// ============================================================================
+
+typedef struct {
+    uint8_t col;
+    uint8_t row;
+} keypos_t;
+
+typedef struct {
+    keypos_t key;
+    bool pressed;
+    uint16_t time;
+} keyevent_t;
+
+typedef struct {
+    bool interrupted : 1;
+    bool reserved2 : 1;
+    bool reserved1 : 1;
+    bool reserved0 : 1;
+    uint8_t count : 4;
+} tap_t;
+
+typedef struct {
+    keyevent_t event;
+    tap_t tap;
+    uint16_t keycode;
+} keyrecord_t;
+
+#define KEYEQ(a, b) ((a).row == (b).row && (a).col == (b).col)
+
+// Everything after the tapping state machine (QMK's action.h)
+void process_record(keyrecord_t *record);
+
+// A key event from the top: pre_process_record_user, then tapping
+void action_exec(keyevent_t event);
+
+extern const uint16_t keymaps[][MATRIX_ROWS][MATRIX_COLS];
+
+// ============================================================================
+// TIMER
+// ============================================================================
+
+#define TIMER_DIFF_16(a, b) ((uint16_t)((a) - (b)))
+#define TIMER_DIFF_32(a, b) ((uint32_t)((a) - (b)))
+
+uint16_t timer_read(void);
+uint32_t timer_read32(void);
+uint16_t timer_elapsed(uint16_t last);
+uint32_t timer_elapsed32(uint32_t last);
+void wait_ms(uint16_t ms);
+
+// ============================================================================
+// LAYERS
+// ============================================================================
+
+typedef uint32_t layer_state_t;
+extern layer_state_t layer_state;
+
+void layer_on(uint8_t layer);
+void layer_off(uint8_t layer);
+uint8_t get_highest_layer(layer_state_t state);
+bool layer_state_is(uint8_t layer);
+layer_state_t update_tri_layer_state(layer_state_t state, uint8_t layer1, uint8_t layer2, uint8_t layer3);
+uint8_t read_source_layers_cache(keypos_t key);
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
+uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column);
+bool is_layer_locked(uint8_t layer);
+bool layer_state_cmp(layer_state_t state, uint8_t layer);
+
+// ============================================================================
+// MATRIX
+// ============================================================================
+
+typedef uint8_t matrix_row_t;
+
+matrix_row_t matrix_get_row(uint8_t row);  // Keys down as fed to sim_key_event()
+bool is_keyboard_master(void);
+
+// ============================================================================
+// HID
+// ============================================================================
+
+void register_code(uint8_t code);
+void unregister_code(uint8_t code);
+void tap_code(uint8_t code);
+void register_code16(uint16_t code);
+void unregister_code16(uint16_t code);
+void tap_code16(uint16_t code);
+uint8_t get_mods(void);
+void add_weak_mods(uint8_t mods);
+void del_weak_mods(uint8_t mods);
+void clear_weak_mods(void);
+void send_keyboard_report(void);
+
+typedef int8_t mouse_xy_report_t;
+typedef int16_t mouse_hv_report_t;
+
+typedef struct {
+    uint8_t buttons;
+    mouse_xy_report_t x;
+    mouse_xy_report_t y;
+    mouse_hv_report_t v;
+    mouse_hv_report_t h;
+} report_mouse_t;
+
+void host_mouse_send(report_mouse_t *report);
+
+// ============================================================================
+// FEATURES
+// ============================================================================
+
+void caps_word_on(void);
+void caps_word_off(void);
+void caps_word_toggle(void);
+bool is_caps_word_on(void);
+
+// RGB matrix stubs: enough for key_indicators.c, frames run by sim_rgb_frame()
+#define RGB_MATRIX_LED_COUNT 62
+#define NO_LED 255
+
+typedef struct {
+    uint8_t h;
+    uint8_t s;
+    uint8_t v;
+} hsv_t;
+
+typedef struct {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+} rgb_t;
+
+typedef struct {
+    uint8_t matrix_co[MATRIX_ROWS][MATRIX_COLS];
+} led_config_t;
+
+extern led_config_t g_led_config;
+
+rgb_t rgb_matrix_hsv_to_rgb(hsv_t hsv);
+void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
+
+void eeconfig_read_user_datablock(void *data, uint32_t offset, uint32_t length);
+void eeconfig_update_user_datablock(const void *data, uint32_t offset, uint32_t length);
+
+// Keyboard config.h, then keymap config.h (same order as a QMK build)
+#include "../../../config.h"
+#include "../config.h"
+
+// ============================================================================
+// USER HOOKS (weak defaults in qmk_shim.c)
+// ============================================================================
+
+bool pre_process_record_user(uint16_t keycode, keyrecord_t *record);
+bool process_record_user(uint16_t keycode, keyrecord_t *record);
+void post_process_record_user(uint16_t keycode, keyrecord_t *record);
+layer_state_t layer_state_set_user(layer_state_t state);
+bool caps_word_press_user(uint16_t keycode);
+void caps_word_set_user(bool active);
+bool layer_lock_set_user(layer_state_t locked_layers);
+uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record);
+void keyboard_post_init_user(void);
+void matrix_scan_user(void);
+void housekeeping_task_user(void);
+bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max);
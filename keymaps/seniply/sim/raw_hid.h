@@ -0,0 +1,7 @@
+#pragma once
+
+#include <stdint.h>
+
+// Host-side stand-in for QMK's raw_hid.h (replies are captured by qmk_shim.c)
+void raw_hid_receive(uint8_t *data, uint8_t length);
+void raw_hid_send(uint8_t *data, uint8_t length);
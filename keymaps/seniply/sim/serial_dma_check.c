@@ -0,0 +1,273 @@
+// Byte-level check of the serial_dma.c matrix pipeline (built and run by sim/build.sh)
+// serial_dma.c is compiled natively against the stand-ins in sim/chibios/;
+// this file is the wire and QMK on both ends of it. The slave parses the
+// request bytes as serial_protocol.c's react_to_transaction() does (ID in,
+// token ID ^ HANDSHAKE_MAGIC out, initiator2target bytes in, then the
+// target2initiator buffer out) and runs whenever the master waits for a
+// byte, or when a step lets it answer in the background.
+// __real_soft_serial_transaction() is serial_protocol.c's
+// initiate_transaction() over the wrapped driver calls, and
+// __real_transport_master() reads the matrix the way transactions.c does
+// (checksum, then the data when it changed). The link timing is modelled
+// by split_sim.c; this checks the bytes.
+
+#include "quantum.h"
+#include "serial.h"
+#include "transactions.h"
+#include <hal.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#define HANDSHAKE_MAGIC 7
+#define RX_SIZE 128  // SERIAL_DMA_RX_SIZE default
+#define ROWS 4       // Rows per half
+#define AGE_US 1000  // SERIAL_DMA_PREFETCH_AGE_US default
+
+// serial_dma.c
+void __wrap_serial_transport_driver_master_init(void);
+void __wrap_serial_transport_driver_clear(void);
+bool __wrap_serial_transport_send(const uint8_t *source, const size_t size);
+bool __wrap_serial_transport_receive(uint8_t *destination, const size_t size);
+bool __wrap_soft_serial_transaction(int index);
+bool __wrap_transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
+
+static uint32_t failures = 0;
+
+static void expect(const char *step, bool ok) {
+    if (!ok) {
+        printf("%s: failed\n", step);
+        failures++;
+    }
+}
+
+// ============================================================================
+// SLAVE (serial_protocol.c, react_to_transaction)
+// ============================================================================
+
+static struct {
+    uint8_t request[64];  // Master -> slave bytes not parsed yet
+    uint8_t pending;
+    int8_t id;            // Transaction being received, -1 = waiting for an ID
+    uint8_t received;     // Its initiator2target bytes so far
+    bool bad_token;       // Corrupt the next token
+    bool mute;            // Missing half: nothing comes back
+    uint8_t in[NUM_TRANSACTIONS][8];
+    uint8_t out[NUM_TRANSACTIONS][8];
+} slave = {.id = -1};
+
+static uint32_t rx_written = 0;  // Bytes the slave has put in the master's ring
+
+static void slave_send(const uint8_t *data, uint8_t size) {
+    uint8_t *ring = dma_streams[1].memory;
+    while (size--) {
+        ring[rx_written++ & (RX_SIZE - 1)] = *data++;
+    }
+}
+
+static void slave_finish(void) {
+    const split_transaction_desc_t *trans = &split_transaction_table[slave.id];
+    slave_send(slave.out[slave.id], trans->target2initiator_buffer_size);
+    slave.id = -1;
+}
+
+// Answers the request bytes received so far. True when it sent anything.
+static bool slave_run(void) {
+    uint32_t before = rx_written;
+    for (uint8_t i = 0; i < slave.pending; i++) {
+        uint8_t byte = slave.request[i];
+        if (slave.mute) {
+            continue;
+        }
+        if (slave.id < 0) {
+            if (byte >= NUM_TRANSACTIONS) {
+                continue;
+            }
+            slave.id = byte;
+            slave.received = 0;
+            uint8_t token = byte ^ HANDSHAKE_MAGIC;
+            if (slave.bad_token) {
+                token ^= 0xFF;
+                slave.bad_token = false;
+            }
+            slave_send(&token, sizeof(token));
+        } else {
+            slave.in[slave.id][slave.received++] = byte;
+        }
+        if (slave.id >= 0 && slave.received == split_transaction_table[slave.id].initiator2target_buffer_size) {
+            slave_finish();
+        }
+    }
+    slave.pending = 0;
+    return rx_written != before;
+}
+
+static uint8_t checksum(const uint8_t *rows) {
+    uint8_t sum = 0x5A;
+    for (uint8_t i = 0; i < ROWS; i++) {
+        sum = (sum << 1 | sum >> 7) ^ rows[i];
+    }
+    return sum;
+}
+
+static void slave_set_rows(uint8_t row0) {
+    uint8_t rows[ROWS] = {row0, 0, 0, 0};
+    memcpy(slave.out[GET_SLAVE_MATRIX_DATA], rows, ROWS);
+    slave.out[GET_SLAVE_MATRIX_CHECKSUM][0] = checksum(rows);
+}
+
+// ============================================================================
+// HAL (sim/chibios/hal.h): the wire
+// ============================================================================
+
+stm32_dma_stream_t dma_streams[2];
+USART_TypeDef usart1;
+SYSCFG_TypeDef syscfg;
+
+static systime_t now = 0;
+static uint8_t wire[64];  // Last TX transfer, master -> slave
+static uint8_t wire_size = 0;
+
+systime_t chVTGetSystemTimeX(void) {
+    return now;
+}
+
+sysinterval_t chVTTimeElapsedSinceX(systime_t start) {
+    return now - start;
+}
+
+size_t dmaStreamGetTransactionSize(stm32_dma_stream_t *stream) {
+    if (stream == STM32_DMA1_STREAM5) {
+        return RX_SIZE - (rx_written & (RX_SIZE - 1));  // Circular, counts down
+    }
+    return 0;  // TX done as soon as it starts
+}
+
+void dmaStreamEnable(stm32_dma_stream_t *stream) {
+    if (stream == STM32_DMA1_STREAM4) {
+        memcpy(wire, stream->memory, stream->size);
+        wire_size = stream->size;
+        memcpy(&slave.request[slave.pending], stream->memory, stream->size);
+        slave.pending += stream->size;
+    }
+}
+
+// The master waits for a byte: the slave gets the CPU first
+void palWaitLineTimeoutS(uint32_t line, sysinterval_t timeout) {
+    if (!slave_run()) {
+        now += timeout;
+    }
+}
+
+// ============================================================================
+// MASTER (serial_protocol.c, transactions.c)
+// ============================================================================
+
+static uint8_t master_checksum;
+static uint8_t master_rows[ROWS];
+static uint8_t master_rpc_info[4];
+static uint32_t wire_transactions = 0;  // Run by serial_protocol.c, not served from a prefetch
+
+split_transaction_desc_t split_transaction_table[NUM_TRANSACTIONS] = {
+    [GET_SLAVE_MATRIX_CHECKSUM] = {0, 1, NULL, &master_checksum},
+    [GET_SLAVE_MATRIX_DATA] = {0, ROWS, NULL, master_rows},
+    [PUT_RPC_INFO] = {sizeof(master_rpc_info), 0, master_rpc_info, NULL},
+};
+
+bool is_transport_connected(void) {
+    return true;
+}
+
+bool __real_soft_serial_transaction(int index) {
+    split_transaction_desc_t *trans = &split_transaction_table[index];
+    uint8_t id = index, token = 0xFF;
+    wire_transactions++;
+    __wrap_serial_transport_driver_clear();
+    if (!__wrap_serial_transport_send(&id, sizeof(id))) {
+        return false;
+    }
+    if (!__wrap_serial_transport_receive(&token, sizeof(token)) || token != (id ^ HANDSHAKE_MAGIC)) {
+        return false;
+    }
+    if (trans->initiator2target_buffer_size &&
+        !__wrap_serial_transport_send(split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size)) {
+        return false;
+    }
+    if (trans->target2initiator_buffer_size &&
+        !__wrap_serial_transport_receive(split_trans_target2initiator_buffer(trans), trans->target2initiator_buffer_size)) {
+        return false;
+    }
+    return true;
+}
+
+bool __real_transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    if (!__wrap_soft_serial_transaction(GET_SLAVE_MATRIX_CHECKSUM)) {
+        return false;
+    }
+    if (master_checksum != checksum(slave_matrix)) {
+        if (!__wrap_soft_serial_transaction(GET_SLAVE_MATRIX_DATA)) {
+            return false;
+        }
+        memcpy(slave_matrix, master_rows, ROWS);
+    }
+    return true;
+}
+
+// ============================================================================
+// STEPS
+// ============================================================================
+
+static matrix_row_t slave_matrix[ROWS];
+
+static bool scan(void) {
+    matrix_row_t master_matrix[ROWS] = {0};
+    return __wrap_transport_master(master_matrix, slave_matrix);
+}
+
+int main(void) {
+    static const uint8_t prefetch_request[] = {GET_SLAVE_MATRIX_CHECKSUM, GET_SLAVE_MATRIX_DATA};
+    __wrap_serial_transport_driver_master_init();
+
+    // Nothing in flight: both reads on the wire, then the next scan's requests
+    slave_set_rows(0x01);
+    expect("first scan", scan() && slave_matrix[0] == 0x01 && wire_transactions == 2);
+    expect("prefetch request bytes", wire_size == sizeof(prefetch_request) && !memcmp(wire, prefetch_request, wire_size));
+
+    // Answered in the background: token, checksum, token, rows, all taken from the ring
+    slave_set_rows(0x02);
+    slave_run();
+    now += 300;
+    expect("prefetched scan", scan() && slave_matrix[0] == 0x02 && wire_transactions == 2);
+
+    // A corrupted token fails the transaction instead of being read as data
+    slave_set_rows(0x04);
+    slave.bad_token = true;
+    slave_run();
+    now += 300;
+    expect("bad token fails the scan", !scan() && slave_matrix[0] == 0x02);
+    slave_run();
+    now += 300;
+    expect("scan after a bad token", scan() && slave_matrix[0] == 0x04 && wire_transactions == 2);
+
+    // A write behind the requests in flight waits for their replies, then goes out whole
+    static const uint8_t info[] = {0x11, 0x22, 0x33, 0x44};
+    memcpy(master_rpc_info, info, sizeof(info));
+    expect("write behind a prefetch", __wrap_soft_serial_transaction(PUT_RPC_INFO) && wire_transactions == 3);
+    slave_run();
+    expect("write payload", !memcmp(slave.in[PUT_RPC_INFO], info, sizeof(info)));
+    expect("scan after the write", scan() && slave_matrix[0] == 0x04 && wire_transactions == 4);
+
+    // Replies older than SERIAL_DMA_PREFETCH_AGE_US are read again
+    slave_set_rows(0x08);
+    slave_run();
+    now += AGE_US + 100;
+    expect("stale prefetch read again", scan() && slave_matrix[0] == 0x08 && wire_transactions == 6);
+
+    // A missing half costs one timeout per scan
+    slave.mute = true;
+    systime_t start = now;
+    expect("missing half", !scan() && now - start == TIME_MS2I(20));
+
+    printf("serial_dma: %s\n", failures ? "FAIL" : "ok");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Host side of the simulator: drives the QMK shim (qmk_shim.c) with matrix
+// events and receives the HID reports the keymap produces.
+
+#define SIM_KEYBOARD_REPORT_SIZE 8  // mods, reserved, 6 keys (QMK report_keyboard_t)
+
+typedef struct {
+    void (*keyboard)(const uint8_t report[SIM_KEYBOARD_REPORT_SIZE]);
+    void (*consumer)(uint16_t usage);
+    void (*mouse)(uint8_t buttons, int8_t x, int8_t y, int16_t v, int16_t h);
+    void (*raw_hid)(const uint8_t *data, uint8_t length);
+} sim_host_t;
+
+// virtual_time: the clock only moves through sim_advance() (and wait_ms),
+// otherwise it follows CLOCK_MONOTONIC
+void sim_init(const sim_host_t *host, bool virtual_time);
+
+// Matrix event at the current time (goes through pre_process_record_user
+// and the tapping state machine like a real scan)
+void sim_key_event(uint8_t row, uint8_t col, bool pressed);
+
+// One main loop iteration: tapping timeouts, caps word / layer lock idle
+// timers, matrix_scan_user and housekeeping_task_user
+void sim_task(void);
+
+// Advance the virtual clock by ms, running sim_task() every millisecond
+void sim_advance(uint32_t ms);
+
+uint32_t sim_now(void);
+
+// One RGB matrix frame over a black effect: the indicator hook for every
+// LED. The shim's hsv -> rgb passes h, s, v through, so colors[] holds the
+// HSV each LED was given (key_indicators.c, built by the indicator check).
+#define SIM_RGB_LED_COUNT 62  // RGB_MATRIX_LED_COUNT
+void sim_rgb_frame(uint8_t colors[SIM_RGB_LED_COUNT][3]);
+
+// Keyboard LED state from the host (UHID output report)
+void sim_set_host_leds(uint8_t leds);
+uint8_t host_keyboard_leds(void);
+
+// Back the EECONFIG user datablock with a file (loaded now, saved on update)
+void sim_eeconfig_file(const char *path);
@@ -0,0 +1,576 @@
+// Seniply keymap simulator
+// Runs keymap.c / oneshot.c / speculative_tap.c / tap_tune.c natively on
+// Linux and sends the resulting HID reports through /dev/uhid, so the host
+// sees a real keyboard. See README.md for usage.
+
+#define _GNU_SOURCE  // accept4
+
+#include "sim.h"
+#include "uhid_backend.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <linux/input.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#define EVENT_QUEUE_SIZE 256
+#define LATENCY_SAMPLES 65536
+
+typedef struct {
+    uint32_t delay;  // ms after the previous event
+    uint8_t row;
+    uint8_t col;
+    bool pressed;
+} sim_event_t;
+
+static volatile sig_atomic_t running = 1;
+static int measure_fd = -1;
+
+static struct {
+    bool uhid;
+    bool fast;
+    bool measure;
+    bool verbose;
+    uint32_t repeat;
+} opts = {.uhid = true, .repeat = 1};
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+// ============================================================================
+// EVENT QUEUE (script / socket input, replayed at their scheduled times)
+// ============================================================================
+
+static sim_event_t queue[EVENT_QUEUE_SIZE];
+static uint16_t queue_head = 0, queue_tail = 0;
+static uint64_t last_due_ns = 0;
+
+static bool queue_empty(void) {
+    return queue_head == queue_tail;
+}
+
+static bool queue_push(const sim_event_t *event) {
+    uint16_t next = (queue_head + 1) % EVENT_QUEUE_SIZE;
+    if (next == queue_tail) {
+        return false;
+    }
+    queue[queue_head] = *event;
+    queue_head = next;
+    return true;
+}
+
+// Script line: <delay_ms> <row> <col> <d|u>, '#' starts a comment
+static bool parse_event(const char *line, sim_event_t *event) {
+    unsigned delay, row, col;
+    char action;
+    if (sscanf(line, "%u %u %u %c", &delay, &row, &col, &action) != 4 || (action != 'd' && action != 'u')) {
+        return false;
+    }
+    if (row >= 8 || col >= 6) {
+        return false;
+    }
+    *event = (sim_event_t){.delay = delay, .row = row, .col = col, .pressed = action == 'd'};
+    return true;
+}
+
+// ============================================================================
+// HOST CALLBACKS
+// ============================================================================
+
+// Pending reports for latency measurement, matched FIFO with evdev frames
+static struct {
+    uint64_t cause_ns;  // Matrix event that led to the report
+    uint64_t sent_ns;   // Report written to uhid
+} pending[EVENT_QUEUE_SIZE];
+static uint16_t pending_head = 0, pending_tail = 0;
+static uint64_t last_event_ns = 0;
+
+static uint32_t *keymap_latency, *host_latency;  // us
+static uint32_t latency_count = 0;
+
+static void on_keyboard(const uint8_t report[SIM_KEYBOARD_REPORT_SIZE]) {
+    if (opts.verbose || !opts.uhid) {
+        printf("%8u kbd %02x |", sim_now(), report[0]);
+        for (uint8_t i = 2; i < SIM_KEYBOARD_REPORT_SIZE; i++) {
+            printf(" %02x", report[i]);
+        }
+        printf("\n");
+    }
+    if (opts.uhid) {
+        uhid_backend_keyboard(report);
+    }
+    if (opts.measure) {
+        pending[pending_head].cause_ns = last_event_ns;
+        pending[pending_head].sent_ns = monotonic_ns();
+        pending_head = (pending_head + 1) % EVENT_QUEUE_SIZE;
+    }
+}
+
+static void on_consumer(uint16_t usage) {
+    if (opts.verbose || !opts.uhid) {
+        printf("%8u consumer %04x\n", sim_now(), usage);
+    }
+    if (opts.uhid) {
+        uhid_backend_consumer(usage);
+    }
+}
+
+static void on_mouse(uint8_t buttons, int8_t x, int8_t y, int16_t v, int16_t h) {
+    if (opts.verbose || !opts.uhid) {
+        printf("%8u mouse %02x x %d y %d v %d h %d\n", sim_now(), buttons, x, y, v, h);
+    }
+}
+
+static void on_raw_hid(const uint8_t *data, uint8_t length) {
+    if (opts.uhid) {
+        uhid_backend_raw_hid(data, length);
+    }
+}
+
+static const sim_host_t host = {on_keyboard, on_consumer, on_mouse, on_raw_hid};
+
+static void fire(const sim_event_t *event) {
+    last_event_ns = monotonic_ns();
+    if (opts.verbose || !opts.uhid) {
+        printf("%8u key %u,%u %s\n", sim_now(), event->row, event->col, event->pressed ? "down" : "up");
+    }
+    sim_key_event(event->row, event->col, event->pressed);
+}
+
+// ============================================================================
+// LATENCY MEASUREMENT (report -> kernel input event)
+// ============================================================================
+
+// Find the evdev node the kernel created for the uhid keyboard
+static int open_evdev_by_name(const char *name) {
+    for (int attempt = 0; attempt < 100; attempt++) {
+        DIR *dir = opendir("/dev/input");
+        struct dirent *entry;
+        while (dir && (entry = readdir(dir))) {
+            if (strncmp(entry->d_name, "event", 5) != 0) {
+                continue;
+            }
+            char path[300], dev_name[256] = "";
+            snprintf(path, sizeof(path), "/dev/input/%s", entry->d_name);
+            int fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+            if (fd < 0) {
+                continue;
+            }
+            if (ioctl(fd, EVIOCGNAME(sizeof(dev_name)), dev_name) >= 0 && strcmp(dev_name, name) == 0) {
+                closedir(dir);
+                int clock = CLOCK_MONOTONIC;
+                ioctl(fd, EVIOCSCLOCKID, &clock);
+                return fd;
+            }
+            close(fd);
+        }
+        if (dir) {
+            closedir(dir);
+        }
+        usleep(20000);  // Device nodes appear asynchronously after UHID_CREATE2
+    }
+    return -1;
+}
+
+// One SYN_REPORT frame with key changes = one keyboard report
+static void read_evdev(int fd) {
+    static bool frame_has_key = false;
+    struct input_event ev;
+
+    while (read(fd, &ev, sizeof(ev)) == sizeof(ev)) {
+        if (ev.type == EV_KEY && ev.value != 2) {
+            frame_has_key = true;
+        } else if (ev.type == EV_SYN && ev.code == SYN_REPORT && frame_has_key) {
+            frame_has_key = false;
+            if (pending_tail == pending_head) {
+                continue;  // Input not produced by us (should not happen)
+            }
+            uint64_t kernel_ns = (uint64_t)ev.input_event_sec * 1000000000ull + ev.input_event_usec * 1000ull;
+            if (latency_count < LATENCY_SAMPLES) {
+                keymap_latency[latency_count] = (pending[pending_tail].sent_ns - pending[pending_tail].cause_ns) / 1000;
+                host_latency[latency_count] = (kernel_ns - pending[pending_tail].sent_ns) / 1000;
+                latency_count++;
+            }
+            pending_tail = (pending_tail + 1) % EVENT_QUEUE_SIZE;
+        }
+    }
+}
+
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void print_latency(const char *label, uint32_t *samples, uint32_t count) {
+    uint64_t sum = 0;
+    qsort(samples, count, sizeof(*samples), compare_u32);
+    for (uint32_t i = 0; i < count; i++) {
+        sum += samples[i];
+    }
+    printf("%-22s mean %6llu us  p50 %6u us  p99 %6u us  max %6u us\n", label, (unsigned long long)(sum / count),
+           samples[count / 2], samples[(uint64_t)count * 99 / 100], samples[count - 1]);
+}
+
+static void print_latency_stats(void) {
+    if (latency_count == 0) {
+        printf("No reports matched to input events\n");
+        return;
+    }
+    printf("%u reports\n", latency_count);
+    print_latency("event -> report:", keymap_latency, latency_count);
+    print_latency("report -> evdev:", host_latency, latency_count);
+}
+
+// ============================================================================
+// EVDEV INPUT (physical keyboard, QWERTY positions -> Cleo matrix)
+// ============================================================================
+
+typedef struct {
+    uint16_t code;
+    uint8_t row;
+    uint8_t col;
+} evdev_map_t;
+
+// Right half columns are mirrored in the matrix (see LAYOUT_split_3x6_3)
+static const evdev_map_t evdev_map[] = {
+    {KEY_TAB, 0, 0},        {KEY_Q, 0, 1},          {KEY_W, 0, 2},         {KEY_E, 0, 3},       {KEY_R, 0, 4},     {KEY_T, 0, 5},
+    {KEY_CAPSLOCK, 1, 0},   {KEY_A, 1, 1},          {KEY_S, 1, 2},         {KEY_D, 1, 3},       {KEY_F, 1, 4},     {KEY_G, 1, 5},
+    {KEY_LEFTSHIFT, 2, 0},  {KEY_Z, 2, 1},          {KEY_X, 2, 2},         {KEY_C, 2, 3},       {KEY_V, 2, 4},     {KEY_B, 2, 5},
+    {KEY_LEFTALT, 3, 0},    {KEY_SPACE, 3, 1},      {KEY_RIGHTALT, 3, 2},
+    {KEY_Y, 4, 5},          {KEY_U, 4, 4},          {KEY_I, 4, 3},         {KEY_O, 4, 2},       {KEY_P, 4, 1},     {KEY_LEFTBRACE, 4, 0},
+    {KEY_H, 5, 5},          {KEY_J, 5, 4},          {KEY_K, 5, 3},         {KEY_L, 5, 2},       {KEY_SEMICOLON, 5, 1}, {KEY_APOSTROPHE, 5, 0},
+    {KEY_N, 6, 5},          {KEY_M, 6, 4},          {KEY_COMMA, 6, 3},     {KEY_DOT, 6, 2},     {KEY_SLASH, 6, 1}, {KEY_RIGHTSHIFT, 6, 0},
+    {KEY_RIGHTCTRL, 7, 2},  {KEY_BACKSPACE, 7, 1},  {KEY_ENTER, 7, 0},
+};
+
+static int open_evdev_input(const char *path) {
+    int fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    // Grab so the keystrokes only reach the host through the simulated keyboard
+    if (ioctl(fd, EVIOCGRAB, 1) < 0) {
+        fprintf(stderr, "%s: cannot grab: %s\n", path, strerror(errno));
+    }
+    return fd;
+}
+
+static void read_evdev_input(int fd) {
+    struct input_event ev;
+    while (read(fd, &ev, sizeof(ev)) == sizeof(ev)) {
+        if (ev.type != EV_KEY || ev.value == 2) {
+            continue;
+        }
+        for (size_t i = 0; i < sizeof(evdev_map) / sizeof(evdev_map[0]); i++) {
+            if (evdev_map[i].code == ev.code) {
+                sim_event_t event = {.row = evdev_map[i].row, .col = evdev_map[i].col, .pressed = ev.value == 1};
+                fire(&event);
+                break;
+            }
+        }
+    }
+}
+
+// ============================================================================
+// SOCKET INPUT (unix stream socket, script lines)
+// ============================================================================
+
+static int open_socket(const char *path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    struct sockaddr_un addr = {.sun_family = AF_UNIX};
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path);
+    unlink(path);
+    if (fd < 0 || bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(fd, 1) < 0) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    return fd;
+}
+
+// Returns false when the client disconnected
+static bool read_socket(int fd) {
+    static char buffer[4096];
+    static size_t used = 0;
+
+    ssize_t n = read(fd, buffer + used, sizeof(buffer) - used - 1);
+    if (n == 0 || (n < 0 && errno != EAGAIN)) {
+        used = 0;
+        return false;
+    }
+    if (n < 0) {
+        return true;
+    }
+    used += n;
+    buffer[used] = '\0';
+
+    char *line = buffer, *end;
+    while ((end = strchr(line, '\n'))) {
+        *end = '\0';
+        sim_event_t event;
+        if (parse_event(line, &event) && !queue_push(&event)) {
+            fprintf(stderr, "socket: event queue full, dropping event\n");
+        }
+        line = end + 1;
+    }
+    used = strlen(line);
+    memmove(buffer, line, used);
+    return true;
+}
+
+// ============================================================================
+// SCRIPT INPUT
+// ============================================================================
+
+static sim_event_t *script = NULL;
+static size_t script_len = 0;
+
+static bool load_script(const char *path) {
+    FILE *f = strcmp(path, "-") == 0 ? stdin : fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return false;
+    }
+    char line[256];
+    size_t capacity = 0, line_number = 0;
+    while (fgets(line, sizeof(line), f)) {
+        line_number++;
+        char *comment = strchr(line, '#');
+        if (comment) {
+            *comment = '\0';
+        }
+        if (strspn(line, " \t\r\n") == strlen(line)) {
+            continue;
+        }
+        if (script_len == capacity) {
+            capacity = capacity ? capacity * 2 : 256;
+            script = realloc(script, capacity * sizeof(*script));
+        }
+        if (!parse_event(line, &script[script_len])) {
+            fprintf(stderr, "%s:%zu: expected <delay_ms> <row> <col> <d|u>\n", path, line_number);
+            return false;
+        }
+        script_len++;
+    }
+    if (f != stdin) {
+        fclose(f);
+    }
+    return true;
+}
+
+// Fast mode: virtual clock, no sleeping - for stress runs
+static void run_script_fast(void) {
+    for (uint32_t r = 0; r < opts.repeat && running; r++) {
+        for (size_t i = 0; i < script_len; i++) {
+            sim_advance(script[i].delay);
+            fire(&script[i]);
+            if (measure_fd >= 0) {
+                read_evdev(measure_fd);
+            }
+        }
+    }
+    sim_advance(1000);  // Let pending tapping / oneshot timeouts expire
+}
+
+// ============================================================================
+// MAIN LOOP
+// ============================================================================
+
+static void on_signal(int sig) {
+    (void)sig;
+    running = 0;
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr,
+            "usage: %s [options]\n"
+            "  -s, --script FILE   replay <delay_ms> <row> <col> <d|u> lines ('-' = stdin)\n"
+            "  -u, --socket PATH   accept script lines on a unix socket\n"
+            "  -e, --evdev DEV     read a physical keyboard (grabbed, QWERTY -> matrix)\n"
+            "  -r, --repeat N      replay the script N times\n"
+            "  -f, --fast          virtual clock, no sleeping (script only)\n"
+            "  -m, --measure       report -> kernel input event latency statistics\n"
+            "  -n, --no-uhid       print reports instead of creating devices\n"
+            "  -p, --eeprom FILE   persist the EECONFIG user datablock\n"
+            "  -v, --verbose       print events and reports\n",
+            argv0);
+}
+
+int main(int argc, char **argv) {
+    static const struct option long_options[] = {
+        {"script", required_argument, 0, 's'}, {"socket", required_argument, 0, 'u'},
+        {"evdev", required_argument, 0, 'e'},  {"repeat", required_argument, 0, 'r'},
+        {"fast", no_argument, 0, 'f'},         {"measure", no_argument, 0, 'm'},
+        {"no-uhid", no_argument, 0, 'n'},      {"eeprom", required_argument, 0, 'p'},
+        {"verbose", no_argument, 0, 'v'},      {0, 0, 0, 0},
+    };
+    const char *script_path = NULL, *socket_path = NULL, *evdev_path = NULL;
+    int opt;
+
+    while ((opt = getopt_long(argc, argv, "s:u:e:r:fmnp:v", long_options, NULL)) != -1) {
+        switch (opt) {
+        case 's': script_path = optarg; break;
+        case 'u': socket_path = optarg; break;
+        case 'e': evdev_path = optarg; break;
+        case 'r': opts.repeat = strtoul(optarg, NULL, 0); break;
+        case 'f': opts.fast = true; break;
+        case 'm': opts.measure = true; break;
+        case 'n': opts.uhid = false; break;
+        case 'p': sim_eeconfig_file(optarg); break;
+        case 'v': opts.verbose = true; break;
+        default: usage(argv[0]); return 2;
+        }
+    }
+    if (!script_path && !socket_path && !evdev_path) {
+        usage(argv[0]);
+        return 2;
+    }
+    if (opts.fast && !script_path) {
+        fprintf(stderr, "--fast needs --script\n");
+        return 2;
+    }
+    if (opts.measure && !opts.uhid) {
+        fprintf(stderr, "--measure needs the uhid devices\n");
+        return 2;
+    }
+    if (script_path && !load_script(script_path)) {
+        return 1;
+    }
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    if (opts.uhid && !uhid_backend_open()) {
+        return 1;
+    }
+
+    if (opts.measure) {
+        keymap_latency = calloc(LATENCY_SAMPLES, sizeof(uint32_t));
+        host_latency = calloc(LATENCY_SAMPLES, sizeof(uint32_t));
+        measure_fd = open_evdev_by_name(uhid_backend_keyboard_name());
+        if (measure_fd < 0) {
+            fprintf(stderr, "cannot find the evdev node of the simulated keyboard\n");
+            uhid_backend_close();
+            return 1;
+        }
+    }
+
+    sim_init(&host, opts.fast);
+
+    if (opts.fast) {
+        run_script_fast();
+        if (measure_fd >= 0) {
+            usleep(100000);
+            read_evdev(measure_fd);
+        }
+    } else {
+        int listen_fd = socket_path ? open_socket(socket_path) : -1;
+        int client_fd = -1;
+        int input_fd = evdev_path ? open_evdev_input(evdev_path) : -1;
+        size_t script_pos = 0;
+        uint32_t script_round = 0;
+
+        if ((socket_path && listen_fd < 0) || (evdev_path && input_fd < 0)) {
+            uhid_backend_close();
+            return 1;
+        }
+        last_due_ns = monotonic_ns();
+
+        while (running) {
+            // Refill from the script
+            while (script && script_round < opts.repeat && queue_push(&script[script_pos])) {
+                if (++script_pos == script_len) {
+                    script_pos = 0;
+                    script_round++;
+                }
+            }
+            if (script && script_round >= opts.repeat && queue_empty()) {
+                running = 0;  // Script done (tapping timeouts below still run once)
+            }
+
+            // Fire due events
+            while (!queue_empty()) {
+                uint64_t due = last_due_ns + (uint64_t)queue[queue_tail].delay * 1000000ull;
+                uint64_t now = monotonic_ns();
+                if (due > now) {
+                    break;
+                }
+                last_due_ns = due;
+                fire(&queue[queue_tail]);
+                queue_tail = (queue_tail + 1) % EVENT_QUEUE_SIZE;
+            }
+            if (queue_empty() && client_fd >= 0) {
+                last_due_ns = monotonic_ns();  // Socket delays are relative to arrival
+            }
+
+            struct pollfd fds[UHID_BACKEND_DEVICES + 4];
+            nfds_t nfds = 0;
+            int uhid_fds[UHID_BACKEND_DEVICES];
+            uint8_t uhid_count = opts.uhid ? uhid_backend_fds(uhid_fds) : 0;
+            for (uint8_t i = 0; i < uhid_count; i++) {
+                fds[nfds++] = (struct pollfd){.fd = uhid_fds[i], .events = POLLIN};
+            }
+            int extra[] = {measure_fd, input_fd, client_fd >= 0 ? client_fd : listen_fd};
+            for (uint8_t i = 0; i < 3; i++) {
+                fds[nfds++] = (struct pollfd){.fd = extra[i], .events = POLLIN};  // fd -1 is ignored
+            }
+
+            // 1 ms main loop tick, like the firmware's scan loop
+            if (poll(fds, nfds, 1) > 0) {
+                for (nfds_t i = 0; i < nfds; i++) {
+                    if (!(fds[i].revents & (POLLIN | POLLHUP))) {
+                        continue;
+                    }
+                    int fd = fds[i].fd;
+                    if (i < uhid_count) {
+                        uhid_backend_handle(fd);
+                    } else if (fd == measure_fd) {
+                        read_evdev(fd);
+                    } else if (fd == input_fd) {
+                        read_evdev_input(fd);
+                    } else if (fd == listen_fd) {
+                        client_fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                        last_due_ns = monotonic_ns();
+                    } else if (fd == client_fd && !read_socket(fd)) {
+                        close(client_fd);
+                        client_fd = -1;
+                    }
+                }
+            }
+            sim_task();
+        }
+
+        // Drain: let timeouts release anything still held
+        uint64_t end = monotonic_ns() + 1000000000ull;
+        while (monotonic_ns() < end) {
+            sim_task();
+            usleep(1000);
+        }
+        if (measure_fd >= 0) {
+            read_evdev(measure_fd);
+        }
+        if (socket_path) {
+            unlink(socket_path);
+        }
+    }
+
+    if (opts.measure) {
+        print_latency_stats();
+    }
+    uhid_backend_close();
+    return 0;
+}
@@ -0,0 +1,1002 @@
+// Split keyboard stress bench (built by tools/split_stress.py)
+// Runs the two halves of the Cleo as two processes in lockstep virtual time:
+// the master scans the left half and runs the keymap through the QMK shim,
+// the slave only scans and debounces the right half. They are joined by a
+// simulated full duplex USART link (SOCK_SEQPACKET socket pair) with a
+// one-way latency and random bit errors. A third process replays the same
+// script straight into the keymap at the physical edge times (no scan, no
+// debounce, no link) as the reference for the HID report stream.
+//
+// Checks:
+//   - every physical edge becomes exactly one matrix event on the master
+//     (dropped / phantom), and events arrive in physical order
+//   - the HID key stream matches the reference (missing / extra / reordered)
+// Edges closer than the order window (default DEBOUNCE) count as
+// simultaneous: no scanned, debounced matrix can order them.
+//
+// Latency per event: edge -> matrix event (scan, debounce, link), edge ->
+// HID report, and HID report delay against the reference. With -u the host
+// side is modelled too: SOF every 1 ms, the keyboard endpoint polled right
+// after it, one report per poll; -a holds the master's scans to the slot
+// before the poll (usb_sof.c) to compare against the free-running loop.
+// -k adds the key timestamp sync of key_timestamps.c to the link.
+//
+// Usage: split_sim [options] -s script.txt   (see usage() or sim/README.md)
+
+#include "qmk_shim.h"
+#include "sim.h"
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define HALF_ROWS (MATRIX_ROWS / 2)
+#define SETTLE_MS 1000  // Idle time after the script (tapping / oneshot timeouts)
+
+// QMK split transport defaults (serial_usart.c, split_util.c, transactions.c)
+#ifndef SERIAL_USART_TIMEOUT
+#define SERIAL_USART_TIMEOUT 20  // ms without an answer = failed transaction
+#endif
+#ifndef ERROR_DISCONNECT_COUNT
+#define ERROR_DISCONNECT_COUNT 5  // Failed scans before the other half counts as gone
+#endif
+#define TRANSACTION_RETRIES 10      // Attempts per scan while connected
+#define TRANSACTION_GET_MATRIX 0x01 // Request byte for the slave matrix
+#define PREFETCH_AGE_US 1000        // SERIAL_DMA_PREFETCH_AGE_US (serial_dma.c)
+
+// USB full speed host (-u) and SOF aligned scans (-a, usb_sof.h)
+#define USB_FRAME_US 1000   // USB_SOF_FRAME_US
+#define USB_POLL_US 20      // SOF -> IN token for the keyboard endpoint
+
+static struct {
+    uint32_t latency_us;  // One way
+    double ber;           // Bit error rate on the wire
+    uint32_t baud;
+    uint32_t scan_us;     // Main loop time besides the transaction
+    uint32_t debounce_us;
+    uint32_t window_us;   // Order window
+    uint32_t gate_us;     // Fail when a p99 latency exceeds this (0 = off)
+    uint32_t repeat;
+    uint64_t seed;
+    uint32_t lead_us;     // Scan slot before the SOF (-a), 0 = free-running
+    bool pipelined;
+    bool key_sync;
+    bool usb;
+    bool verbose;
+} opts = {
+    .baud = SERIAL_USART_SPEED,
+    .scan_us = 250,
+    .debounce_us = DEBOUNCE * 1000,
+    .window_us = DEBOUNCE * 1000,
+    .repeat = 1,
+    .seed = 1,
+};
+
+static uint64_t now_us = 0;  // Clock of the half running in this process
+
+// ============================================================================
+// SCRIPT (physical edges)
+// ============================================================================
+
+typedef struct {
+    uint64_t time_us;
+    uint8_t row;
+    uint8_t col;
+    bool pressed;
+    uint64_t event_us;  // Matrix event on the master, 0 = never
+    int32_t next;       // Next edge of the same key, -1 = none
+} edge_t;
+
+static edge_t *edges = NULL;
+static uint32_t edge_count = 0;
+
+// <delay_ms> <row> <col> <d|u>, '#' starts a comment (same as sim_main.c)
+static bool load_script(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return false;
+    }
+    edge_t *script = NULL;
+    uint32_t len = 0, capacity = 0, line_number = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        line_number++;
+        char *comment = strchr(line, '#');
+        if (comment) {
+            *comment = '\0';
+        }
+        if (strspn(line, " \t\r\n") == strlen(line)) {
+            continue;
+        }
+        unsigned delay, row, col;
+        char action;
+        if (sscanf(line, "%u %u %u %c", &delay, &row, &col, &action) != 4 || (action != 'd' && action != 'u') ||
+            row >= MATRIX_ROWS || col >= MATRIX_COLS) {
+            fprintf(stderr, "%s:%u: expected <delay_ms> <row> <col> <d|u>\n", path, line_number);
+            fclose(f);
+            return false;
+        }
+        if (len == capacity) {
+            capacity = capacity ? capacity * 2 : 256;
+            script = realloc(script, capacity * sizeof(*script));
+        }
+        script[len++] = (edge_t){.time_us = delay * 1000ull, .row = row, .col = col, .pressed = action == 'd'};
+    }
+    fclose(f);
+    if (len == 0) {
+        fprintf(stderr, "%s: no events\n", path);
+        return false;
+    }
+
+    // Repeats are separated by SETTLE_MS so each starts from a quiet keyboard
+    edges = calloc((size_t)len * opts.repeat, sizeof(*edges));
+    uint64_t time = SETTLE_MS * 1000ull;
+    for (uint32_t r = 0; r < opts.repeat; r++) {
+        for (uint32_t i = 0; i < len; i++) {
+            time += script[i].time_us;
+            edges[edge_count] = script[i];
+            edges[edge_count].time_us = time;
+            edge_count++;
+        }
+        time += SETTLE_MS * 1000ull;
+    }
+    free(script);
+
+    int32_t last[MATRIX_ROWS * MATRIX_COLS];
+    memset(last, 0xFF, sizeof(last));
+    for (uint32_t i = 0; i < edge_count; i++) {
+        uint8_t key = edges[i].row * MATRIX_COLS + edges[i].col;
+        edges[i].next = -1;
+        if (last[key] >= 0) {
+            edges[last[key]].next = i;
+        }
+        last[key] = i;
+    }
+    return true;
+}
+
+// ============================================================================
+// HALF MATRIX (pins + sym_defer_g debounce, QMK's default)
+// ============================================================================
+
+typedef struct {
+    uint8_t first_row;
+    uint32_t next_edge;           // First edge not applied to the pins yet
+    uint8_t pins[HALF_ROWS];      // Raw state, bit per column
+    uint8_t last_raw[HALF_ROWS];  // Raw state at the previous scan
+    uint8_t cooked[HALF_ROWS];    // Debounced state
+    uint64_t changed_us;
+    bool settling;
+    uint64_t clock_us;  // Last scan (slave)
+} half_t;
+
+static void half_init(half_t *half, uint8_t first_row) {
+    memset(half, 0, sizeof(*half));
+    half->first_row = first_row;
+}
+
+// One matrix scan at `time`: any raw change restarts the global debounce
+// timer, the debounced state follows once the raw state held DEBOUNCE
+static void half_scan(half_t *half, uint64_t time) {
+    for (; half->next_edge < edge_count && edges[half->next_edge].time_us <= time; half->next_edge++) {
+        const edge_t *edge = &edges[half->next_edge];
+        if (edge->row < half->first_row || edge->row >= half->first_row + HALF_ROWS) {
+            continue;
+        }
+        uint8_t *row = &half->pins[edge->row - half->first_row];
+        *row = edge->pressed ? (*row | 1 << edge->col) : (*row & ~(1 << edge->col));
+    }
+
+    if (memcmp(half->pins, half->last_raw, HALF_ROWS) != 0) {
+        memcpy(half->last_raw, half->pins, HALF_ROWS);
+        half->changed_us = time;
+        half->settling = true;
+    } else if (half->settling && time - half->changed_us >= opts.debounce_us) {
+        memcpy(half->cooked, half->pins, HALF_ROWS);
+        half->settling = false;
+    }
+}
+
+// Slave main loop: scans back to back until `time`
+static void half_scan_until(half_t *half, uint64_t time) {
+    while (half->clock_us + opts.scan_us <= time) {
+        half->clock_us += opts.scan_us;
+        half_scan(half, half->clock_us);
+    }
+}
+
+// ============================================================================
+// LINK (full duplex USART, 8N1)
+// ============================================================================
+// Only the wire bytes can be corrupted; time_us and flipped are simulator
+// metadata that keep the two processes in lockstep.
+
+typedef struct {
+    uint64_t time_us;  // Request: arrival time at the slave
+    uint8_t flipped;   // Bits corrupted by the sender's side of the link
+    uint8_t len;       // Reply: 0 = no answer
+    uint8_t data[HALF_ROWS + 1];
+} link_msg_t;
+
+static struct {
+    uint32_t transactions;
+    uint32_t crc_errors;
+    uint32_t timeouts;
+    uint32_t failed_scans;  // All retries failed: the other half reads as released
+    uint32_t disconnects;
+    uint32_t flipped;
+    uint32_t pipelined;  // Matrix reads served by a request sent the scan before
+    uint32_t waits;      // ... whose reply was still on the wire
+    uint32_t syncs;      // Key timestamp RPCs (-k)
+} link_stats;
+
+static uint64_t rng_state;
+
+static double rng_uniform(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (rng_state >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static void link_corrupt(link_msg_t *msg) {
+    if (opts.ber <= 0) {
+        return;
+    }
+    for (uint8_t i = 0; i < msg->len; i++) {
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            if (rng_uniform() < opts.ber) {
+                msg->data[i] ^= 1 << bit;
+                msg->flipped++;
+            }
+        }
+    }
+}
+
+static uint32_t link_bytes_us(uint8_t bytes) {
+    return (uint32_t)((bytes * 10ull * 1000000 + opts.baud - 1) / opts.baud);
+}
+
+// Same polynomial and seed as QMK's crc8()
+static uint8_t crc8(const uint8_t *data, uint8_t len) {
+    uint8_t crc = 0xFF;
+    for (uint8_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)(crc << 1) ^ 0x31 : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// ============================================================================
+// USB HOST (-u)
+// ============================================================================
+// Script delays are whole milliseconds, which would put every edge at the
+// same phase of the USB frame. USB runs move each edge by a random fraction
+// of a frame (own seed, order kept), the reference run included.
+
+static void usb_phase_edges(void) {
+    uint64_t saved = rng_state, previous = 0;
+    rng_state = opts.seed * 2 + 3;
+    for (uint32_t i = 0; i < edge_count; i++) {
+        uint64_t time = edges[i].time_us + (uint64_t)(rng_uniform() * USB_FRAME_US);
+        edges[i].time_us = previous = time > previous ? time : previous;
+    }
+    rng_state = saved;
+}
+
+// First poll of the keyboard endpoint at or after `time`
+static uint64_t usb_poll_after(uint64_t time) {
+    if (time <= USB_POLL_US) {
+        return USB_POLL_US;
+    }
+    return (time - USB_POLL_US + USB_FRAME_US - 1) / USB_FRAME_US * USB_FRAME_US + USB_POLL_US;
+}
+
+// First scan slot (USB_FRAME_US - lead after a SOF) at or after `time`
+static uint64_t usb_next_slot(uint64_t time) {
+    return (time + opts.lead_us + USB_FRAME_US - 1) / USB_FRAME_US * USB_FRAME_US - opts.lead_us;
+}
+
+// ============================================================================
+// SLAVE PROCESS
+// ============================================================================
+
+static void run_slave(int fd) {
+    half_t right;
+    half_init(&right, HALF_ROWS);
+    rng_state = opts.seed * 2 + 1;
+
+    link_msg_t request;
+    while (recv(fd, &request, sizeof(request), 0) == sizeof(request)) {
+        half_scan_until(&right, request.time_us);
+
+        link_msg_t reply = {0};
+        if (request.len == 1 && request.data[0] == TRANSACTION_GET_MATRIX) {
+            memcpy(reply.data, right.cooked, HALF_ROWS);
+            reply.data[HALF_ROWS] = crc8(right.cooked, HALF_ROWS);
+            reply.len = HALF_ROWS + 1;
+            link_corrupt(&reply);
+        }
+        if (send(fd, &reply, sizeof(reply), 0) != sizeof(reply)) {
+            break;
+        }
+    }
+    _exit(0);
+}
+
+// ============================================================================
+// REPORTS
+// ============================================================================
+
+typedef struct {
+    uint64_t time_us;
+    int32_t cause;  // Edge of the latest matrix event, -1 = none yet
+    uint8_t data[SIM_KEYBOARD_REPORT_SIZE];
+} report_t;
+
+static report_t *reports = NULL;  // Master run
+static uint32_t report_count = 0, report_capacity = 0;
+static int32_t cause = -1;
+static int report_fd = -1;  // Reference process: reports go to the parent
+
+static void on_keyboard(const uint8_t data[SIM_KEYBOARD_REPORT_SIZE]) {
+    // Blocking waits in the keymap (tap_code) move the shim clock past ours
+    uint64_t shim_us = sim_now() * 1000ull;
+    report_t report = {.time_us = shim_us > now_us ? shim_us : now_us, .cause = cause};
+    memcpy(report.data, data, SIM_KEYBOARD_REPORT_SIZE);
+
+    if (report_fd >= 0) {
+        if (write(report_fd, &report, sizeof(report)) != sizeof(report)) {
+            _exit(1);
+        }
+        return;
+    }
+    if (report_count == report_capacity) {
+        report_capacity = report_capacity ? report_capacity * 2 : 1024;
+        reports = realloc(reports, report_capacity * sizeof(*reports));
+    }
+    reports[report_count++] = report;
+}
+
+static const sim_host_t host = {.keyboard = on_keyboard};
+
+// Advance the shim clock (and its 1 ms tasks) to ours
+static void sync_shim_clock(void) {
+    uint32_t ms = now_us / 1000;
+    if (ms > sim_now()) {
+        sim_advance(ms - sim_now());
+    }
+}
+
+// ============================================================================
+// REFERENCE PROCESS
+// ============================================================================
+
+static void run_reference(int fd) {
+    report_fd = fd;
+    sim_init(&host, true);
+    for (uint32_t i = 0; i < edge_count; i++) {
+        now_us = edges[i].time_us;
+        sync_shim_clock();
+        cause = i;
+        sim_key_event(edges[i].row, edges[i].col, edges[i].pressed);
+    }
+    sim_advance(SETTLE_MS);
+    close(fd);
+    _exit(0);
+}
+
+static report_t *reference = NULL;
+static uint32_t reference_count = 0;
+
+static bool collect_reference(void) {
+    int fds[2];
+    if (pipe(fds) < 0) {
+        perror("pipe");
+        return false;
+    }
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        run_reference(fds[1]);
+    }
+    close(fds[1]);
+
+    uint32_t capacity = 0;
+    report_t report;
+    while (read(fds[0], &report, sizeof(report)) == sizeof(report)) {
+        if (reference_count == capacity) {
+            capacity = capacity ? capacity * 2 : 1024;
+            reference = realloc(reference, capacity * sizeof(*reference));
+        }
+        reference[reference_count++] = report;
+    }
+    close(fds[0]);
+
+    int status;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+// ============================================================================
+// MASTER (this process)
+// ============================================================================
+
+static int32_t key_head[MATRIX_ROWS * MATRIX_COLS];  // Oldest unmatched edge per key
+static uint32_t phantom_events = 0;
+static uint32_t simultaneous_events = 0;  // Out of order within the window
+static uint32_t reordered_events = 0;
+static uint32_t stalled_events = 0;       // Out of order behind a link timeout
+static uint64_t latest_delivered_us = 0;  // Latest physical time delivered so far
+static uint64_t timeout_end_us = 0;       // End of the latest link timeout
+
+// Matrix event -> latest physical edge of that key in the same direction.
+// Edges skipped on the way (a press and release between two debounced
+// scans) are never delivered.
+static int32_t match_edge(uint8_t row, uint8_t col, bool pressed) {
+    uint8_t key = row * MATRIX_COLS + col;
+    int32_t match = -1;
+    for (int32_t i = key_head[key]; i >= 0 && edges[i].time_us <= now_us; i = edges[i].next) {
+        if (edges[i].pressed == pressed) {
+            match = i;
+        }
+    }
+    if (match >= 0) {
+        key_head[key] = edges[match].next;
+    }
+    return match;
+}
+
+static void deliver(uint8_t row, uint8_t col, bool pressed) {
+    int32_t edge = match_edge(row, col, pressed);
+    if (edge < 0) {
+        phantom_events++;
+        if (opts.verbose) {
+            printf("%10.3f phantom %u,%u %s\n", now_us / 1000.0, row, col, pressed ? "down" : "up");
+        }
+    } else {
+        edges[edge].event_us = now_us;
+        if (edges[edge].time_us < latest_delivered_us) {
+            if (latest_delivered_us - edges[edge].time_us <= opts.window_us) {
+                simultaneous_events++;
+            } else if (timeout_end_us > edges[edge].time_us && timeout_end_us <= now_us) {
+                // The loop was blocked on the link after this edge: its half
+                // was scanned before the timeout, the other after (README)
+                stalled_events++;
+            } else {
+                reordered_events++;
+                if (opts.verbose) {
+                    printf("%10.3f out of order %u,%u (edge %.3f)\n", now_us / 1000.0, row, col,
+                           edges[edge].time_us / 1000.0);
+                }
+            }
+        } else {
+            latest_delivered_us = edges[edge].time_us;
+        }
+        cause = edge;
+    }
+    sim_key_event(row, col, pressed);
+}
+
+// One GET_SLAVE_MATRIX exchange sent at `start`. Returns when the master
+// has the reply (or gave up on it); rows are only valid when *ok.
+static uint64_t exchange(int fd, uint64_t start, uint8_t rows[HALF_ROWS], bool *ok) {
+    link_stats.transactions++;
+    link_msg_t request = {.len = 1, .data = {TRANSACTION_GET_MATRIX}};
+    link_corrupt(&request);
+    request.time_us = start + link_bytes_us(request.len) + opts.latency_us;
+
+    link_msg_t reply;
+    if (send(fd, &request, sizeof(request), 0) != sizeof(request) ||
+        recv(fd, &reply, sizeof(reply), 0) != sizeof(reply)) {
+        fprintf(stderr, "slave process gone\n");
+        exit(1);
+    }
+    link_stats.flipped += request.flipped + reply.flipped;
+
+    *ok = false;
+    uint64_t done = request.time_us + link_bytes_us(reply.len) + opts.latency_us;
+    if (reply.len == 0 || done - start > SERIAL_USART_TIMEOUT * 1000ull) {
+        link_stats.timeouts++;
+        timeout_end_us = start + SERIAL_USART_TIMEOUT * 1000ull;
+        return timeout_end_us;
+    }
+    if (crc8(reply.data, HALF_ROWS) != reply.data[HALF_ROWS]) {
+        link_stats.crc_errors++;
+        return done;
+    }
+    memcpy(rows, reply.data, HALF_ROWS);
+    *ok = true;
+    return done;
+}
+
+// GET_SLAVE_MATRIX with QMK's retry policy: up to 10 attempts, backing off
+// 10 us x attempt^2, each bounded by SERIAL_USART_TIMEOUT
+static bool transaction(int fd, uint8_t rows[HALF_ROWS]) {
+    for (uint32_t attempt = 1; attempt <= TRANSACTION_RETRIES; attempt++) {
+        if (attempt > 1) {
+            now_us += 10 * attempt * attempt;
+        }
+        bool ok;
+        now_us = exchange(fd, now_us, rows, &ok);
+        if (ok) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Pipelined transport (-p, serial_dma.c): the request for the next scan's
+// matrix goes out right after this scan's transport and is answered while
+// the master runs the keymap and its next scan. Off when aligned (-a), as
+// in serial_dma.c: the reply would be a frame old.
+static struct {
+    bool pending;
+    bool ok;
+    uint64_t sent_us;
+    uint64_t done_us;
+    uint8_t rows[HALF_ROWS];
+} prefetch;
+
+static void prefetch_send(int fd) {
+    prefetch.pending = true;
+    prefetch.sent_us = now_us;
+    prefetch.done_us = exchange(fd, now_us, prefetch.rows, &prefetch.ok);
+}
+
+// A fresh, good reply in flight serves the scan (waiting for the rest of
+// it if needed), anything else falls back to a blocking transaction
+static bool prefetch_transaction(int fd, uint8_t rows[HALF_ROWS]) {
+    if (!prefetch.pending) {
+        return transaction(fd, rows);
+    }
+    prefetch.pending = false;
+    bool fresh = now_us - prefetch.sent_us < PREFETCH_AGE_US;
+    if (prefetch.done_us > now_us) {
+        link_stats.waits += fresh && prefetch.ok;
+        now_us = prefetch.done_us;
+    }
+    if (!fresh || !prefetch.ok) {
+        return transaction(fd, rows);
+    }
+    link_stats.pipelined++;
+    memcpy(rows, prefetch.rows, HALF_ROWS);
+    return true;
+}
+
+// Key timestamp sync (-k, key_timestamps.c): a scan whose slave rows
+// changed runs transaction_rpc_exec before its events, as three
+// transactions each opened by the ID and the slave's handshake byte:
+// PUT_RPC_INFO, PUT_RPC_REQUEST (the changed key mask) and GET_RPC_RESP
+// (an age per changed key). A matrix request still in flight (-p) is
+// collected first. Timing only: the shim keymap times events at the scan.
+#define SYNC_INFO_BYTES 4   // rpc_sync_info_t
+#define SYNC_MASK_BYTES 4   // Changed keys, uint32_t
+#define SYNC_REPLY_BYTES 8  // KEY_TIMESTAMPS_SYNC_MAX_KEYS
+
+static uint64_t key_sync(uint64_t start) {
+    uint64_t handshake = link_bytes_us(1) + opts.latency_us + link_bytes_us(1) + opts.latency_us;
+    if (prefetch.pending && prefetch.done_us > start) {
+        start = prefetch.done_us;
+    }
+    link_stats.syncs++;
+    return start + handshake + link_bytes_us(SYNC_INFO_BYTES) + handshake + link_bytes_us(SYNC_MASK_BYTES) +
+           link_bytes_us(1) + opts.latency_us + link_bytes_us(1 + SYNC_REPLY_BYTES) + opts.latency_us;
+}
+
+static void run_master(int fd) {
+    half_t left;
+    half_init(&left, 0);
+    uint8_t matrix[MATRIX_ROWS] = {0}, slave_rows[HALF_ROWS] = {0}, synced_rows[HALF_ROWS] = {0};
+    uint8_t error_count = 0;
+    uint64_t next_check_us = 0;
+    bool connected = true;
+
+    for (uint32_t key = 0; key < MATRIX_ROWS * MATRIX_COLS; key++) {
+        key_head[key] = -1;
+    }
+    for (int32_t i = edge_count - 1; i >= 0; i--) {
+        key_head[edges[i].row * MATRIX_COLS + edges[i].col] = i;
+    }
+
+    rng_state = opts.seed * 2;
+    sim_init(&host, true);
+    uint64_t end_us = edges[edge_count - 1].time_us + SETTLE_MS * 1000ull;
+
+    while (now_us < end_us) {
+        half_scan(&left, now_us);
+
+        // Split transport (matrix_post_scan): a failed scan clears the other
+        // half, too many in a row only retry every SPLIT_CONNECTION_CHECK_TIMEOUT
+        if (connected || now_us >= next_check_us) {
+            if (opts.pipelined ? prefetch_transaction(fd, slave_rows) : transaction(fd, slave_rows)) {
+                error_count = 0;
+                connected = true;
+            } else {
+                link_stats.failed_scans++;
+                memset(slave_rows, 0, sizeof(slave_rows));
+                if (connected && ++error_count > ERROR_DISCONNECT_COUNT) {
+                    connected = false;
+                    link_stats.disconnects++;
+                }
+                next_check_us = now_us + SPLIT_CONNECTION_CHECK_TIMEOUT * 1000ull;
+            }
+            if (opts.pipelined && !opts.lead_us) {
+                prefetch_send(fd);
+            }
+        }
+
+        // matrix_scan_user: the slave's edge ages for the keys that changed
+        if (opts.key_sync && memcmp(slave_rows, synced_rows, HALF_ROWS) != 0) {
+            memcpy(synced_rows, slave_rows, HALF_ROWS);
+            if (connected) {
+                now_us = key_sync(now_us);
+            }
+        }
+
+        // keyboard_task: one event per changed key, row by row
+        sync_shim_clock();
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            uint8_t state = row < HALF_ROWS ? left.cooked[row] : slave_rows[row - HALF_ROWS];
+            uint8_t changes = state ^ matrix[row];
+            for (uint8_t col = 0; changes && col < MATRIX_COLS; col++) {
+                if (changes & (1 << col)) {
+                    matrix[row] ^= 1 << col;
+                    deliver(row, col, state & (1 << col));
+                }
+            }
+        }
+        if (sim_now() * 1000ull > now_us) {
+            now_us = sim_now() * 1000ull;
+        }
+        now_us += opts.scan_us;
+
+        // SOF aligned (-a): the rest of the frame is left to RGB and housekeeping
+        if (opts.lead_us) {
+            now_us = usb_next_slot(now_us);
+        }
+    }
+    close(fd);
+}
+
+// ============================================================================
+// KEY STREAM COMPARISON
+// ============================================================================
+// Reports become key tokens (usage down/up, modifiers as 0xE0 + bit). Both
+// runs must produce the same tokens; key downs must come in the same order,
+// except for swaps between edges inside the order window.
+
+typedef struct {
+    uint64_t time_us;
+    int32_t cause;
+    uint8_t usage;
+    bool down;
+    bool used;
+    bool counted;  // Already reported as out of order
+} token_t;
+
+static uint32_t tokenize(const report_t *list, uint32_t count, token_t **out) {
+    token_t *tokens = malloc((count * 14 + 1) * sizeof(*tokens));
+    uint32_t n = 0;
+    uint8_t previous[SIM_KEYBOARD_REPORT_SIZE] = {0};
+
+    for (uint32_t i = 0; i < count; i++) {
+        const uint8_t *data = list[i].data;
+        token_t token = {.time_us = list[i].time_us, .cause = list[i].cause};
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            if ((data[0] ^ previous[0]) & (1 << bit)) {
+                token.usage = KC_LEFT_CTRL + bit;
+                token.down = data[0] & (1 << bit);
+                tokens[n++] = token;
+            }
+        }
+        for (uint8_t pass = 0; pass < 2; pass++) {
+            const uint8_t *keys = pass ? &previous[2] : &data[2];
+            const uint8_t *other = pass ? &data[2] : &previous[2];
+            for (uint8_t k = 0; k < 6; k++) {
+                if (keys[k] && !memchr(other, keys[k], 6)) {
+                    token.usage = keys[k];
+                    token.down = !pass;
+                    tokens[n++] = token;
+                }
+            }
+        }
+        memcpy(previous, data, sizeof(previous));
+    }
+    *out = tokens;
+    return n;
+}
+
+static struct {
+    uint32_t missing;
+    uint32_t extra;
+    uint32_t swapped;    // Within the order window
+    uint32_t reordered;
+} keys;
+
+static bool in_window(const token_t *a, const token_t *b) {
+    if (a->cause < 0 || b->cause < 0) {
+        return false;
+    }
+    uint64_t ta = edges[a->cause].time_us, tb = edges[b->cause].time_us;
+    return (ta > tb ? ta - tb : tb - ta) <= opts.window_us;
+}
+
+// Fills delay[] with the report delay of each matched key down
+static uint32_t compare_keys(uint32_t *delay) {
+    token_t *ref, *run;
+    uint32_t ref_count = tokenize(reference, reference_count, &ref);
+    uint32_t run_count = tokenize(reports, report_count, &run);
+    uint32_t matched = 0;
+
+    int32_t balance[2][256] = {{0}};
+    for (uint32_t i = 0; i < ref_count; i++) {
+        balance[ref[i].down][ref[i].usage]++;
+    }
+    for (uint32_t i = 0; i < run_count; i++) {
+        balance[run[i].down][run[i].usage]--;
+    }
+    for (uint8_t down = 0; down < 2; down++) {
+        for (uint16_t usage = 0; usage < 256; usage++) {
+            if (balance[down][usage] > 0) {
+                keys.missing += balance[down][usage];
+            } else {
+                keys.extra -= balance[down][usage];
+            }
+        }
+    }
+
+    uint32_t first = 0;  // First unused key down of the run
+    for (uint32_t i = 0; i < ref_count; i++) {
+        if (!ref[i].down) {
+            continue;
+        }
+        while (first < run_count && (run[first].used || !run[first].down)) {
+            first++;
+        }
+        // Look no further than SETTLE_MS ahead, a later key is another press
+        uint32_t m = first;
+        while (m < run_count && run[m].time_us <= ref[i].time_us + SETTLE_MS * 1000ull &&
+               (run[m].used || !run[m].down || run[m].usage != ref[i].usage)) {
+            m++;
+        }
+        if (m == run_count || run[m].time_us > ref[i].time_us + SETTLE_MS * 1000ull) {
+            continue;  // Counted as missing
+        }
+        for (uint32_t j = first; j < m; j++) {
+            if (run[j].down && !run[j].used && !run[j].counted) {
+                run[j].counted = true;
+                if (in_window(&run[j], &run[m])) {
+                    keys.swapped++;
+                } else {
+                    keys.reordered++;
+                    if (opts.verbose) {
+                        printf("key %02x at %.3f ms comes before %02x (reference %.3f ms)\n", run[j].usage,
+                               run[j].time_us / 1000.0, run[m].usage, ref[i].time_us / 1000.0);
+                    }
+                }
+            }
+        }
+        run[m].used = true;
+        delay[matched++] = run[m].time_us > ref[i].time_us ? run[m].time_us - ref[i].time_us : 0;
+    }
+    free(ref);
+    free(run);
+    return matched;
+}
+
+// ============================================================================
+// LATENCY STATISTICS
+// ============================================================================
+
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Prints mean/p50/p99/max and returns p99 (0 without samples)
+static uint32_t print_latency(const char *label, uint32_t *samples, uint32_t count) {
+    if (count == 0) {
+        printf("%-22s no samples\n", label);
+        return 0;
+    }
+    uint64_t sum = 0;
+    qsort(samples, count, sizeof(*samples), compare_u32);
+    for (uint32_t i = 0; i < count; i++) {
+        sum += samples[i];
+    }
+    uint32_t p99 = samples[(uint64_t)count * 99 / 100];
+    printf("%-22s mean %6llu us  p50 %6u us  p99 %6u us  max %6u us  (%u)\n", label,
+           (unsigned long long)(sum / count), samples[count / 2], p99, samples[count - 1], count);
+    return p99;
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+static void usage(const char *argv0) {
+    fprintf(stderr,
+            "usage: %s [options] -s script.txt\n"
+            "  -s, --script FILE     <delay_ms> <row> <col> <d|u> lines (as for seniply-sim)\n"
+            "  -r, --repeat N        replay the script N times\n"
+            "  -l, --latency US      one-way link latency (default 0)\n"
+            "  -e, --ber RATE        bit error rate on the link, e.g. 1e-4 (default 0)\n"
+            "  -b, --baud N          link speed (default SERIAL_USART_SPEED)\n"
+            "  -c, --scan US         main loop time besides the transaction (default 250)\n"
+            "  -d, --debounce MS     sym_defer_g debounce time (default DEBOUNCE)\n"
+            "  -w, --window US       edges closer than this are simultaneous (default DEBOUNCE)\n"
+            "  -g, --gate US         fail when a p99 latency exceeds US\n"
+            "  -S, --seed N          bit error seed\n"
+            "  -p, --pipelined       request the next scan's matrix ahead (serial_dma.c)\n"
+            "  -k, --key-sync        fetch edge ages when the slave rows change (key_timestamps.c)\n"
+            "  -u, --usb             model the host: SOF every 1 ms, one report per poll\n"
+            "  -a, --aligned US      scan US before each SOF (usb_sof.c), implies -u\n"
+            "  -v, --verbose         print reports and each ordering problem\n",
+            argv0);
+}
+
+int main(int argc, char **argv) {
+    static const struct option long_options[] = {
+        {"script", required_argument, 0, 's'},  {"repeat", required_argument, 0, 'r'},
+        {"latency", required_argument, 0, 'l'}, {"ber", required_argument, 0, 'e'},
+        {"baud", required_argument, 0, 'b'},    {"scan", required_argument, 0, 'c'},
+        {"debounce", required_argument, 0, 'd'}, {"window", required_argument, 0, 'w'},
+        {"gate", required_argument, 0, 'g'},    {"seed", required_argument, 0, 'S'},
+        {"pipelined", no_argument, 0, 'p'},     {"key-sync", no_argument, 0, 'k'},
+        {"usb", no_argument, 0, 'u'},
+        {"aligned", required_argument, 0, 'a'}, {"verbose", no_argument, 0, 'v'},
+        {0, 0, 0, 0},
+    };
+    const char *script_path = NULL;
+    int opt;
+
+    while ((opt = getopt_long(argc, argv, "s:r:l:e:b:c:d:w:g:S:pkua:v", long_options, NULL)) != -1) {
+        switch (opt) {
+        case 's': script_path = optarg; break;
+        case 'r': opts.repeat = strtoul(optarg, NULL, 0); break;
+        case 'l': opts.latency_us = strtoul(optarg, NULL, 0); break;
+        case 'e': opts.ber = strtod(optarg, NULL); break;
+        case 'b': opts.baud = strtoul(optarg, NULL, 0); break;
+        case 'c': opts.scan_us = strtoul(optarg, NULL, 0); break;
+        case 'd': opts.debounce_us = strtoul(optarg, NULL, 0) * 1000; break;
+        case 'w': opts.window_us = strtoul(optarg, NULL, 0); break;
+        case 'g': opts.gate_us = strtoul(optarg, NULL, 0); break;
+        case 'S': opts.seed = strtoull(optarg, NULL, 0); break;
+        case 'p': opts.pipelined = true; break;
+        case 'k': opts.key_sync = true; break;
+        case 'u': opts.usb = true; break;
+        case 'a': opts.lead_us = strtoul(optarg, NULL, 0); opts.usb = true; break;
+        case 'v': opts.verbose = true; break;
+        default: usage(argv[0]); return 2;
+        }
+    }
+    if (!script_path || opts.repeat == 0 || opts.baud == 0 || opts.scan_us == 0 ||
+        opts.lead_us >= USB_FRAME_US) {
+        usage(argv[0]);
+        return 2;
+    }
+    if (!load_script(script_path)) {
+        return 2;
+    }
+    if (opts.usb) {
+        usb_phase_edges();
+    }
+
+    // Fork before the shim is initialised: each process starts from a clean keymap
+    if (!collect_reference()) {
+        fprintf(stderr, "reference run failed\n");
+        return 1;
+    }
+    int link[2];
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, link) < 0) {
+        perror("socketpair");
+        return 1;
+    }
+    pid_t slave = fork();
+    if (slave == 0) {
+        close(link[0]);
+        run_slave(link[1]);
+    }
+    close(link[1]);
+    run_master(link[0]);
+    waitpid(slave, NULL, 0);
+
+    if (opts.verbose) {
+        for (uint32_t i = 0; i < report_count; i++) {
+            printf("%10.3f kbd %02x |", reports[i].time_us / 1000.0, reports[i].data[0]);
+            for (uint8_t k = 2; k < SIM_KEYBOARD_REPORT_SIZE; k++) {
+                printf(" %02x", reports[i].data[k]);
+            }
+            printf("\n");
+        }
+    }
+
+    // Physical edges -> matrix events
+    uint32_t dropped = 0, count[2] = {0};
+    uint32_t *event_latency[2] = {malloc(edge_count * sizeof(uint32_t)), malloc(edge_count * sizeof(uint32_t))};
+    for (uint32_t i = 0; i < edge_count; i++) {
+        if (edges[i].event_us == 0) {
+            dropped++;
+            continue;
+        }
+        uint8_t half = edges[i].row >= HALF_ROWS;
+        event_latency[half][count[half]++] = edges[i].event_us - edges[i].time_us;
+    }
+
+    // Edge -> report, for reports caused by a matrix event
+    uint32_t *report_latency = malloc((report_count + 1) * sizeof(uint32_t));
+    uint32_t report_samples = 0;
+    for (uint32_t i = 0; i < report_count; i++) {
+        if (reports[i].cause >= 0 && (i == 0 || reports[i].cause != reports[i - 1].cause)) {
+            report_latency[report_samples++] = reports[i].time_us - edges[reports[i].cause].time_us;
+        }
+    }
+
+    // Host side (-u): edge -> poll that took the report, report -> that poll
+    uint32_t *host_latency = malloc((report_count + 1) * sizeof(uint32_t));
+    uint32_t *poll_wait = malloc((report_count + 1) * sizeof(uint32_t));
+    uint32_t host_samples = 0;
+    uint64_t poll = 0;
+    for (uint32_t i = 0; opts.usb && i < report_count; i++) {
+        uint64_t first = usb_poll_after(reports[i].time_us);
+        poll = i > 0 && poll + USB_FRAME_US > first ? poll + USB_FRAME_US : first;
+        poll_wait[i] = poll - reports[i].time_us;
+        if (reports[i].cause >= 0 && (i == 0 || reports[i].cause != reports[i - 1].cause)) {
+            host_latency[host_samples++] = poll - edges[reports[i].cause].time_us;
+        }
+    }
+    uint32_t *delay = malloc((reference_count * 14 + 1) * sizeof(uint32_t));
+    uint32_t delay_count = compare_keys(delay);
+
+    printf("%s x%u: %u edges, %.1f s\n", script_path, opts.repeat, edge_count, now_us / 1e6);
+    printf("link: %u baud, %u us latency, BER %g: %u transactions, %u bits flipped, %u crc errors, %u timeouts, "
+           "%u failed scans, %u disconnects\n",
+           opts.baud, opts.latency_us, opts.ber, link_stats.transactions, link_stats.flipped, link_stats.crc_errors,
+           link_stats.timeouts, link_stats.failed_scans, link_stats.disconnects);
+    if (opts.pipelined) {
+        printf("pipeline: %u matrix reads served ahead, %u waited for the reply\n", link_stats.pipelined,
+               link_stats.waits);
+    }
+    if (opts.key_sync) {
+        printf("key sync: %u edge age RPCs\n", link_stats.syncs);
+    }
+    if (opts.usb) {
+        if (opts.lead_us) {
+            printf("usb: scans aligned %u us before each SOF\n", opts.lead_us);
+        } else {
+            printf("usb: free-running scans\n");
+        }
+    }
+    printf("events: %u delivered, %u dropped, %u phantom, %u simultaneous, %u out of order, %u behind a timeout\n",
+           count[0] + count[1], dropped, phantom_events, simultaneous_events, reordered_events, stalled_events);
+    printf("keys: %u reports (reference %u), %u missing, %u extra, %u simultaneous, %u out of order\n", report_count,
+           reference_count, keys.missing, keys.extra, keys.swapped, keys.reordered);
+
+    uint32_t p99[4];
+    p99[0] = print_latency("edge -> event (left)", event_latency[0], count[0]);
+    p99[1] = print_latency("edge -> event (right)", event_latency[1], count[1]);
+    p99[2] = print_latency("edge -> report", report_latency, report_samples);
+    p99[3] = print_latency("report vs reference", delay, delay_count);
+    if (opts.usb) {
+        print_latency("report -> poll", poll_wait, report_count);
+        print_latency("edge -> host", host_latency, host_samples);
+    }
+
+    bool pass = dropped == 0 && phantom_events == 0 && reordered_events == 0 && keys.missing == 0 &&
+                keys.extra == 0 && keys.reordered == 0;
+    // Edge -> report includes intentional hold-back (layer-tap terms), so it is not gated
+    if (opts.gate_us && (p99[0] > opts.gate_us || p99[1] > opts.gate_us || p99[3] > opts.gate_us)) {
+        printf("p99 latency above the %u us gate\n", opts.gate_us);
+        pass = false;
+    }
+    printf("%s\n", pass ? "PASS" : "FAIL");
+    return pass ? 0 : 1;
+}
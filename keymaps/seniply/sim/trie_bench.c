@@ -0,0 +1,111 @@
+// Host benchmark for the trie.c matcher (built by tools/trie_bench.py)
+// Feeds a text file through trie_step() the way process_trie() does and
+// reports the flash size per entry and the cost of one keystroke.
+//
+// Usage: trie_bench <text file>
+
+#include "qmk_shim.h"
+#include "trie.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include TRIE_DATA_H
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CYCLES_UNIT "TSC cycles"
+static inline uint64_t cycles(void) {
+    return __rdtsc();
+}
+#else
+#define CYCLES_UNIT "ns"
+static inline uint64_t cycles(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+#endif
+
+// Keystroke symbols as process_trie() sees them
+static uint8_t symbol_for(char c) {
+    if (c >= 'a' && c <= 'z') {
+        return KC_A + (c - 'a');
+    }
+    if (c >= 'A' && c <= 'Z') {
+        return KC_A + (c - 'A');
+    }
+    return c == '\'' ? KC_QUOT : TRIE_BOUNDARY;
+}
+
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <text file>\n", argv[0]);
+        return 2;
+    }
+    FILE *f = fopen(argv[1], "rb");
+    if (!f) {
+        perror(argv[1]);
+        return 1;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t *symbols = malloc(size);
+    uint32_t *samples = malloc(size * sizeof(uint32_t));
+    for (long i = 0; i < size; i++) {
+        symbols[i] = symbol_for((char)fgetc(f));
+    }
+    fclose(f);
+
+    // Whole stream: mean cost without per-sample timer overhead
+    uint32_t matches = 0;
+    trie_node_t node = TRIE_ROOT;
+    uint64_t start = cycles();
+    for (long i = 0; i < size; i++) {
+        node = trie_step(node, symbols[i]);
+        if (trie_has_output(node)) {
+            matches++;
+            node = symbols[i] == TRIE_BOUNDARY ? trie_step(TRIE_ROOT, TRIE_BOUNDARY) : TRIE_ROOT;
+        }
+    }
+    uint64_t total = cycles() - start;
+
+    // Per keystroke: distribution, timer overhead subtracted
+    uint64_t overhead = UINT64_MAX;
+    for (int i = 0; i < 1000; i++) {
+        uint64_t t0 = cycles();
+        uint64_t t1 = cycles();
+        if (t1 - t0 < overhead) {
+            overhead = t1 - t0;
+        }
+    }
+    node = TRIE_ROOT;
+    for (long i = 0; i < size; i++) {
+        uint64_t t0 = cycles();
+        node = trie_step(node, symbols[i]);
+        bool hit = trie_has_output(node);
+        uint64_t t1 = cycles();
+        samples[i] = (t1 - t0 > overhead) ? (uint32_t)(t1 - t0 - overhead) : 0;
+        if (hit) {
+            node = symbols[i] == TRIE_BOUNDARY ? trie_step(TRIE_ROOT, TRIE_BOUNDARY) : TRIE_ROOT;
+        }
+    }
+    qsort(samples, size, sizeof(uint32_t), compare_u32);
+
+    printf("entries %u  nodes %u  bytes %u  bytes/entry %.1f  depth %u\n", TRIE_ENTRIES, TRIE_NODES,
+           TRIE_DATA_SIZE, (double)TRIE_DATA_SIZE / TRIE_ENTRIES, TRIE_MAX_DEPTH);
+    printf("keystrokes %ld  matches %u\n", size, matches);
+    printf("per keystroke (%s): mean %.1f  p50 %u  p99 %u  p99.9 %u  max %u\n", CYCLES_UNIT, (double)total / size,
+           samples[size / 2], samples[size * 99 / 100], samples[size * 999 / 1000], samples[size - 1]);
+
+    free(symbols);
+    free(samples);
+    return 0;
+}
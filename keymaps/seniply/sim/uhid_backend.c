@@ -0,0 +1,263 @@
+#include "uhid_backend.h"
+#include "sim.h"
+#include "raw_hid.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/input.h>
+#include <linux/uhid.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define CLEO_VENDOR_ID 0xFEEB
+#define CLEO_PRODUCT_ID 0x0000
+#define CLEO_DEVICE_VERSION 0x0100
+#define RAW_EPSIZE 32
+#define REPORT_ID_CONSUMER 3
+
+// ============================================================================
+// REPORT DESCRIPTORS (as in QMK's usb_descriptor.c)
+// ============================================================================
+
+// clang-format off
+static const uint8_t keyboard_descriptor[] = {
+    0x05, 0x01,        // Usage Page (Generic Desktop)
+    0x09, 0x06,        // Usage (Keyboard)
+    0xA1, 0x01,        // Collection (Application)
+    0x05, 0x07,        //   Usage Page (Keyboard/Keypad)
+    0x19, 0xE0,        //   Usage Minimum (Left Control)
+    0x29, 0xE7,        //   Usage Maximum (Right GUI)
+    0x15, 0x00,        //   Logical Minimum (0)
+    0x25, 0x01,        //   Logical Maximum (1)
+    0x95, 0x08,        //   Report Count (8)
+    0x75, 0x01,        //   Report Size (1)
+    0x81, 0x02,        //   Input (Data, Variable, Absolute) - modifiers
+    0x95, 0x01,        //   Report Count (1)
+    0x75, 0x08,        //   Report Size (8)
+    0x81, 0x01,        //   Input (Constant) - reserved
+    0x05, 0x07,        //   Usage Page (Keyboard/Keypad)
+    0x19, 0x00,        //   Usage Minimum (0)
+    0x2A, 0xFF, 0x00,  //   Usage Maximum (255)
+    0x15, 0x00,        //   Logical Minimum (0)
+    0x26, 0xFF, 0x00,  //   Logical Maximum (255)
+    0x95, 0x06,        //   Report Count (6)
+    0x75, 0x08,        //   Report Size (8)
+    0x81, 0x00,        //   Input (Data, Array, Absolute) - keys
+    0x05, 0x08,        //   Usage Page (LED)
+    0x19, 0x01,        //   Usage Minimum (Num Lock)
+    0x29, 0x05,        //   Usage Maximum (Kana)
+    0x95, 0x05,        //   Report Count (5)
+    0x75, 0x01,        //   Report Size (1)
+    0x91, 0x02,        //   Output (Data, Variable, Absolute) - LEDs
+    0x95, 0x01,        //   Report Count (1)
+    0x75, 0x03,        //   Report Size (3)
+    0x91, 0x01,        //   Output (Constant) - padding
+    0xC0,              // End Collection
+};
+
+static const uint8_t extrakeys_descriptor[] = {
+    0x05, 0x0C,        // Usage Page (Consumer)
+    0x09, 0x01,        // Usage (Consumer Control)
+    0xA1, 0x01,        // Collection (Application)
+    0x85, REPORT_ID_CONSUMER,
+    0x19, 0x01,        //   Usage Minimum (0x001)
+    0x2A, 0xA0, 0x02,  //   Usage Maximum (0x2A0)
+    0x15, 0x01,        //   Logical Minimum (0x001)
+    0x26, 0xA0, 0x02,  //   Logical Maximum (0x2A0)
+    0x95, 0x01,        //   Report Count (1)
+    0x75, 0x10,        //   Report Size (16)
+    0x81, 0x00,        //   Input (Data, Array, Absolute)
+    0xC0,              // End Collection
+};
+
+static const uint8_t raw_hid_descriptor[] = {
+    0x06, 0x60, 0xFF,  // Usage Page (Vendor 0xFF60)
+    0x09, 0x61,        // Usage (0x61)
+    0xA1, 0x01,        // Collection (Application)
+    0x09, 0x62,        //   Usage (Data In)
+    0x15, 0x00,        //   Logical Minimum (0)
+    0x26, 0xFF, 0x00,  //   Logical Maximum (255)
+    0x95, RAW_EPSIZE,  //   Report Count
+    0x75, 0x08,        //   Report Size (8)
+    0x81, 0x02,        //   Input (Data, Variable, Absolute)
+    0x09, 0x63,        //   Usage (Data Out)
+    0x15, 0x00,        //   Logical Minimum (0)
+    0x26, 0xFF, 0x00,  //   Logical Maximum (255)
+    0x95, RAW_EPSIZE,  //   Report Count
+    0x75, 0x08,        //   Report Size (8)
+    0x91, 0x02,        //   Output (Data, Variable, Absolute)
+    0xC0,              // End Collection
+};
+// clang-format on
+
+// ============================================================================
+// DEVICES
+// ============================================================================
+
+enum { DEV_KEYBOARD, DEV_EXTRAKEYS, DEV_RAW_HID };
+
+typedef struct {
+    const char *name;
+    const uint8_t *descriptor;
+    uint16_t descriptor_size;
+    uint8_t output_size;  // Expected output report size (0 = none)
+    int fd;
+} uhid_device_t;
+
+static uhid_device_t devices[UHID_BACKEND_DEVICES] = {
+    [DEV_KEYBOARD]  = {"splitted.space Cleo (sim)", keyboard_descriptor, sizeof(keyboard_descriptor), 1, -1},
+    [DEV_EXTRAKEYS] = {"splitted.space Cleo (sim) Extrakeys", extrakeys_descriptor, sizeof(extrakeys_descriptor), 0, -1},
+    [DEV_RAW_HID]   = {"splitted.space Cleo (sim) Raw HID", raw_hid_descriptor, sizeof(raw_hid_descriptor), RAW_EPSIZE, -1},
+};
+
+static bool uhid_write(int fd, const struct uhid_event *ev) {
+    ssize_t n = write(fd, ev, sizeof(*ev));
+    if (n != sizeof(*ev)) {
+        fprintf(stderr, "uhid: write failed: %s\n", n < 0 ? strerror(errno) : "short write");
+        return false;
+    }
+    return true;
+}
+
+static bool create_device(uhid_device_t *dev) {
+    dev->fd = open("/dev/uhid", O_RDWR | O_CLOEXEC | O_NONBLOCK);
+    if (dev->fd < 0) {
+        fprintf(stderr, "uhid: cannot open /dev/uhid: %s\n", strerror(errno));
+        return false;
+    }
+
+    struct uhid_event ev = {.type = UHID_CREATE2};
+    snprintf((char *)ev.u.create2.name, sizeof(ev.u.create2.name), "%s", dev->name);
+    snprintf((char *)ev.u.create2.phys, sizeof(ev.u.create2.phys), "seniply-sim/%d", (int)(dev - devices));
+    ev.u.create2.rd_size = dev->descriptor_size;
+    ev.u.create2.bus = BUS_USB;
+    ev.u.create2.vendor = CLEO_VENDOR_ID;
+    ev.u.create2.product = CLEO_PRODUCT_ID;
+    ev.u.create2.version = CLEO_DEVICE_VERSION;
+    memcpy(ev.u.create2.rd_data, dev->descriptor, dev->descriptor_size);
+    return uhid_write(dev->fd, &ev);
+}
+
+static void send_input(uhid_device_t *dev, const uint8_t *data, uint16_t size) {
+    if (dev->fd < 0) {
+        return;
+    }
+    struct uhid_event ev = {.type = UHID_INPUT2};
+    ev.u.input2.size = size;
+    memcpy(ev.u.input2.data, data, size);
+    uhid_write(dev->fd, &ev);
+}
+
+bool uhid_backend_open(void) {
+    for (uint8_t i = 0; i < UHID_BACKEND_DEVICES; i++) {
+        if (!create_device(&devices[i])) {
+            uhid_backend_close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void uhid_backend_close(void) {
+    for (uint8_t i = 0; i < UHID_BACKEND_DEVICES; i++) {
+        if (devices[i].fd >= 0) {
+            struct uhid_event ev = {.type = UHID_DESTROY};
+            uhid_write(devices[i].fd, &ev);
+            close(devices[i].fd);
+            devices[i].fd = -1;
+        }
+    }
+}
+
+uint8_t uhid_backend_fds(int fds[UHID_BACKEND_DEVICES]) {
+    for (uint8_t i = 0; i < UHID_BACKEND_DEVICES; i++) {
+        fds[i] = devices[i].fd;
+    }
+    return UHID_BACKEND_DEVICES;
+}
+
+const char *uhid_backend_keyboard_name(void) {
+    return devices[DEV_KEYBOARD].name;
+}
+
+// ============================================================================
+// HOST -> DEVICE
+// ============================================================================
+
+static void handle_output(uhid_device_t *dev, const uint8_t *data, uint16_t size) {
+    // hidraw passes unnumbered reports with a leading report ID 0
+    if (size > dev->output_size && data[0] == 0) {
+        data++;
+        size--;
+    }
+    if (size < dev->output_size) {
+        return;
+    }
+
+    if (dev == &devices[DEV_KEYBOARD]) {
+        sim_set_host_leds(data[0]);
+    } else if (dev == &devices[DEV_RAW_HID]) {
+        uint8_t buffer[RAW_EPSIZE];
+        memcpy(buffer, data, RAW_EPSIZE);
+        raw_hid_receive(buffer, RAW_EPSIZE);
+    }
+}
+
+void uhid_backend_handle(int fd) {
+    uhid_device_t *dev = NULL;
+    for (uint8_t i = 0; i < UHID_BACKEND_DEVICES; i++) {
+        if (devices[i].fd == fd) {
+            dev = &devices[i];
+        }
+    }
+    if (!dev) {
+        return;
+    }
+
+    struct uhid_event ev;
+    while (read(fd, &ev, sizeof(ev)) > 0) {
+        switch (ev.type) {
+        case UHID_OUTPUT:
+            handle_output(dev, ev.u.output.data, ev.u.output.size);
+            break;
+        case UHID_GET_REPORT: {
+            // No feature reports on any interface
+            struct uhid_event reply = {.type = UHID_GET_REPORT_REPLY};
+            reply.u.get_report_reply.id = ev.u.get_report.id;
+            reply.u.get_report_reply.err = EIO;
+            uhid_write(fd, &reply);
+            break;
+        }
+        case UHID_SET_REPORT: {
+            struct uhid_event reply = {.type = UHID_SET_REPORT_REPLY};
+            reply.u.set_report_reply.id = ev.u.set_report.id;
+            reply.u.set_report_reply.err = 0;
+            if (ev.u.set_report.rtype == UHID_OUTPUT_REPORT) {
+                handle_output(dev, ev.u.set_report.data, ev.u.set_report.size);
+            }
+            uhid_write(fd, &reply);
+            break;
+        }
+        default:  // START / STOP / OPEN / CLOSE
+            break;
+        }
+    }
+}
+
+// ============================================================================
+// DEVICE -> HOST
+// ============================================================================
+
+void uhid_backend_keyboard(const uint8_t report[8]) {
+    send_input(&devices[DEV_KEYBOARD], report, SIM_KEYBOARD_REPORT_SIZE);
+}
+
+void uhid_backend_consumer(uint16_t usage) {
+    uint8_t report[3] = {REPORT_ID_CONSUMER, usage & 0xFF, usage >> 8};
+    send_input(&devices[DEV_EXTRAKEYS], report, sizeof(report));
+}
+
+void uhid_backend_raw_hid(const uint8_t *data, uint8_t length) {
+    send_input(&devices[DEV_RAW_HID], data, length);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// /dev/uhid backend: the simulated keymap appears to the host as the Cleo's
+// USB interfaces (same VID/PID and report descriptors as the firmware)
+//   keyboard  - 6KRO boot keyboard report, LED output report
+//   extrakeys - consumer control, report ID 3
+//   raw HID   - usage page 0xFF60, 32-byte reports (tools/*.py work as-is)
+
+#define UHID_BACKEND_DEVICES 3
+
+// Create the devices (needs write access to /dev/uhid)
+bool uhid_backend_open(void);
+void uhid_backend_close(void);
+
+// Device fds for poll(); call uhid_backend_handle() when one is readable
+uint8_t uhid_backend_fds(int fds[UHID_BACKEND_DEVICES]);
+void uhid_backend_handle(int fd);
+
+// Name of the keyboard device, to find its evdev node (latency measurement)
+const char *uhid_backend_keyboard_name(void);
+
+// sim_host_t callbacks
+void uhid_backend_keyboard(const uint8_t report[8]);
+void uhid_backend_consumer(uint16_t usage);
+void uhid_backend_raw_hid(const uint8_t *data, uint8_t length);
@@ -0,0 +1,130 @@
+#include "speculative_tap.h"
+
+// ============================================================================
+// TYPING STREAK TRACKING
+// ============================================================================
+// last_alpha_time: event time of the most recent alphanumeric press
+// rhythm:          moving average of the interval between those presses
+
+#define SPECULATIVE_TAP_MAX_KEYS 2  // Speculative taps that can be held at once
+
+static uint16_t last_alpha_time = 0;
+static uint16_t rhythm = UINT16_MAX;
+static uint8_t streak_count = 0;
+
+// Keys currently held down as speculative taps (release must match press)
+static keypos_t held_pos[SPECULATIVE_TAP_MAX_KEYS];
+static bool held_active[SPECULATIVE_TAP_MAX_KEYS];
+
+// Tap-key presses handed to the tapping state machine and not processed yet.
+// While there is one, later events wait in its buffer: a speculative tap
+// would overtake them.
+static keypos_t unresolved_pos[SPECULATIVE_TAP_MAX_UNRESOLVED];
+static uint8_t unresolved_count = 0;
+
+static bool is_alphanumeric(uint16_t keycode) {
+    return (keycode >= KC_A && keycode <= KC_0);
+}
+
+static void track_alpha_press(uint16_t time) {
+    uint16_t interval = TIMER_DIFF_16(time, last_alpha_time);
+
+    if (streak_count == 0 || interval > SPECULATIVE_TAP_RHYTHM_TERM * 2) {
+        // Streak broken - start a new one from this press
+        streak_count = 1;
+        rhythm = UINT16_MAX;
+    } else {
+        if (streak_count < UINT8_MAX) {
+            streak_count++;
+        }
+        // rhythm = 3/4 rhythm + 1/4 interval (first interval seeds it)
+        rhythm = (rhythm == UINT16_MAX) ? interval : (uint16_t)((3 * (uint32_t)rhythm + interval) / 4);
+    }
+    last_alpha_time = time;
+}
+
+static bool in_typing_streak(uint16_t time) {
+    return streak_count >= SPECULATIVE_TAP_MIN_STREAK &&
+           TIMER_DIFF_16(time, last_alpha_time) < SPECULATIVE_TAP_STREAK_TERM &&
+           rhythm < SPECULATIVE_TAP_RHYTHM_TERM;
+}
+
+// ============================================================================
+// TAPPING BUFFER TRACKING
+// ============================================================================
+
+static bool is_tap_keycode(uint16_t keycode) {
+    return IS_QK_LAYER_TAP(keycode) || IS_QK_MOD_TAP(keycode);
+}
+
+// QMK's waiting buffer holds no more than the list
+static void track_unresolved(keypos_t pos) {
+    if (unresolved_count < SPECULATIVE_TAP_MAX_UNRESOLVED) {
+        unresolved_pos[unresolved_count++] = pos;
+    }
+}
+
+void speculative_tap_processed(keyrecord_t *record) {
+    if (!record->event.pressed) {
+        return;
+    }
+    for (uint8_t i = 0; i < unresolved_count; i++) {
+        if (KEYEQ(unresolved_pos[i], record->event.key)) {
+            unresolved_pos[i] = unresolved_pos[--unresolved_count];
+            return;
+        }
+    }
+}
+
+// ============================================================================
+// SPECULATIVE TAP RESOLUTION
+// ============================================================================
+
+// The press and release both skip the tapping state machine (it never saw
+// the press) and run the rest of QMK's processing as a resolved tap
+static void process_as_tap(keyrecord_t *record) {
+    record->tap.count = 1;
+    record->tap.interrupted = false;
+    process_record(record);
+}
+
+bool process_speculative_tap(uint16_t keycode, keyrecord_t *record) {
+    keypos_t pos = record->event.key;
+
+    if (!record->event.pressed) {
+        for (uint8_t i = 0; i < SPECULATIVE_TAP_MAX_KEYS; i++) {
+            if (held_active[i] && KEYEQ(held_pos[i], pos)) {
+                held_active[i] = false;
+                process_as_tap(record);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    if (is_alphanumeric(keycode)) {
+        track_alpha_press(record->event.time);
+        return true;
+    }
+
+    // Only speculate from the base layer: a held layer means the user is
+    // chording (tri-layer, symbols), not typing prose
+    if (!IS_QK_LAYER_TAP(keycode) || !is_speculative_tap_key(keycode) || layer_state != 0 ||
+        unresolved_count > 0 || !in_typing_streak(record->event.time)) {
+        if (is_tap_keycode(keycode)) {
+            track_unresolved(pos);
+        }
+        return true;
+    }
+
+    for (uint8_t i = 0; i < SPECULATIVE_TAP_MAX_KEYS; i++) {
+        if (!held_active[i]) {
+            held_active[i] = true;
+            held_pos[i] = pos;
+            process_as_tap(record);
+            return false;
+        }
+    }
+    track_unresolved(pos);
+    return true;
+}
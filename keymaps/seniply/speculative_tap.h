@@ -0,0 +1,39 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Speculative tap-hold resolution for layer-tap keys during typing streaks
+// While typing (recent alphanumeric presses at a steady rhythm) a layer-tap
+// press is resolved as a tap immediately on keydown, so the tap keycode is
+// sent without waiting for release and fast rolls cannot trigger the layer.
+// The press and its release go through process_record() with tap.count set,
+// so caps word, oneshots and process_record_user see an ordinary tap. Only
+// the tapping state machine is skipped, and only while it holds no earlier
+// events. Outside a streak the key goes through the normal tapping logic.
+
+#ifndef SPECULATIVE_TAP_STREAK_TERM
+#define SPECULATIVE_TAP_STREAK_TERM 125  // Max ms since the last alphanumeric press
+#endif
+
+#ifndef SPECULATIVE_TAP_RHYTHM_TERM
+#define SPECULATIVE_TAP_RHYTHM_TERM 170  // Max average ms between alphanumeric presses
+#endif
+
+#ifndef SPECULATIVE_TAP_MIN_STREAK
+#define SPECULATIVE_TAP_MIN_STREAK 2  // Alphanumeric presses needed before speculating
+#endif
+
+#define SPECULATIVE_TAP_MAX_UNRESOLVED 8  // Tap-key presses tracked in the tapping buffer (QMK's is 8 deep)
+
+// Call from pre_process_record_user (before the tapping state machine).
+// Returns false when the event was consumed as a speculative tap.
+bool process_speculative_tap(uint16_t keycode, keyrecord_t *record);
+
+// Call first in process_record_user (after the tapping state machine): a
+// tap-key press arriving here is resolved, and the events buffered behind it
+// follow right after
+void speculative_tap_processed(keyrecord_t *record);
+
+// To be implemented by the consumer. Defines which layer-tap keys may be
+// resolved speculatively.
+bool is_speculative_tap_key(uint16_t keycode);
@@ -0,0 +1,389 @@
+#include "status_display.h"
+#include "stopwatch.h"
+
+#include "qp.h"
+#include "qp_comms.h"
+#include "qp_st7735.h"
+
+#include <string.h>
+
+#define BAND_COUNT (LCD_HEIGHT / STATUS_DISPLAY_BAND_HEIGHT)
+#define NO_JOB 0xFF
+
+_Static_assert(LCD_HEIGHT % STATUS_DISPLAY_BAND_HEIGHT == 0, "LCD_HEIGHT must be a multiple of the band height");
+
+// RGB565, stored byte-swapped: the panel expects big-endian pixels
+#define RGB565(r, g, b) ((((r) & 0xF8) << 8) | (((g) & 0xFC) << 3) | ((b) >> 3))
+#define PIXEL(r, g, b) ((uint16_t)((RGB565(r, g, b) >> 8) | ((RGB565(r, g, b) & 0xFF) << 8)))
+
+#define COLOR_BG PIXEL(0, 0, 0)
+#define COLOR_TEXT PIXEL(255, 255, 255)
+#define COLOR_DIM PIXEL(48, 48, 48)
+#define COLOR_DIM_TEXT PIXEL(112, 112, 112)
+#define COLOR_MOD PIXEL(0, 160, 255)
+#define COLOR_CAPS PIXEL(255, 176, 0)
+#define COLOR_LOCK PIXEL(255, 64, 64)
+
+// ============================================================================
+// FONT (5x7, A-Z, column-major, bit 0 = top row)
+// ============================================================================
+
+static const uint8_t font_5x7[26][5] = {
+    {0x7C, 0x12, 0x11, 0x12, 0x7C}, {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22},
+    {0x7F, 0x41, 0x41, 0x22, 0x1C}, {0x7F, 0x49, 0x49, 0x49, 0x41}, {0x7F, 0x09, 0x09, 0x09, 0x01},
+    {0x3E, 0x41, 0x49, 0x49, 0x7A}, {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00},
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41}, {0x7F, 0x40, 0x40, 0x40, 0x40},
+    {0x7F, 0x02, 0x1C, 0x02, 0x7F}, {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E},
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E}, {0x7F, 0x09, 0x19, 0x29, 0x46},
+    {0x26, 0x49, 0x49, 0x49, 0x32}, {0x03, 0x01, 0x7F, 0x01, 0x03}, {0x3F, 0x40, 0x40, 0x40, 0x3F},
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x3F, 0x40, 0x38, 0x40, 0x3F}, {0x63, 0x14, 0x08, 0x14, 0x63},
+    {0x03, 0x04, 0x78, 0x04, 0x03}, {0x61, 0x59, 0x49, 0x4D, 0x43},
+};
+
+// ============================================================================
+// BAND RENDERING
+// ============================================================================
+// A band job covers rows [band * HEIGHT, +HEIGHT) and columns [x0, x1]; its
+// buffer is packed with a stride of the span width.
+
+typedef struct {
+    uint16_t pixels[LCD_WIDTH * STATUS_DISPLAY_BAND_HEIGHT];
+    uint8_t band;
+    uint8_t x0;
+    uint8_t x1;
+    bool ready;  // Rendered, waiting for (or on) the wire
+} band_job_t;
+
+static band_job_t jobs[2];
+static band_job_t *target;  // Job being rendered by the draw primitives
+
+static void fill_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint16_t color) {
+    uint8_t band_y = target->band * STATUS_DISPLAY_BAND_HEIGHT;
+    int16_t left = MAX(x, target->x0);
+    int16_t right = MIN(x + w - 1, target->x1);
+    int16_t top = MAX(y, band_y);
+    int16_t bottom = MIN(y + h - 1, band_y + STATUS_DISPLAY_BAND_HEIGHT - 1);
+    uint8_t stride = target->x1 - target->x0 + 1;
+
+    for (int16_t row = top; row <= bottom; row++) {
+        uint16_t *line = &target->pixels[(row - band_y) * stride];
+        for (int16_t col = left; col <= right; col++) {
+            line[col - target->x0] = color;
+        }
+    }
+}
+
+static uint8_t text_width(const char *text, uint8_t scale) {
+    uint8_t len = strlen(text);
+    return len ? (len * 6 - 1) * scale : 0;
+}
+
+static void draw_text(uint8_t x, uint8_t y, const char *text, uint8_t scale, uint16_t color) {
+    for (; *text; text++, x += 6 * scale) {
+        if (*text < 'A' || *text > 'Z') {
+            continue;
+        }
+        const uint8_t *glyph = font_5x7[*text - 'A'];
+        for (uint8_t col = 0; col < 5; col++) {
+            for (uint8_t row = 0; row < 7; row++) {
+                if (glyph[col] & (1 << row)) {
+                    fill_rect(x + col * scale, y + row * scale, scale, scale, color);
+                }
+            }
+        }
+    }
+}
+
+// ============================================================================
+// WIDGETS
+// ============================================================================
+
+typedef struct {
+    uint8_t x, y, w, h;
+} rect_t;
+
+enum widget_ids {
+    W_LAYER,
+    W_SHIFT,
+    W_CTRL,
+    W_ALT,
+    W_GUI,
+    W_ALTGR,
+    W_CAPS,
+    W_LOCK,
+    WIDGET_COUNT,
+};
+
+// clang-format off
+static const rect_t widget_rects[WIDGET_COUNT] = {
+    [W_LAYER] = { 0,   4, 80, 28},
+    [W_SHIFT] = { 1,  44, 14, 20},
+    [W_CTRL]  = {17,  44, 14, 20},
+    [W_ALT]   = {33,  44, 14, 20},
+    [W_GUI]   = {49,  44, 14, 20},
+    [W_ALTGR] = {65,  44, 14, 20},
+    [W_CAPS]  = { 4,  76, 72, 20},
+    [W_LOCK]  = { 4, 104, 72, 20},
+};
+
+static const char *const mod_labels[] = {"S", "C", "A", "G", "R"};
+static const uint8_t mod_masks[] = {
+    MOD_MASK_SHIFT, MOD_MASK_CTRL, MOD_BIT(KC_LALT), MOD_MASK_GUI, MOD_BIT(KC_RALT),
+};
+// clang-format on
+
+static uint8_t widget_values[WIDGET_COUNT];
+
+static uint8_t widget_value(uint8_t id) {
+    switch (id) {
+    case W_LAYER:
+        return get_highest_layer(layer_state);
+    case W_CAPS:
+        return is_caps_word_on();
+    case W_LOCK:
+        return is_layer_locked(get_highest_layer(layer_state));
+    default:
+        // Oneshot mods are registered while queued, so get_mods() covers them
+        return (get_mods() & mod_masks[id - W_SHIFT]) != 0;
+    }
+}
+
+static void draw_label_box(const rect_t *r, const char *label, bool active, uint16_t color) {
+    fill_rect(r->x, r->y, r->w, r->h, active ? color : COLOR_DIM);
+    draw_text(r->x + (r->w - text_width(label, 1)) / 2, r->y + (r->h - 7) / 2, label, 1,
+              active ? COLOR_BG : COLOR_DIM_TEXT);
+}
+
+static void draw_widget(uint8_t id) {
+    const rect_t *r = &widget_rects[id];
+    uint8_t value = widget_values[id];
+
+    switch (id) {
+    case W_LAYER: {
+        const char *name = status_display_layer_name(value);
+        fill_rect(r->x, r->y, r->w, r->h, COLOR_BG);
+        draw_text(r->x + (r->w - text_width(name, 2)) / 2, r->y + (r->h - 14) / 2, name, 2, COLOR_TEXT);
+        break;
+    }
+    case W_CAPS:
+        draw_label_box(r, "CAPS", value, COLOR_CAPS);
+        break;
+    case W_LOCK:
+        draw_label_box(r, "LOCK", value, COLOR_LOCK);
+        break;
+    default:
+        draw_label_box(r, mod_labels[id - W_SHIFT], value, COLOR_MOD);
+        break;
+    }
+}
+
+// ============================================================================
+// DIRTY TRACKING
+// ============================================================================
+// Per band: column span still to be pushed (x0 > x1 = clean)
+
+static uint8_t dirty_x0[BAND_COUNT];
+static uint8_t dirty_x1[BAND_COUNT];
+
+static void mark_dirty(uint8_t x, uint8_t y, uint8_t w, uint8_t h) {
+    for (uint8_t band = y / STATUS_DISPLAY_BAND_HEIGHT; band <= (y + h - 1) / STATUS_DISPLAY_BAND_HEIGHT; band++) {
+        dirty_x0[band] = MIN(dirty_x0[band], x);
+        dirty_x1[band] = MAX(dirty_x1[band], x + w - 1);
+    }
+}
+
+static void clear_dirty(uint8_t band) {
+    dirty_x0[band] = UINT8_MAX;
+    dirty_x1[band] = 0;
+}
+
+static bool is_dirty(uint8_t band) {
+    return dirty_x0[band] <= dirty_x1[band];
+}
+
+static bool poll_widgets(void) {
+    bool changed = false;
+    for (uint8_t id = 0; id < WIDGET_COUNT; id++) {
+        uint8_t value = widget_value(id);
+        if (value != widget_values[id]) {
+            widget_values[id] = value;
+            mark_dirty(widget_rects[id].x, widget_rects[id].y, widget_rects[id].w, widget_rects[id].h);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+// ============================================================================
+// REFRESH PIPELINE
+// ============================================================================
+
+static painter_device_t display;
+static uint8_t render_index = 0;  // Next job to render into
+static uint8_t send_index = 0;    // Next job to put on the wire
+static uint8_t sending = NO_JOB;  // Job currently on the wire
+static bool frame_active = false;
+static uint32_t frame_start;
+static uint32_t frame_cpu_cycles;
+static uint16_t frame_bytes;
+static status_display_stats_t stats;
+
+// Render the next dirty band into a free job
+static bool render_next_band(void) {
+    band_job_t *job = &jobs[render_index];
+    if (job->ready) {
+        return false;
+    }
+    for (uint8_t band = 0; band < BAND_COUNT; band++) {
+        if (!is_dirty(band)) {
+            continue;
+        }
+        job->band = band;
+        job->x0 = dirty_x0[band];
+        job->x1 = dirty_x1[band];
+        clear_dirty(band);
+
+        target = job;
+        fill_rect(0, band * STATUS_DISPLAY_BAND_HEIGHT, LCD_WIDTH, STATUS_DISPLAY_BAND_HEIGHT, COLOR_BG);
+        for (uint8_t id = 0; id < WIDGET_COUNT; id++) {
+            const rect_t *r = &widget_rects[id];
+            uint8_t band_y = band * STATUS_DISPLAY_BAND_HEIGHT;
+            if (r->y < band_y + STATUS_DISPLAY_BAND_HEIGHT && r->y + r->h > band_y && r->x <= job->x1 &&
+                r->x + r->w > job->x0) {
+                draw_widget(id);
+            }
+        }
+
+        job->ready = true;
+        render_index ^= 1;
+        return true;
+    }
+    return false;
+}
+
+// Set the panel window, then hand the pixels to the SPI DMA without waiting
+static void start_transfer(void) {
+    band_job_t *job = &jobs[send_index];
+    if (sending != NO_JOB || !job->ready) {
+        return;
+    }
+    uint8_t top = job->band * STATUS_DISPLAY_BAND_HEIGHT;
+    uint16_t bytes = (job->x1 - job->x0 + 1) * STATUS_DISPLAY_BAND_HEIGHT * sizeof(uint16_t);
+
+    qp_viewport(display, job->x0, top, job->x1, top + STATUS_DISPLAY_BAND_HEIGHT - 1);
+    qp_comms_start(display);
+    gpio_write_pin_high(LCD_DC_PIN);  // Data, not command
+    spiStartSend(&SPI_DRIVER, bytes, job->pixels);
+
+    frame_bytes += bytes;
+    sending = send_index;
+    send_index ^= 1;
+}
+
+static bool transfer_done(void) {
+    if (sending == NO_JOB) {
+        return true;
+    }
+    if (SPI_DRIVER.state != SPI_READY) {
+        return false;
+    }
+    qp_comms_stop(display);
+    jobs[sending].ready = false;
+    sending = NO_JOB;
+    return true;
+}
+
+static void finish_frame(void) {
+    frame_active = false;
+    stats.frames++;
+    stats.frame_us = MIN(stopwatch_elapsed_us(frame_start), UINT16_MAX);
+    stats.frame_cpu_us = MIN(frame_cpu_cycles / STOPWATCH_CYCLES_PER_US, UINT16_MAX);
+    stats.frame_bytes = frame_bytes;
+}
+
+void status_display_init(void) {
+    stopwatch_init();
+
+    display = qp_st7735_make_spi_device(LCD_WIDTH, LCD_HEIGHT, LCD_CS_PIN, LCD_DC_PIN, LCD_RST_PIN,
+                                        STATUS_DISPLAY_SPI_DIVISOR, 0);
+    qp_init(display, QP_ROTATION_0);
+    qp_set_viewport_offsets(display, STATUS_DISPLAY_OFFSET_X, STATUS_DISPLAY_OFFSET_Y);
+    qp_power(display, true);
+
+    // Full redraw on the first frame
+    for (uint8_t band = 0; band < BAND_COUNT; band++) {
+        dirty_x0[band] = 0;
+        dirty_x1[band] = LCD_WIDTH - 1;
+    }
+    for (uint8_t id = 0; id < WIDGET_COUNT; id++) {
+        widget_values[id] = widget_value(id);
+    }
+}
+
+void status_display_task(void) {
+    if (!display) {
+        return;
+    }
+    uint32_t start = stopwatch_now();
+
+    if (!frame_active) {
+        bool pending = poll_widgets();
+        for (uint8_t band = 0; band < BAND_COUNT && !pending; band++) {
+            pending = is_dirty(band);
+        }
+        if (!pending) {
+            return;
+        }
+        frame_active = true;
+        frame_start = start;
+        frame_cpu_cycles = 0;
+        frame_bytes = 0;
+    }
+
+    if (transfer_done()) {
+        render_next_band();
+        start_transfer();
+    }
+    // Render ahead while the other buffer is on the wire
+    render_next_band();
+
+    if (sending == NO_JOB && !jobs[0].ready && !jobs[1].ready) {
+        finish_frame();
+    }
+
+    uint32_t cycles = stopwatch_elapsed_cycles(start);
+    frame_cpu_cycles += cycles;
+    stats.max_task_us = MAX(stats.max_task_us, cycles / STOPWATCH_CYCLES_PER_US);
+}
+
+const status_display_stats_t *status_display_stats(void) {
+    return &stats;
+}
+
+// ============================================================================
+// RAW HID QUERY (host tool: tools/display_stats.py)
+// ============================================================================
+
+void status_display_raw_hid(uint8_t *data, uint8_t length) {
+    if (length < 13) {
+        return;
+    }
+    bool reset_max = data[1];
+
+    data[1] = stats.frames & 0xFF;
+    data[2] = (stats.frames >> 8) & 0xFF;
+    data[3] = (stats.frames >> 16) & 0xFF;
+    data[4] = stats.frames >> 24;
+    data[5] = stats.frame_us & 0xFF;
+    data[6] = stats.frame_us >> 8;
+    data[7] = stats.frame_cpu_us & 0xFF;
+    data[8] = stats.frame_cpu_us >> 8;
+    data[9] = stats.frame_bytes & 0xFF;
+    data[10] = stats.frame_bytes >> 8;
+    data[11] = stats.max_task_us & 0xFF;
+    data[12] = stats.max_task_us >> 8;
+
+    if (reset_max) {
+        stats.max_task_us = 0;
+    }
+}
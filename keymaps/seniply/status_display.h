@@ -0,0 +1,53 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Status display on the 80x160 ST7735 SPI LCD (Quantum Painter)
+// Shows the active layer, held/oneshot mods, caps word and layer lock.
+//
+// The screen is split into bands of STATUS_DISPLAY_BAND_HEIGHT rows. A
+// widget whose state changes marks the column span it covers in each band
+// it touches; only those spans are re-rendered into a small band buffer and
+// pushed with an asynchronous SPI DMA transfer. Two band buffers let the
+// next band render while the previous one is on the wire, and each call of
+// status_display_task() does at most one band of work, so even a full
+// refresh never stalls the matrix scan or USB.
+
+#ifndef STATUS_DISPLAY_SPI_DIVISOR
+#define STATUS_DISPLAY_SPI_DIVISOR 4  // 48 MHz / 4 = 12 MHz SPI clock
+#endif
+
+#ifndef STATUS_DISPLAY_OFFSET_X
+#define STATUS_DISPLAY_OFFSET_X 26  // Controller RAM offset of 0.96" 80x160 panels
+#endif
+
+#ifndef STATUS_DISPLAY_OFFSET_Y
+#define STATUS_DISPLAY_OFFSET_Y 1
+#endif
+
+#define STATUS_DISPLAY_BAND_HEIGHT 8
+
+// Refresh cost, measured with the SysTick stopwatch (stopwatch.h)
+typedef struct {
+    uint32_t frames;
+    uint16_t frame_us;      // Last frame: first band rendered -> last DMA done
+    uint16_t frame_cpu_us;  // Last frame: CPU time spent in status_display_task
+    uint16_t frame_bytes;   // Last frame: pixel bytes pushed
+    uint16_t max_task_us;   // Longest single status_display_task call
+} status_display_stats_t;
+
+// Set up the panel and queue a full redraw
+void status_display_init(void);
+
+// Poll state and advance the refresh (call from housekeeping_task_user)
+void status_display_task(void);
+
+const status_display_stats_t *status_display_stats(void);
+
+// Handle a raw HID stats query: [cmd, reset max] -> [cmd, frames u32,
+// frame us u16, frame cpu us u16, frame bytes u16, max task us u16]
+void status_display_raw_hid(uint8_t *data, uint8_t length);
+
+// To be implemented by the consumer. Upper-case name of a layer (A-Z, at
+// most 6 characters to fit the panel width).
+const char *status_display_layer_name(uint8_t layer);
@@ -0,0 +1,186 @@
+#include "tap_tune.h"
+
+#include <string.h>
+
+#define TAP_TUNE_MAGIC 0x54  // 'T' - marks an initialized datablock
+
+_Static_assert(TAP_TUNE_MAX_TERM / TAP_TUNE_TERM_UNIT <= UINT8_MAX, "TAP_TUNE_MAX_TERM does not fit the persisted term");
+
+// ============================================================================
+// STATE
+// ============================================================================
+// Histograms use 8-bit counts: when a bin saturates, the whole histogram is
+// halved so old behaviour decays and recent typing dominates.
+
+typedef struct {
+    uint8_t bins[2][TAP_TUNE_BINS];  // [0] = short (tap), [1] = long (hold)
+    uint16_t press_time;
+    uint8_t term;                    // Derived term in TAP_TUNE_TERM_UNIT, 0 = fallback
+} tap_tune_slot_t;
+
+typedef struct {
+    uint8_t magic;
+    uint8_t terms[TAP_TUNE_SLOT_COUNT];
+} tap_tune_eeprom_t;
+
+static tap_tune_slot_t slots[TAP_TUNE_SLOT_COUNT];
+static bool terms_dirty = false;
+static uint32_t last_save_time = 0;
+
+// ============================================================================
+// HISTOGRAMS
+// ============================================================================
+
+static void add_sample(uint8_t *bins, uint16_t duration) {
+    uint8_t bin = duration / TAP_TUNE_BIN_MS;
+    if (bin >= TAP_TUNE_BINS) {
+        bin = TAP_TUNE_BINS - 1;
+    }
+
+    if (bins[bin] == UINT8_MAX) {
+        for (uint8_t i = 0; i < TAP_TUNE_BINS; i++) {
+            bins[i] >>= 1;
+        }
+    }
+    bins[bin]++;
+}
+
+static uint16_t total(const uint8_t *bins) {
+    uint16_t sum = 0;
+    for (uint8_t i = 0; i < TAP_TUNE_BINS; i++) {
+        sum += bins[i];
+    }
+    return sum;
+}
+
+// Upper edge (ms) of the bin holding the given percentile
+static uint16_t percentile(const uint8_t *bins, uint16_t count, uint8_t pct) {
+    uint16_t target = ((uint32_t)count * pct + 99) / 100;
+    uint16_t sum = 0;
+    for (uint8_t i = 0; i < TAP_TUNE_BINS; i++) {
+        sum += bins[i];
+        if (sum >= target) {
+            return (i + 1) * TAP_TUNE_BIN_MS;
+        }
+    }
+    return TAP_TUNE_BINS * TAP_TUNE_BIN_MS;
+}
+
+static void derive_term(tap_tune_slot_t *slot) {
+    uint16_t short_count = total(slot->bins[0]);
+    if (short_count < TAP_TUNE_MIN_SAMPLES) {
+        return;
+    }
+
+    uint16_t term = percentile(slot->bins[0], short_count, 95) + TAP_TUNE_MARGIN;
+
+    // Stay below the fastest holds if taps and holds are separable
+    uint16_t long_count = total(slot->bins[1]);
+    if (long_count >= TAP_TUNE_MIN_SAMPLES / 4) {
+        uint16_t hold_floor = percentile(slot->bins[1], long_count, 5) - TAP_TUNE_BIN_MS;
+        uint16_t tap_ceiling = term - TAP_TUNE_MARGIN;
+        if (hold_floor > tap_ceiling && term > hold_floor) {
+            term = hold_floor;
+        }
+    }
+
+    if (term < TAP_TUNE_MIN_TERM) {
+        term = TAP_TUNE_MIN_TERM;
+    } else if (term > TAP_TUNE_MAX_TERM) {
+        term = TAP_TUNE_MAX_TERM;
+    }
+
+    uint8_t units = term / TAP_TUNE_TERM_UNIT;
+    if (units != slot->term) {
+        slot->term = units;
+        terms_dirty = true;
+    }
+}
+
+// ============================================================================
+// SAMPLING
+// ============================================================================
+
+void tap_tune_press(uint8_t slot, uint16_t time) {
+    if (slot < TAP_TUNE_SLOT_COUNT) {
+        slots[slot].press_time = time;
+    }
+}
+
+void tap_tune_release(uint8_t slot, uint16_t time, bool is_hold) {
+    if (slot < TAP_TUNE_SLOT_COUNT) {
+        tap_tune_sample(slot, tap_tune_held(slot, time), is_hold);
+    }
+}
+
+uint16_t tap_tune_held(uint8_t slot, uint16_t time) {
+    return slot < TAP_TUNE_SLOT_COUNT ? TIMER_DIFF_16(time, slots[slot].press_time) : 0;
+}
+
+void tap_tune_sample(uint8_t slot, uint16_t duration, bool is_long) {
+    if (slot >= TAP_TUNE_SLOT_COUNT) {
+        return;
+    }
+    add_sample(slots[slot].bins[is_long ? 1 : 0], duration);
+    derive_term(&slots[slot]);
+}
+
+uint16_t tap_tune_term(uint8_t slot, uint16_t fallback) {
+    if (slot >= TAP_TUNE_SLOT_COUNT || slots[slot].term == 0) {
+        return fallback;
+    }
+    return slots[slot].term * TAP_TUNE_TERM_UNIT;
+}
+
+// ============================================================================
+// PERSISTENCE (EECONFIG user datablock)
+// ============================================================================
+
+void tap_tune_init(void) {
+    tap_tune_eeprom_t block;
+    eeconfig_read_user_datablock(&block, TAP_TUNE_EEPROM_OFFSET, sizeof(block));
+
+    if (block.magic != TAP_TUNE_MAGIC) {
+        return;  // Never tuned - keep fallbacks until samples arrive
+    }
+    for (uint8_t i = 0; i < TAP_TUNE_SLOT_COUNT; i++) {
+        uint16_t term = block.terms[i] * TAP_TUNE_TERM_UNIT;
+        slots[i].term = (term >= TAP_TUNE_MIN_TERM && term <= TAP_TUNE_MAX_TERM) ? block.terms[i] : 0;
+    }
+    last_save_time = timer_read32();
+}
+
+void tap_tune_task(void) {
+    if (!terms_dirty || timer_elapsed32(last_save_time) < TAP_TUNE_SAVE_INTERVAL) {
+        return;
+    }
+
+    tap_tune_eeprom_t block = {.magic = TAP_TUNE_MAGIC};
+    for (uint8_t i = 0; i < TAP_TUNE_SLOT_COUNT; i++) {
+        block.terms[i] = slots[i].term;
+    }
+    eeconfig_update_user_datablock(&block, TAP_TUNE_EEPROM_OFFSET, sizeof(block));
+
+    terms_dirty = false;
+    last_save_time = timer_read32();
+}
+
+// ============================================================================
+// RAW HID QUERY (host tool: tools/tap_tune_view.py)
+// ============================================================================
+
+void tap_tune_raw_hid(uint8_t *data, uint8_t length) {
+    uint8_t slot = data[1];
+    uint8_t kind = data[2] ? 1 : 0;
+
+    if (slot >= TAP_TUNE_SLOT_COUNT || length < 6 + TAP_TUNE_BINS) {
+        data[1] = 0xFF;
+        return;
+    }
+
+    uint16_t term = slots[slot].term * TAP_TUNE_TERM_UNIT;
+    data[3] = TAP_TUNE_SLOT_COUNT;
+    data[4] = term & 0xFF;
+    data[5] = term >> 8;
+    memcpy(&data[6], slots[slot].bins[kind], TAP_TUNE_BINS);
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Self-tuning per-key timing terms
+// Every dual-function key gets a slot with two duration histograms:
+// "short" samples (presses resolved as taps) and "long" samples (presses
+// resolved as holds). The slot's term is derived from those histograms,
+// persisted in the EECONFIG user datablock and used in place of the global
+// TAPPING_TERM / FLOW_ONESHOT_WAIT_TERM / CAPS_WORD_DOUBLE_TAP_TERM.
+//
+// term = 95th percentile of short samples + TAP_TUNE_MARGIN, capped below
+// the 5th percentile of long samples when the two are separable, and
+// clamped to [TAP_TUNE_MIN_TERM, TAP_TUNE_MAX_TERM].
+
+#ifndef TAP_TUNE_SLOT_COUNT
+#define TAP_TUNE_SLOT_COUNT 8
+#endif
+
+#ifndef TAP_TUNE_BIN_MS
+#define TAP_TUNE_BIN_MS 32  // Histogram bin width (16 bins, last bin is overflow)
+#endif
+
+#ifndef TAP_TUNE_MARGIN
+#define TAP_TUNE_MARGIN 40  // ms added above the 95th percentile of taps
+#endif
+
+#ifndef TAP_TUNE_MIN_TERM
+#define TAP_TUNE_MIN_TERM 100
+#endif
+
+#ifndef TAP_TUNE_MAX_TERM
+#define TAP_TUNE_MAX_TERM 500
+#endif
+
+#ifndef TAP_TUNE_MIN_SAMPLES
+#define TAP_TUNE_MIN_SAMPLES 24  // Short samples needed before a term is derived
+#endif
+
+#ifndef TAP_TUNE_SAVE_INTERVAL
+#define TAP_TUNE_SAVE_INTERVAL 600000  // Min ms between EEPROM writes (flash wear)
+#endif
+
+#ifndef TAP_TUNE_EEPROM_OFFSET
+#define TAP_TUNE_EEPROM_OFFSET 0  // Offset in the EECONFIG user datablock
+#endif
+
+#define TAP_TUNE_BINS 16
+#define TAP_TUNE_TERM_UNIT 4  // Persisted terms are stored in 4 ms units
+
+// Bytes used in the EECONFIG user datablock (magic + one term per slot)
+#define TAP_TUNE_EEPROM_SIZE (1 + TAP_TUNE_SLOT_COUNT)
+
+// Load persisted terms (call once EEPROM is available)
+void tap_tune_init(void);
+
+// Record a press of a slot's key (event time)
+void tap_tune_press(uint8_t slot, uint16_t time);
+
+// Record the release of a slot's key, classified by the caller
+void tap_tune_release(uint8_t slot, uint16_t time, bool is_hold);
+
+// How long a slot's key has been down at `time` (since tap_tune_press)
+uint16_t tap_tune_held(uint8_t slot, uint16_t time);
+
+// Record a raw duration sample (for terms that are not press durations,
+// e.g. the gap between two shift taps)
+void tap_tune_sample(uint8_t slot, uint16_t duration, bool is_long);
+
+// Tuned term for a slot, or fallback until enough samples exist
+uint16_t tap_tune_term(uint8_t slot, uint16_t fallback);
+
+// Persist changed terms (rate limited, call from housekeeping_task_user)
+void tap_tune_task(void);
+
+// Handle a raw HID histogram query: [cmd, slot, long] -> [cmd, slot, long,
+// slot count, term lo, term hi, 16 bins]
+void tap_tune_raw_hid(uint8_t *data, uint8_t length);
@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+"""Show the boot phase times of the last reset (fast_boot.c).
+
+Replug the keyboard (or switch the KVM) and run this to see how long it
+took from reset until keystrokes could be sent.
+
+Usage: ./boot_timing.py
+"""
+
+import argparse
+
+from rawhid import RawHid, RAW_CMD_BOOT
+
+# Mirrors enum fast_boot_phases in fast_boot.h
+PHASES = [
+    "pre init",
+    "matrix init",
+    "post init",
+    "first scan",
+    "USB active",
+    "split connected",
+    "deferred init done",
+    "first key",
+]
+NOT_REACHED = 0xFFFF
+READY_PHASES = ("first scan", "USB active", "split connected")
+
+
+def fetch(kb):
+    reply = kb.request(RAW_CMD_BOOT)
+    count = min(reply[1], len(PHASES))
+    return {PHASES[i]: reply[2 + 2 * i] | reply[3 + 2 * i] << 8 for i in range(count)}
+
+
+def show(times):
+    previous = 0
+    for name in PHASES:
+        ms = times.get(name, NOT_REACHED)
+        if ms == NOT_REACHED:
+            print(f"{name:20s}        -")
+            continue
+        print(f"{name:20s} {ms:6d} ms  (+{ms - previous} ms)")
+        previous = ms
+
+    reached = [times[name] for name in READY_PHASES if times.get(name, NOT_REACHED) != NOT_REACHED]
+    if reached:
+        print(f"ready to type after {max(reached)} ms")
+
+
+def main():
+    argparse.ArgumentParser(description=__doc__.splitlines()[0]).parse_args()
+    kb = RawHid()
+    show(fetch(kb))
+    kb.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,50 @@
+#!/usr/bin/env python3
+"""Show the status display refresh cost (status_display.c).
+
+Usage: ./display_stats.py [--reset] [--watch SECONDS]
+"""
+
+import argparse
+import time
+
+from rawhid import RawHid, RAW_CMD_DISPLAY
+
+
+def fetch(kb, reset_max):
+    reply = kb.request(RAW_CMD_DISPLAY, 1 if reset_max else 0)
+    u16 = lambda i: reply[i] | reply[i + 1] << 8
+    return {
+        "frames": reply[1] | reply[2] << 8 | reply[3] << 16 | reply[4] << 24,
+        "frame_us": u16(5),
+        "frame_cpu_us": u16(7),
+        "frame_bytes": u16(9),
+        "max_task_us": u16(11),
+    }
+
+
+def show(stats):
+    print(f"frames {stats['frames']:6d} | last frame {stats['frame_us']:6d} us wall, "
+          f"{stats['frame_cpu_us']:5d} us CPU, {stats['frame_bytes']:5d} bytes | "
+          f"longest task call {stats['max_task_us']:4d} us")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--reset", action="store_true", help="reset the longest task call after reading")
+    parser.add_argument("--watch", type=float, metavar="SECONDS", help="poll continuously")
+    args = parser.parse_args()
+
+    kb = RawHid()
+    try:
+        while True:
+            show(fetch(kb, args.reset))
+            if not args.watch:
+                break
+            time.sleep(args.watch)
+    except KeyboardInterrupt:
+        pass
+    kb.close()
+
+
+if __name__ == "__main__":
+    main()
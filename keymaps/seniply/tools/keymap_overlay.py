@@ -0,0 +1,162 @@
+#!/usr/bin/env python3
+"""Hot-load a keymap into the keyboard's RAM overlay (keymap_overlay.c).
+
+The keymap file (default: keymap.c) is compiled on the host with the
+simulator's QMK shim (sim/, real keycode values) and its keymaps[] written
+as a blob; the blob is uploaded over raw HID, checked against its CRC and
+swapped in once no key is held. No DFU, no re-enumeration: edit, upload,
+type, repeat. Keep variants as copies of keymap.c next to it to A/B them.
+
+Usage: ./keymap_overlay.py                      # what is active
+       ./keymap_overlay.py --upload [KEYMAP_C] [--persist]
+       ./keymap_overlay.py --blob FILE [--persist]
+       ./keymap_overlay.py --save-blob FILE [KEYMAP_C]
+       ./keymap_overlay.py --revert [--persist]
+"""
+
+import argparse
+import binascii
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+KEYMAP_DIR = os.path.dirname(HERE)
+SIM_DIR = os.path.join(KEYMAP_DIR, 'sim')
+
+CHUNK = 26  # KEYMAP_OVERLAY_CHUNK in keymap_overlay.h
+OP_INFO, OP_WRITE, OP_APPLY, OP_REVERT, OP_READ = range(5)
+STATUS = ['ok', 'bad range', 'bad CRC', 'bad op']
+
+
+def build_blob(keymap_c):
+    """Compile keymap_c with the sim shim and return its keymaps[] blob."""
+    with tempfile.TemporaryDirectory() as tmp:
+        binary = os.path.join(tmp, 'keymap_dump')
+        blob = os.path.join(tmp, 'keymap.bin')
+        env = dict(os.environ, SIM_MAIN=os.path.join(SIM_DIR, 'keymap_dump.c'),
+                   SIM_CFLAGS=f'-DKEYMAP_C="{os.path.abspath(keymap_c)}"')  # No spaces, build.sh splits it
+        try:
+            subprocess.run([os.path.join(SIM_DIR, 'build.sh'), binary], check=True, env=env)
+            subprocess.run([binary, blob], check=True)
+        except subprocess.CalledProcessError:
+            sys.exit(f'{keymap_c}: build failed (keycodes missing from sim/qmk_shim.h?)')
+        with open(blob, 'rb') as f:
+            return f.read()
+
+
+def crc16(data):
+    return binascii.crc_hqx(data, 0xFFFF)  # CRC-16/CCITT-FALSE, as on the device
+
+
+class Overlay:
+    def __init__(self):
+        from rawhid import RawHid, RAW_CMD_KEYMAP
+        self.kb = RawHid()
+        self.cmd = RAW_CMD_KEYMAP
+
+    def request(self, op, *args):
+        reply = self.kb.request(self.cmd, op, 0, *args)
+        if reply[2]:
+            sys.exit(f'keyboard: {STATUS[reply[2]] if reply[2] < len(STATUS) else reply[2]}')
+        return reply
+
+    def info(self):
+        reply = self.request(OP_INFO)
+        return {
+            'layers': reply[3], 'rows': reply[4], 'cols': reply[5],
+            'ram': bool(reply[6]), 'pending': bool(reply[7] & 1), 'persisted': bool(reply[7] & 2),
+            'crc': reply[8] | reply[9] << 8,
+        }
+
+    def size(self, info):
+        return info['layers'] * info['rows'] * info['cols'] * 2
+
+    def read(self, size):
+        data = bytearray()
+        for offset in range(0, size, CHUNK):
+            count = min(CHUNK, size - offset)
+            reply = self.request(OP_READ, offset & 0xFF, offset >> 8, count)
+            data += bytes(reply[6:6 + count])
+        return bytes(data)
+
+    def upload(self, blob, persist):
+        for offset in range(0, len(blob), CHUNK):
+            chunk = blob[offset:offset + CHUNK]
+            self.request(OP_WRITE, offset & 0xFF, offset >> 8, len(chunk), *chunk)
+        crc = crc16(blob)
+        self.request(OP_APPLY, crc & 0xFF, crc >> 8, 1 if persist else 0)
+        return crc
+
+    def close(self):
+        self.kb.close()
+
+
+def show(info):
+    source = 'RAM overlay' if info['ram'] else 'compiled keymap'
+    crc = f' (CRC {info["crc"]:04x})' if info['crc'] else ''
+    print(f'{info["layers"]} layers x {info["rows"]}x{info["cols"]}: {source} active{crc}'
+          + (', swap pending (waiting for all keys up)' if info['pending'] else '')
+          + (', overlay persisted' if info['persisted'] else ''))
+
+
+def diff(old, new, info):
+    """Positions whose keycode changes, as (layer, row, col)."""
+    cells = info['rows'] * info['cols']
+    changed = []
+    for i in range(0, len(new), 2):
+        if old[i:i + 2] != new[i:i + 2]:
+            index = i // 2
+            changed.append((index // cells, index % cells // info['cols'], index % info['cols']))
+    return changed
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('keymap', nargs='?', default=os.path.join(KEYMAP_DIR, 'keymap.c'))
+    action = parser.add_mutually_exclusive_group()
+    action.add_argument('--upload', action='store_true', help='build KEYMAP_C and load it')
+    action.add_argument('--blob', metavar='FILE', help='load a blob saved by --save-blob')
+    action.add_argument('--save-blob', metavar='FILE', help='build KEYMAP_C into FILE, no keyboard')
+    action.add_argument('--revert', action='store_true', help='back to the compiled keymap')
+    parser.add_argument('--persist', action='store_true',
+                        help='write the overlay to EEPROM (with --revert: erase it)')
+    args = parser.parse_args()
+
+    if args.save_blob:
+        blob = build_blob(args.keymap)
+        with open(args.save_blob, 'wb') as f:
+            f.write(blob)
+        print(f'{args.save_blob}: {len(blob)} bytes, CRC {crc16(blob):04x}')
+        return
+
+    blob = None
+    if args.upload:
+        blob = build_blob(args.keymap)
+    elif args.blob:
+        with open(args.blob, 'rb') as f:
+            blob = f.read()
+
+    overlay = Overlay()
+    info = overlay.info()
+    if blob is not None:
+        if len(blob) != overlay.size(info):
+            sys.exit(f'blob is {len(blob)} bytes, the keyboard takes {overlay.size(info)} '
+                     f'({info["layers"]} layers x {info["rows"]}x{info["cols"]})')
+        changed = diff(overlay.read(len(blob)), blob, info)
+        start = time.monotonic()
+        crc = overlay.upload(blob, args.persist)
+        print(f'{len(changed)} keys changed, loaded in {1000 * (time.monotonic() - start):.0f} ms '
+              f'(CRC {crc:04x}{", persisted" if args.persist else ""})')
+        for layer, row, col in changed[:16]:
+            print(f'    layer {layer} row {row} col {col}')
+    elif args.revert:
+        overlay.request(OP_REVERT, 1 if args.persist else 0)
+    show(overlay.info())
+    overlay.close()
+
+
+if __name__ == '__main__':
+    main()
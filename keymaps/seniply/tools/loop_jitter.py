@@ -0,0 +1,63 @@
+#!/usr/bin/env python3
+"""Show the main loop period histogram and RGB frame stats (rgb_thread.c).
+
+Flash once with RGB_MATRIX_THREAD_ENABLE = yes and once with = no (keymap
+rules.mk, or RGB_MATRIX_ENABLE = no for a build without the RGB matrix) and
+compare the histograms under the same typing and effect.
+
+Usage: ./loop_jitter.py [--reset] [--watch SECONDS]
+"""
+
+import argparse
+import time
+
+from rawhid import RawHid, RAW_CMD_RGB_LOOP
+
+BUCKETS = ["<128us", "<256us", "<512us", "<1ms", "<2ms", "<4ms", "<8ms", ">=8ms"]
+
+
+def fetch(kb, reset):
+    reply = kb.request(RAW_CMD_RGB_LOOP, 1 if reset else 0)
+    u16 = lambda i: reply[i] | reply[i + 1] << 8
+    return {
+        "threaded": bool(reply[1] & 1),
+        "rgb": bool(reply[1] & 2),
+        "loops": u16(2) | u16(4) << 16,
+        "loop_max_us": u16(6),
+        "hist": [u16(8 + 2 * i) for i in range(len(BUCKETS))],
+        "frames": u16(24),
+        "frame_max_us": u16(26),
+        "overruns": u16(28),
+        "hits_dropped": reply[30],
+    }
+
+
+def show(stats):
+    total = sum(stats["hist"]) or 1
+    mode = ("thread" if stats["threaded"] else "inline") if stats["rgb"] else "no rgb"
+    frames = (f" | frames {stats['frames']:5d}, longest {stats['frame_max_us']:5d} us, "
+              f"{stats['overruns']} over budget, {stats['hits_dropped']} hits dropped") if stats["rgb"] else ""
+    print(f"{mode} | loops {stats['loops']:8d}, longest {stats['loop_max_us']:5d} us{frames}")
+    print("  " + " ".join(f"{name} {100 * count / total:5.1f}%" for name, count in zip(BUCKETS, stats["hist"])))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--reset", action="store_true", help="reset all counters after reading")
+    parser.add_argument("--watch", type=float, metavar="SECONDS", help="poll continuously")
+    args = parser.parse_args()
+
+    kb = RawHid()
+    try:
+        while True:
+            show(fetch(kb, args.reset))
+            if not args.watch:
+                break
+            time.sleep(args.watch)
+    except KeyboardInterrupt:
+        pass
+    kb.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+"""Map RAM use per subsystem from the firmware ELF, or read it from the keyboard.
+
+From the ELF (arm-none-eabi-nm with line info): every .data/.bss symbol is
+put in a subsystem by its source path, then by its name, and the stacks and
+heap come from the ChibiOS linker symbols. --header writes the per-subsystem
+totals to ram_map_data.h, which memory_map.c serves over raw HID; rebuild
+and flash after generating it (the device flags a map that does not match
+its own .data + .bss).
+
+With --device: stack sizes and high-water marks (stack painting), the RAM
+regions and the compiled-in map, all read from the running keyboard.
+
+Usage: ./ram_map.py firmware.elf [-v] [--header [PATH]] [--nm TOOL]
+       ./ram_map.py --device
+"""
+
+import argparse
+import collections
+import os
+import re
+import subprocess
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+HEADER = os.path.normpath(os.path.join(HERE, '..', 'ram_map_data.h'))
+
+RAM_BASE = 0x20000000
+RAM_SIZE = 16 * 1024  # STM32F072
+NAME_LENGTH = 16      # MEMORY_MAP_NAME_LENGTH in memory_map.h
+
+# subsystem: (source path patterns, symbol name patterns), first match wins
+SUBSYSTEMS = [
+    ('rgb', (r'rgb_matrix|rgblight|ws2812|rgb_thread|key_indicators|/color\.c', r'rgb|ws2812|^led_|field')),
+    ('split', (r'split_common|serial|transactions|transport|key_timestamps', r'split|serial|transaction|prefetch|^rx_|^tx_|SD1')),
+    ('eeprom cache', (r'wear_leveling|eeprom|dynamic_keymap|/via\.c|vial|flash', r'wear_leveling|eeprom|dynamic_keymap|backing')),
+    ('oneshot', (r'oneshot|caps_word|layer_lock', r'oneshot|caps_word')),
+    ('usb', (r'usb|/hid|report\.c|protocol/chibios', r'usb|USB|hid|report|^ep\d')),
+    ('matrix', (r'matrix|debounce|/keyboard\.c|/action', r'matrix|debounce|action|tapping|waiting_buffer')),
+    ('keymap', (r'keymaps/seniply|process_keycode', r'')),
+    ('chibios', (r'ChibiOS|/os/', r'^ch$|^ch_|_idle|PWMD|SPID|dma|^vt')),
+]
+
+STACK_SYMBOLS = [
+    ('isr stack', '__main_stack_base__', '__main_stack_end__'),
+    ('main stack', '__process_stack_base__', '__process_stack_end__'),
+    ('heap', '__heap_base__', '__heap_end__'),
+]
+
+
+def classify(name, path):
+    name = re.sub(r'\.(lto_priv|constprop|isra)\.\d+', '', name)
+    for subsystem, (path_re, name_re) in SUBSYSTEMS:
+        if path and re.search(path_re, path):
+            return subsystem
+    for subsystem, (path_re, name_re) in SUBSYSTEMS:
+        if name_re and re.search(name_re, name):
+            return subsystem
+    return 'other'
+
+
+def read_elf(elf, nm):
+    """Return ({subsystem: [(bytes, symbol)]}, {linker symbol: address})."""
+    try:
+        output = subprocess.run([nm, '-S', '-l', '-t', 'd', elf], stdout=subprocess.PIPE,
+                                universal_newlines=True, check=True).stdout
+    except FileNotFoundError:
+        sys.exit(f'{nm} not found (--nm to point at the ARM toolchain)')
+    groups = collections.defaultdict(list)
+    symbols = {}
+    for line in output.splitlines():
+        fields, _, path = line.partition('\t')
+        parts = fields.split()
+        if len(parts) == 3:  # No size: linker symbol
+            symbols[parts[2]] = int(parts[0])
+            continue
+        if len(parts) != 4 or parts[2] not in 'bBdD':
+            continue
+        address, size, name = int(parts[0]), int(parts[1]), parts[3]
+        if RAM_BASE <= address < RAM_BASE + RAM_SIZE and size > 0:
+            groups[classify(name, path)].append((size, name))
+    return groups, symbols
+
+
+def write_header(path, elf, totals, static_bytes):
+    lines = [
+        f'// Generated by tools/ram_map.py from {os.path.basename(elf)}, do not edit',
+        f'// {static_bytes} bytes .data + .bss, {sum(size for _, size in totals)} of them in {len(totals)} subsystems',
+        '#pragma once',
+        '',
+        f'#define RAM_MAP_STATIC_BYTES {static_bytes}',
+        f'#define RAM_MAP_ENTRIES {len(totals)}',
+        '',
+        'static const memory_map_entry_t ram_map[RAM_MAP_ENTRIES] = {',
+    ]
+    lines += [f'    {{"{name[:NAME_LENGTH - 1]}", {size}}},' for name, size in totals]
+    lines.append('};')
+    with open(path, 'w') as f:
+        f.write('\n'.join(lines) + '\n')
+    print(f'{path}: {len(totals)} subsystems, {static_bytes} bytes')
+
+
+def show_elf(args):
+    groups, symbols = read_elf(args.elf, args.nm)
+    totals = sorted(((name, sum(size for size, _ in syms)) for name, syms in groups.items()),
+                    key=lambda item: -item[1])
+    static_bytes = sum(size for _, size in totals)
+    # Section sizes include alignment padding, this is what the device compares
+    if all(sym in symbols for sym in ('__data_base__', '__data_end__', '__bss_base__', '__bss_end__')):
+        sections = (symbols['__data_end__'] - symbols['__data_base__']) + (symbols['__bss_end__'] - symbols['__bss_base__'])
+    else:
+        sections = static_bytes
+    linker = [(name, symbols[end] - symbols[base]) for name, base, end in STACK_SYMBOLS
+              if base in symbols and end in symbols]
+
+    print(f'{"subsystem":<14} {"bytes":>6} {"RAM":>6}')
+    for name, size in totals + [('(static)', static_bytes)] + linker:
+        print(f'{name:<14} {size:6d} {100 * size / RAM_SIZE:5.1f}%')
+        if args.verbose and name in groups:
+            for sym_size, sym in sorted(groups[name], reverse=True)[:8]:
+                print(f'    {sym_size:6d} {sym}')
+    print(f'{"total":<14} {sections + sum(size for _, size in linker):6d} of {RAM_SIZE} '
+          f'({sections - static_bytes} bytes alignment)')
+
+    if args.header:
+        write_header(args.header, args.elf, totals, sections)
+
+
+def show_device():
+    from rawhid import RawHid, RAW_CMD_MEMORY
+
+    def entries(kb, page):
+        index, count = 0, 1
+        while index < count:
+            reply = kb.request(RAW_CMD_MEMORY, page, index)
+            count = reply[3]
+            name = bytes(reply[9:9 + NAME_LENGTH]).split(b'\0')[0].decode(errors='replace')
+            yield name, reply[4] | reply[5] << 8, reply[6] | reply[7] << 8, reply[8]
+            index += 1
+
+    kb = RawHid()
+    print(f'{"stack":<14} {"size":>6} {"used":>6}')
+    for name, size, used, _ in entries(kb, 0):
+        warn = '  <- over 80%' if size and used * 5 > size * 4 else ''
+        print(f'{name:<14} {size:6d} {used:6d} {100 * used / max(size, 1):5.1f}%{warn}')
+    print()
+    print(f'{"region":<14} {"bytes":>6} {"free":>6}')
+    for name, size, free, _ in entries(kb, 1):
+        print(f'{name:<14} {size:6d} ' + (f'{free:6d}' if name == 'heap' else f'{"":>6}'))
+    print()
+    static = list(entries(kb, 2))
+    if not static or not static[0][0]:
+        print('no static map compiled in (ram_map.py firmware.elf --header, then rebuild)')
+    else:
+        print(f'{"subsystem":<14} {"bytes":>6}' + ('' if static[0][3] & 1 else '  (stale: regenerate)'))
+        for name, size, _, _ in static:
+            print(f'{name:<14} {size:6d}')
+    kb.close()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('elf', nargs='?')
+    parser.add_argument('-v', '--verbose', action='store_true', help='largest symbols per subsystem')
+    parser.add_argument('--header', nargs='?', const=HEADER, metavar='PATH', help=f'write {HEADER}')
+    parser.add_argument('--nm', default='arm-none-eabi-nm')
+    parser.add_argument('--device', action='store_true', help='read stacks and map from the keyboard')
+    args = parser.parse_args()
+    if args.device:
+        show_device()
+    elif args.elf:
+        show_elf(args)
+    else:
+        parser.error('firmware ELF or --device required')
+
+
+if __name__ == '__main__':
+    main()
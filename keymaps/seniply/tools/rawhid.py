@@ -0,0 +1,49 @@
+"""Raw HID transport shared by the seniply host tools.
+
+Requires hidapi bindings: pipx install hid  (or pip install hid)
+"""
+
+import sys
+
+try:
+    import hid
+except ImportError:
+    sys.exit("hidapi bindings missing: pip install hid")
+
+RAW_USAGE_PAGE = 0xFF60  # QMK raw HID interface
+RAW_USAGE = 0x61
+REPORT_SIZE = 32
+
+# Mirrors raw_hid_cmds.h
+RAW_CMD_BOOT = 0x42
+RAW_CMD_DISPLAY = 0x44
+RAW_CMD_KEYMAP = 0x4B
+RAW_CMD_MEMORY = 0x4D
+RAW_CMD_RGB_LOOP = 0x52
+RAW_CMD_TAP_TUNE = 0x54
+RAW_CMD_USB_SOF = 0x55
+RAW_CMD_UNKNOWN = 0xFF
+
+
+class RawHid:
+    def __init__(self, vid=None, pid=None):
+        for info in hid.enumerate(vid or 0, pid or 0):
+            if info["usage_page"] == RAW_USAGE_PAGE and info["usage"] == RAW_USAGE:
+                self.dev = hid.Device(path=info["path"])
+                return
+        sys.exit("No QMK raw HID interface found (is RAW_ENABLE = yes flashed?)")
+
+    def request(self, *payload, timeout_ms=500):
+        """Send one report and return the 32-byte reply."""
+        report = bytes(payload).ljust(REPORT_SIZE, b"\0")
+        # Leading 0 is the report ID expected by hidapi
+        self.dev.write(b"\0" + report)
+        reply = self.dev.read(REPORT_SIZE, timeout_ms)
+        if not reply:
+            sys.exit("Timed out waiting for the keyboard")
+        if reply[0] == RAW_CMD_UNKNOWN:
+            sys.exit(f"Keyboard does not support command {payload[0]:#04x} (older firmware?)")
+        return reply
+
+    def close(self):
+        self.dev.close()
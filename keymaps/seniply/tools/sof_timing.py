@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+"""Show keyboard report timing against the USB frame (usb_sof.c).
+
+Slack is the time from a report to the next SOF, after which the host polls:
+it is the wait a report adds on top of the scan. Scans held to the SOF slot
+keep it at the lead (a narrow peak in the lowest buckets); a free-running
+loop spreads it over the whole frame. --compare measures both modes on the
+same firmware while you type.
+
+Usage: ./sof_timing.py [--reset] [--watch SECONDS] [--aligned on|off]
+       ./sof_timing.py --compare SECONDS
+"""
+
+import argparse
+import time
+
+from rawhid import RawHid, RAW_CMD_USB_SOF
+
+FRAME_US = 1000  # USB_SOF_FRAME_US
+BUCKETS = 8      # USB_SOF_SLACK_BUCKETS
+WIDTH_US = FRAME_US // BUCKETS
+
+
+def fetch(kb, reset=False, aligned=None):
+    flags = (1 if reset else 0) | (0 if aligned is None else 2 | (4 if aligned else 0))
+    reply = kb.request(RAW_CMD_USB_SOF, flags)
+    u16 = lambda i: reply[i] | reply[i + 1] << 8
+    return {
+        "aligned": bool(reply[1] & 1),
+        "sof": bool(reply[1] & 2),
+        "frames": u16(2) | u16(4) << 16,
+        "reports": u16(6),
+        "late": u16(8),
+        "hist": [u16(10 + 2 * i) for i in range(BUCKETS)],
+        "lead_us": u16(26),
+        "scan_report_max_us": u16(28),
+    }
+
+
+def mean_slack(hist):
+    total = sum(hist)
+    return sum((i + 0.5) * WIDTH_US * count for i, count in enumerate(hist)) / total if total else 0
+
+
+def show(stats, label=None):
+    mode = "aligned" if stats["aligned"] else "free-running"
+    if not stats["sof"]:
+        mode += " (no SOFs: suspended or not the USB half)"
+    print(f"{label or mode} | frames {stats['frames']:8d} | reports {stats['reports']:5d}, "
+          f"{stats['late']} late | slack ~{mean_slack(stats['hist']):4.0f} us | "
+          f"lead {stats['lead_us']} us, scan -> report max {stats['scan_report_max_us']} us")
+    total = sum(stats["hist"]) or 1
+    print("  " + " ".join(f"<{(i + 1) * WIDTH_US}us {100 * count / total:5.1f}%"
+                          for i, count in enumerate(stats["hist"])))
+
+
+def compare(kb, seconds):
+    results = []
+    for aligned in (False, True):
+        fetch(kb, reset=True, aligned=aligned)
+        print(f"{'aligned' if aligned else 'free-running'}: type for {seconds:.0f} s...")
+        time.sleep(seconds)
+        results.append(fetch(kb))
+    for stats in results:
+        show(stats)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--reset", action="store_true", help="reset all counters after reading")
+    parser.add_argument("--watch", type=float, metavar="SECONDS", help="poll continuously")
+    parser.add_argument("--aligned", choices=["on", "off"], help="hold scans to the SOF slot or not")
+    parser.add_argument("--compare", type=float, metavar="SECONDS",
+                        help="free-running, then aligned, SECONDS of typing each")
+    args = parser.parse_args()
+
+    kb = RawHid()
+    try:
+        if args.compare:
+            compare(kb, args.compare)
+        else:
+            aligned = None if args.aligned is None else args.aligned == "on"
+            while True:
+                show(fetch(kb, args.reset, aligned))
+                aligned = None
+                if not args.watch:
+                    break
+                time.sleep(args.watch)
+    except KeyboardInterrupt:
+        pass
+    kb.close()
+
+
+if __name__ == "__main__":
+    main()
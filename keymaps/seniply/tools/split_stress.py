@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+"""Run the split stress bench over the stress scripts and link profiles.
+
+Builds the simulator sources around sim/split_sim.c (two halves in lockstep
+over a simulated USART link, checked against a direct replay of the script)
+and runs every script under every link profile. A run fails on a dropped,
+phantom or reordered event (other than one a link timeout held back) or a
+HID key stream that differs from the reference, in every profile, and on a
+p99 latency more than the tolerance
+above the stored baseline (tools/split_stress_baseline.json). The simulator
+runs in virtual time with fixed seeds, so an unchanged tree reproduces the
+baseline exactly; --update stores the current p99s after an intended change.
+
+Usage: ./split_stress.py [-r repeat] [-t tolerance] [--update] [profiles...]
+       (default: every profile, 5 repeats, 10% tolerance)
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SIM_DIR = os.path.join(HERE, '..', 'sim')
+BASELINE = os.path.join(HERE, 'split_stress_baseline.json')
+SCRIPTS = ['basics', 'stress_rolls', 'stress_chords', 'stress_thumbs']
+
+# name: split_sim options. Every profile runs the key timestamp sync
+# (key_timestamps.c, on in the keymap) and the link stress profiles run the
+# pipelined transport, the firmware default (serial_dma.c).
+PROFILES = {
+    'cleo': ['-k'],                           # Keymap config: 460800 baud, short cable, blocking transport
+    'pipelined': ['-k', '-p'],                # Same link, serial_dma.c matrix pipeline
+    'sof': ['-k', '-a', '150'],               # Scans held to the USB frame (usb_sof.c)
+    'latency': ['-k', '-p', '-l', '1000'],    # 1 ms each way (slow or buffered link)
+    'noisy': ['-k', '-p', '-e', '1e-4'],      # Bit errors: CRC failures, 20 ms timeouts
+}
+
+# Gated p99s: edge -> report includes intentional hold-back (layer-tap terms)
+STATS = {'left': 'edge -> event (left)', 'right': 'edge -> event (right)', 'ref': 'report vs reference'}
+
+STAT_RE = re.compile(r'^(edge -> event \(left\)|edge -> event \(right\)|report vs reference)\s.*p99\s+(\d+) us')
+COUNT_RE = re.compile(r'^(events|keys): (.*)$')
+# Counts that are not failures: swaps inside the order window, the reference
+# report count, and events a link timeout delivered late (the HID key stream
+# is still compared against the reference)
+COUNTS_OK = ('simultaneous', 'reference', 'behind a timeout')
+
+
+def run(binary, script, options, repeat):
+    """Return (event sequence matches, p99 by statistic, problem counts) for one run."""
+    args = [binary, '-s', os.path.join(SIM_DIR, 'scripts', script + '.txt'), '-r', str(repeat)] + options
+    result = subprocess.run(args, stdout=subprocess.PIPE, universal_newlines=True)
+    names = {v: k for k, v in STATS.items()}
+    p99 = {}
+    problems = []
+    for line in result.stdout.splitlines():
+        stat = STAT_RE.match(line)
+        if stat:
+            p99[names[stat.group(1)]] = int(stat.group(2))
+        count = COUNT_RE.match(line)
+        if count:
+            problems += [part for part in count.group(2).split(', ')[1:]
+                         if not part.startswith('0 ') and not any(ok in part for ok in COUNTS_OK)]
+    if result.returncode not in (0, 1):
+        sys.exit(f'{" ".join(args)}: exit status {result.returncode}')
+    return result.returncode == 0, p99, problems
+
+
+def load_baseline(repeat):
+    """Baseline p99s by profile and script, empty when missing or taken with another repeat count."""
+    try:
+        with open(BASELINE) as f:
+            baseline = json.load(f)
+    except FileNotFoundError:
+        return {}
+    if baseline.get('repeat') != repeat:
+        print(f'baseline was taken with -r {baseline.get("repeat")}, latency not compared')
+        return {}
+    return baseline['p99']
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('-r', '--repeat', type=int, default=5)
+    parser.add_argument('-t', '--tolerance', type=float, default=0.10, help='allowed p99 rise over the baseline')
+    parser.add_argument('--update', action='store_true', help='store the p99s of this run as the baseline')
+    parser.add_argument('profiles', nargs='*', metavar='profile', help=', '.join(PROFILES))
+    args = parser.parse_args()
+    for profile in args.profiles:
+        if profile not in PROFILES:
+            parser.error(f'unknown profile {profile} (choose from {", ".join(PROFILES)})')
+    args.profiles = args.profiles or list(PROFILES)
+
+    baseline = load_baseline(args.repeat)
+    measured = {}
+    failed = 0
+    with tempfile.TemporaryDirectory() as tmp:
+        binary = os.path.join(tmp, 'split-sim')
+        env = dict(os.environ, SIM_MAIN=os.path.join(SIM_DIR, 'split_sim.c'))
+        subprocess.run([os.path.join(SIM_DIR, 'build.sh'), binary], check=True, env=env)
+
+        print(f'{"profile":<9} {"script":<14} {"left p99":>9} {"right p99":>9} {"vs ref":>9}  result')
+        for profile in args.profiles:
+            for script in SCRIPTS:
+                passed, p99, problems = run(binary, script, PROFILES[profile], args.repeat)
+                measured.setdefault(profile, {})[script] = p99
+                issues = problems if not passed else []
+                reference = baseline.get(profile, {}).get(script, {})
+                for stat, value in p99.items():
+                    limit = reference.get(stat, 0) * (1 + args.tolerance)
+                    if stat in reference and value > limit:
+                        issues.append(f'{stat} p99 {value} us over {limit:.0f} us (baseline {reference[stat]})')
+                result = 'ok' if passed and not issues else 'FAIL'
+                if issues:
+                    result += ': ' + ', '.join(issues)
+                elif not reference:
+                    result += ' (no baseline)'
+                print(f'{profile:<9} {script:<14} ' +
+                      ' '.join(f'{p99.get(s, "-"):>9}' for s in STATS) + f'  {result}')
+                failed += bool(issues) or not passed
+
+    if args.update:
+        stored = {'repeat': args.repeat, 'p99': dict(baseline, **measured)}
+        with open(BASELINE, 'w') as f:
+            json.dump(stored, f, indent=2, sort_keys=True)
+            f.write('\n')
+        print(f'baseline written to {os.path.relpath(BASELINE)}')
+    if failed:
+        sys.exit(f'{failed} run(s) failed')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,56 @@
+#!/usr/bin/env python3
+"""Show the on-device tap/hold histograms and tuned terms (tap_tune.c).
+
+Usage: ./tap_tune_view.py
+"""
+
+from rawhid import RawHid, RAW_CMD_TAP_TUNE
+
+# Slot order mirrors enum tap_tune_slots in keymap.c
+SLOT_NAMES = ["ESC_EXT", "TAB_SYM", "FUN_KEY", "OS_SHFT", "OS_CTRL", "OS_ALT", "OS_GUI", "OS_ALTGR"]
+BIN_MS = 32  # TAP_TUNE_BIN_MS
+BAR_WIDTH = 40
+
+
+def fetch(kb, slot, kind):
+    reply = kb.request(RAW_CMD_TAP_TUNE, slot, kind)
+    if reply[1] == 0xFF:
+        return None
+    slot_count = reply[3]
+    term = reply[4] | reply[5] << 8
+    return slot_count, term, list(reply[6:22])
+
+
+def draw(label, bins):
+    peak = max(max(bins), 1)
+    print(f"  {label} ({sum(bins)} samples)")
+    for i, count in enumerate(bins):
+        edge = f"{i * BIN_MS:3d}-{(i + 1) * BIN_MS - 1:3d}" if i < len(bins) - 1 else f"{i * BIN_MS:3d}+   "
+        print(f"    {edge} ms |{'#' * (count * BAR_WIDTH // peak):<{BAR_WIDTH}}| {count}")
+
+
+def main():
+    kb = RawHid()
+    slot = 0
+    while True:
+        taps = fetch(kb, slot, 0)
+        if taps is None:
+            break
+        slot_count, term, tap_bins = taps
+        _, _, hold_bins = fetch(kb, slot, 1)
+
+        name = SLOT_NAMES[slot] if slot < len(SLOT_NAMES) else f"slot {slot}"
+        short, long = ("double-tap gap", "separate taps") if name == "OS_SHFT" else ("tap", "hold")
+        print(f"{name}: term {f'{term} ms' if term else 'default (not enough samples)'}")
+        draw(short, tap_bins)
+        draw(long, hold_bins)
+        print()
+
+        slot += 1
+        if slot >= slot_count:
+            break
+    kb.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+"""Benchmark the trie.c matcher on synthetic dictionaries (host only).
+
+For each size a dictionary of pseudo-words with adjacent-letter typos is
+compiled with trie_gen.py, the simulator sources are built around
+sim/trie_bench.c, and a text of dictionary words (some mistyped) is fed
+through it. Reports flash bytes per entry and per-keystroke cost.
+
+Usage: ./trie_bench.py [sizes...]   (default: 100 10000)
+"""
+
+import os
+import random
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SIM_DIR = os.path.join(HERE, '..', 'sim')
+
+SYLLABLES = ['ba', 'ce', 'di', 'fo', 'gu', 'ha', 'je', 'ki', 'lo', 'mu', 'na', 'pe', 'qui', 'ro', 'su',
+             'ta', 've', 'wi', 'xo', 'yu', 'ze', 'str', 'th', 'ch', 'sh', 'ent', 'ion', 'ing', 'ous', 'al']
+TEXT_WORDS = 40000
+
+
+def make_dictionary(size, rng):
+    vocabulary = set()
+    while len(vocabulary) < size:
+        vocabulary.add(''.join(rng.choice(SYLLABLES) for _ in range(rng.randint(2, 4))))
+    entries = {}
+    for word in sorted(vocabulary):
+        for _ in range(10):
+            i = rng.randrange(len(word) - 1)
+            typo = word[:i] + word[i + 1] + word[i] + word[i + 2:]
+            if typo != word and typo not in vocabulary and typo not in entries:
+                entries[typo] = word
+                break
+    return entries
+
+
+def make_text(entries, rng):
+    typos = list(entries)
+    words = [rng.choice(typos) if rng.random() < 0.2 else entries[rng.choice(typos)] for _ in range(TEXT_WORDS)]
+    return ' '.join(words) + ' '
+
+
+def run(size, tmp):
+    rng = random.Random(size)
+    entries = make_dictionary(size, rng)
+    dictionary = os.path.join(tmp, f'dict{size}.txt')
+    header = os.path.join(tmp, f'trie{size}.h')
+    text = os.path.join(tmp, f'text{size}.txt')
+    binary = os.path.join(tmp, f'bench{size}')
+
+    with open(dictionary, 'w') as f:
+        f.writelines(f':{typo}: -> {word}\n' for typo, word in entries.items())
+    with open(text, 'w') as f:
+        f.write(make_text(entries, rng))
+
+    subprocess.run([sys.executable, os.path.join(HERE, 'trie_gen.py'), dictionary, '-o', header],
+                   check=True, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    env = dict(os.environ,
+               SIM_MAIN=os.path.join(SIM_DIR, 'trie_bench.c'),
+               SIM_CFLAGS=f'-DTRIE_DATA_H="{header}"')
+    subprocess.run([os.path.join(SIM_DIR, 'build.sh'), binary], check=True, env=env)
+
+    print(f'--- {size} entries')
+    subprocess.run([binary, text], check=True)
+
+
+def main():
+    sizes = [int(arg) for arg in sys.argv[1:]] or [100, 10000]
+    with tempfile.TemporaryDirectory() as tmp:
+        for size in sizes:
+            run(size, tmp)
+
+
+if __name__ == '__main__':
+    main()
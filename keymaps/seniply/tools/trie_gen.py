@@ -0,0 +1,233 @@
+#!/usr/bin/env python3
+"""Generate trie_data.h (flash trie for trie.c) from a dictionary file.
+
+Dictionary lines are `typed -> output`, `#` starts a comment. Typed sequences
+use a-z and ', with `:` marking a word boundary (space, punctuation, start of
+typing) like QMK's autocorrect dictionaries:
+
+    :teh:   -> the        only as a whole word
+    :btw:   -> by the way
+    ouput   -> output     anywhere, fires on the last letter
+
+The trie is an Aho-Corasick automaton: every node has a failure link to the
+longest proper suffix that is also in the trie, and the output of the longest
+entry ending at a node is resolved here, so the keyboard only follows edges.
+
+Usage: trie_gen.py [dictionary] [-o trie_data.h]
+"""
+
+import argparse
+import collections
+import os
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+BOUNDARY = 0  # Symbol for `:`, matches TRIE_BOUNDARY in trie.h
+
+# Typed symbols are HID keycodes (KC_A..KC_Z, KC_QUOT)
+SYMBOLS = {chr(ord('a') + i): 0x04 + i for i in range(26)}
+SYMBOLS["'"] = 0x34
+SYMBOLS[':'] = BOUNDARY
+
+# US layout: output character -> (keycode, shifted)
+ASCII = {chr(ord('a') + i): (0x04 + i, False) for i in range(26)}
+ASCII.update({chr(ord('A') + i): (0x04 + i, True) for i in range(26)})
+ASCII.update({str((i + 1) % 10): (0x1E + i, False) for i in range(10)})
+ASCII.update({c: (0x1E + i, True) for i, c in enumerate('!@#$%^&*()')})
+for plain, shifted, kc in [('\n', None, 0x28), ('\t', None, 0x2B), (' ', None, 0x2C),
+                           ('-', '_', 0x2D), ('=', '+', 0x2E), ('[', '{', 0x2F),
+                           (']', '}', 0x30), ('\\', '|', 0x31), (';', ':', 0x33),
+                           ("'", '"', 0x34), ('`', '~', 0x35), (',', '<', 0x36),
+                           ('.', '>', 0x37), ('/', '?', 0x38)]:
+    ASCII[plain] = (kc, False)
+    if shifted:
+        ASCII[shifted] = (kc, True)
+
+NODE_HAS_OUTPUT = 0x80
+NODE_FAIL_ROOT = 0x40   # Failure link is the root and not stored
+NODE_COUNT_MASK = 0x3F
+OUT_RESEND_TRIGGER = 0x01
+OUT_REPLACES_FIRST = 0x02
+
+
+class Node:
+    def __init__(self, depth):
+        self.depth = depth
+        self.children = {}
+        self.failure = None
+        self.entry = None   # (typed, output) ending exactly here
+        self.output = None  # Longest entry ending here (own or via failure)
+        self.offset = 0
+
+
+def parse(path):
+    entries = []
+    with open(path) as f:
+        for lineno, line in enumerate(f, 1):
+            line = line.split('#', 1)[0].strip()
+            if not line:
+                continue
+            if '->' not in line:
+                sys.exit(f'{path}:{lineno}: expected `typed -> output`')
+            typed, output = (part.strip() for part in line.split('->', 1))
+            bad = [c for c in typed if c not in SYMBOLS] + [c for c in output if c not in ASCII]
+            if bad or not typed.strip(':') or not output:
+                sys.exit(f'{path}:{lineno}: unsupported entry {line!r}')
+            entries.append((typed, output))
+    return entries
+
+
+def build_trie(entries):
+    root = Node(0)
+    nodes = [root]
+    for typed, output in entries:
+        node = root
+        for c in typed:
+            sym = SYMBOLS[c]
+            if sym not in node.children:
+                node.children[sym] = Node(node.depth + 1)
+                nodes.append(node.children[sym])
+            node = node.children[sym]
+        if node.entry:
+            sys.exit(f'duplicate entry {typed!r}')
+        node.entry = (typed, output)
+
+    # Failure links and outputs in BFS order (a failure target is always shallower)
+    order = []
+    queue = collections.deque([root])
+    root.failure = root
+    while queue:
+        node = queue.popleft()
+        order.append(node)
+        node.output = node.entry or (node.failure.output if node is not root else None)
+        for sym, child in sorted(node.children.items()):
+            if node is root:
+                child.failure = root
+            else:
+                fail = node.failure
+                while sym not in fail.children and fail is not root:
+                    fail = fail.failure
+                child.failure = fail.children.get(sym, root)
+            queue.append(child)
+    return root, order
+
+
+def build(entries):
+    # Drop entries that can never fire because a shorter one fires on the way
+    # (e.g. `teh` inside `tehy`), then rebuild without them
+    while True:
+        root, order = build_trie(entries)
+        shadowed = {}
+        for typed, output in entries:
+            node = root
+            for c in typed[:-1]:
+                node = node.children[SYMBOLS[c]]
+                if node.output:
+                    shadowed[typed] = node.output[0]
+                    break
+        if not shadowed:
+            return root, order, entries
+        for typed, by in shadowed.items():
+            print(f'warning: {typed!r} is never reached, {by!r} fires first', file=sys.stderr)
+        entries = [e for e in entries if e[0] not in shadowed]
+
+
+def output_record(typed, output):
+    trailing = typed.endswith(':')
+    letters = typed.strip(':')
+    span = len(typed) - (1 if typed.startswith(':') else 0)
+    # Already on screen when the trigger key is pressed (the trigger itself is consumed)
+    shown = letters if trailing else letters[:-1]
+    keep = 0
+    while keep < min(len(shown), len(output)) and shown[keep] == output[keep]:
+        keep += 1
+    text = output[keep:]
+    flags = (OUT_RESEND_TRIGGER if trailing else 0) | (OUT_REPLACES_FIRST if keep == 0 else 0)
+    if len(shown) - keep > 255 or len(text) > 255 or span > 32:
+        sys.exit(f'entry too long: {typed!r}')
+    record = [len(shown) - keep, flags, span, len(text)]
+    for c in text:
+        kc, shifted = ASCII[c]
+        record.append(kc | (0x80 if shifted else 0))
+    return record
+
+
+def encode(order):
+    records = {}
+    for node in order:
+        if node.output and node.output not in records:
+            records[node.output] = output_record(*node.output)
+
+    for width in (2, 3):
+        pos = 0
+        for node in order:
+            node.offset = pos
+            pos += 1 + (0 if node.failure is order[0] else width)
+            pos += (width if node.output else 0) + len(node.children) * (1 + width)
+        record_offsets = {}
+        for key, record in records.items():
+            record_offsets[key] = pos
+            pos += len(record)
+        if pos < (1 << (8 * width)):
+            break
+    else:
+        sys.exit('dictionary too large')
+
+    def offset(value):
+        return list(value.to_bytes(width, 'little'))
+
+    data = []
+    for node in order:
+        if len(node.children) > NODE_COUNT_MASK:
+            sys.exit('too many children')
+        fail_root = node.failure is order[0]
+        data.append(len(node.children) | (NODE_HAS_OUTPUT if node.output else 0) | (NODE_FAIL_ROOT if fail_root else 0))
+        if not fail_root:
+            data += offset(node.failure.offset)
+        if node.output:
+            data += offset(record_offsets[node.output])
+        children = sorted(node.children.items())
+        data += [sym for sym, _ in children]
+        for _, child in children:
+            data += offset(child.offset)
+    for record in records.values():
+        data += record
+    return data, width
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('dictionary', nargs='?', default=os.path.join(HERE, 'trie_dict.txt'))
+    parser.add_argument('-o', '--output', default=os.path.normpath(os.path.join(HERE, '..', 'trie_data.h')))
+    args = parser.parse_args()
+
+    entries = parse(args.dictionary)
+    root, order, kept = build(entries)
+    data, width = encode(order)
+    depth = max(node.depth for node in order)
+
+    lines = [
+        f'// Generated by tools/trie_gen.py from {os.path.basename(args.dictionary)}, do not edit',
+        f'// {len(kept)} entries, {len(order)} nodes, {len(data)} bytes',
+        '#pragma once',
+        '',
+        f'#define TRIE_ENTRIES {len(kept)}',
+        f'#define TRIE_NODES {len(order)}',
+        f'#define TRIE_OFFSET_BYTES {width}',
+        f'#define TRIE_MAX_DEPTH {depth}',
+        f'#define TRIE_DATA_SIZE {len(data)}',
+        '',
+        'static const uint8_t trie_data[TRIE_DATA_SIZE] PROGMEM = {',
+    ]
+    for i in range(0, len(data), 16):
+        lines.append('    ' + ' '.join(f'0x{b:02X},' for b in data[i:i + 16]))
+    lines.append('};')
+    with open(args.output, 'w') as f:
+        f.write('\n'.join(lines) + '\n')
+    print(f'{args.output}: {len(kept)} entries, {len(order)} nodes, {len(data)} bytes '
+          f'({len(data) / max(len(kept), 1):.1f} bytes/entry), depth {depth}')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,314 @@
+#include "trie.h"
+
+#ifndef TRIE_DATA_H
+#define TRIE_DATA_H "trie_data.h"  // Overridden by the host benchmark
+#endif
+#include TRIE_DATA_H
+
+_Static_assert(TRIE_MAX_DEPTH <= 32, "Dictionary keys longer than the 32-bit case mask");
+
+// ============================================================================
+// FLASH LAYOUT (tools/trie_gen.py)
+// ============================================================================
+// Node:   header, [failure], [output], labels[count], children[count]
+//         header = count | NODE_FAIL_ROOT | NODE_HAS_OUTPUT, labels sorted,
+//         offsets are TRIE_OFFSET_BYTES little-endian byte offsets
+// Output: backspaces, flags, span (keys after the leading boundary),
+//         length, keycodes[length] (bit 7 = shifted)
+
+#define NODE_COUNT_MASK 0x3F
+#define NODE_FAIL_ROOT 0x40
+#define NODE_HAS_OUTPUT 0x80
+
+#define OUT_RESEND_TRIGGER 0x01  // Trigger was a boundary key: send it after the expansion
+#define OUT_REPLACES_FIRST 0x02  // Expansion retypes the first letter of the match
+#define OUT_SHIFT 0x80
+
+static uint8_t read_byte(uint32_t pos) {
+    return pgm_read_byte(&trie_data[pos]);
+}
+
+static uint32_t read_offset(uint32_t pos) {
+    uint32_t value = read_byte(pos) | (uint32_t)read_byte(pos + 1) << 8;
+#if TRIE_OFFSET_BYTES > 2
+    value |= (uint32_t)read_byte(pos + 2) << 16;
+#endif
+    return value;
+}
+
+static uint32_t node_output_pos(trie_node_t node, uint8_t header) {
+    return node + 1 + ((header & NODE_FAIL_ROOT) ? 0 : TRIE_OFFSET_BYTES);
+}
+
+trie_node_t trie_step(trie_node_t node, uint8_t symbol) {
+    for (;;) {
+        uint8_t header = read_byte(node);
+        uint8_t count = header & NODE_COUNT_MASK;
+        uint32_t labels = node_output_pos(node, header) + ((header & NODE_HAS_OUTPUT) ? TRIE_OFFSET_BYTES : 0);
+
+        for (uint8_t i = 0; i < count; i++) {
+            uint8_t label = read_byte(labels + i);
+            if (label == symbol) {
+                return read_offset(labels + count + i * TRIE_OFFSET_BYTES);
+            }
+            if (label > symbol) {
+                break;
+            }
+        }
+        if (node == TRIE_ROOT) {
+            return TRIE_ROOT;
+        }
+        // Failure links only get shallower: at most TRIE_MAX_DEPTH hops
+        node = (header & NODE_FAIL_ROOT) ? TRIE_ROOT : read_offset(node + 1);
+    }
+}
+
+bool trie_has_output(trie_node_t node) {
+    return read_byte(node) & NODE_HAS_OUTPUT;
+}
+
+// ============================================================================
+// MATCHER STATE
+// ============================================================================
+// history: node before each recent keystroke, so backspace steps back
+// shifted: bit per keystroke (bit 0 = most recent), for the expansion's case
+
+static trie_node_t state = TRIE_ROOT;
+static trie_node_t history[TRIE_HISTORY];
+static uint8_t history_head = 0;
+static uint8_t history_len = 0;
+static uint32_t shifted = 0;
+static bool enabled = true;
+
+static void matcher_reset(bool boundary) {
+    // After a boundary, `:word` entries can match from the next letter
+    state = boundary ? trie_step(TRIE_ROOT, TRIE_BOUNDARY) : TRIE_ROOT;
+    history_len = 0;
+    shifted = 0;
+}
+
+static void matcher_push(uint8_t symbol, bool is_shifted) {
+    history[history_head] = state;
+    history_head = (history_head + 1) % TRIE_HISTORY;
+    if (history_len < TRIE_HISTORY) {
+        history_len++;
+    }
+    shifted = (shifted << 1) | is_shifted;
+    state = trie_step(state, symbol);
+}
+
+static void matcher_pop(void) {
+    if (history_len == 0) {
+        matcher_reset(false);  // Deleting into text we never saw
+        return;
+    }
+    history_head = (history_head + TRIE_HISTORY - 1) % TRIE_HISTORY;
+    history_len--;
+    shifted >>= 1;
+    state = history[history_head];
+}
+
+// ============================================================================
+// OUTPUT QUEUE
+// ============================================================================
+// Backspaces, then the expansion read straight from flash, then the trigger
+// key. One press or release per TRIE_OUTPUT_INTERVAL, from trie_task(), then
+// the key events that arrived meanwhile.
+
+enum { CASE_AS_IS, CASE_FIRST, CASE_ALL };
+
+static struct {
+    uint32_t text;       // Next expansion byte in trie_data
+    uint8_t remaining;   // Expansion bytes left
+    uint8_t backspaces;
+    uint8_t case_mode;
+    bool first;          // Next expansion byte is the first one
+    uint16_t trigger;    // Sent after the expansion, KC_NO if none
+    uint16_t down;       // Keycode currently pressed, KC_NO if none
+    uint16_t last_event;
+} output;
+
+static uint16_t next_keycode(void) {
+    if (output.backspaces) {
+        output.backspaces--;
+        return KC_BSPC;
+    }
+    if (output.remaining) {
+        uint8_t byte = read_byte(output.text++);
+        uint8_t keycode = byte & ~OUT_SHIFT;
+        bool shift = byte & OUT_SHIFT;
+        if (keycode >= KC_A && keycode <= KC_Z) {
+            shift |= output.case_mode == CASE_ALL || (output.case_mode == CASE_FIRST && output.first);
+        }
+        output.remaining--;
+        output.first = false;
+        return shift ? LSFT(keycode) : keycode;
+    }
+    uint16_t trigger = output.trigger;
+    output.trigger = KC_NO;
+    return trigger;
+}
+
+// Returns false when the queue is empty
+static bool send_next_event(void) {
+    if (output.down != KC_NO) {
+        unregister_code16(output.down);
+        output.down = KC_NO;
+    } else {
+        uint16_t keycode = next_keycode();
+        if (keycode == KC_NO) {
+            return false;
+        }
+        register_code16(keycode);
+        output.down = keycode;
+    }
+    output.last_event = timer_read();
+    return true;
+}
+
+static bool output_idle(void) {
+    return output.down == KC_NO && !output.backspaces && !output.remaining && output.trigger == KC_NO;
+}
+
+static keyevent_t deferred[TRIE_DEFERRED_EVENTS];
+static uint8_t deferred_head = 0;
+static uint8_t deferred_count = 0;
+static bool replaying = false;
+
+// Held back events until one starts a new expansion
+static void replay_deferred(void) {
+    while (deferred_count && output_idle()) {
+        keyevent_t event = deferred[deferred_head];
+        deferred_head = (deferred_head + 1) % TRIE_DEFERRED_EVENTS;
+        deferred_count--;
+        replaying = true;
+        action_exec(event);
+        replaying = false;
+    }
+}
+
+void trie_task(void) {
+    if (timer_elapsed(output.last_event) >= TRIE_OUTPUT_INTERVAL && !send_next_event()) {
+        replay_deferred();
+    }
+}
+
+void trie_catch_up(void) {
+    while (send_next_event()) {
+    }
+}
+
+bool trie_defer(keyrecord_t *record) {
+    if (replaying || (output_idle() && !deferred_count)) {
+        return true;
+    }
+    if (deferred_count == TRIE_DEFERRED_EVENTS) {
+        // Typing far ahead of the output: send it without the interval
+        // rather than drop or reorder keys
+        do {
+            trie_catch_up();
+            replay_deferred();
+        } while (deferred_count);
+        return true;
+    }
+    deferred[(deferred_head + deferred_count) % TRIE_DEFERRED_EVENTS] = record->event;
+    deferred_count++;
+    return false;
+}
+
+static void start_output(uint32_t record, uint16_t trigger) {
+    uint8_t flags = read_byte(record + 1);
+    uint8_t span = read_byte(record + 2);
+
+    // Case of the typed letters (the boundary trigger, if any, is bit 0)
+    uint8_t letters = span - ((flags & OUT_RESEND_TRIGGER) ? 1 : 0);
+    uint32_t mask = (letters >= 32) ? UINT32_MAX : ((uint32_t)1 << letters) - 1;
+    uint32_t letter_shift = (shifted >> (span - letters)) & mask;
+
+    output.case_mode = CASE_AS_IS;
+    if (letters > 1 && letter_shift == mask) {
+        output.case_mode = CASE_ALL;
+    } else if ((flags & OUT_REPLACES_FIRST) && (letter_shift >> (letters - 1)) & 1) {
+        output.case_mode = CASE_FIRST;
+    }
+
+    output.backspaces = read_byte(record);
+    output.remaining = read_byte(record + 3);
+    output.text = record + 4;
+    output.first = true;
+    output.trigger = (flags & OUT_RESEND_TRIGGER) ? trigger : KC_NO;
+
+    // Caps word shift for the consumed trigger must not leak into the output
+    clear_weak_mods();
+    matcher_reset(flags & OUT_RESEND_TRIGGER);
+}
+
+// ============================================================================
+// KEY PROCESSING
+// ============================================================================
+
+void trie_toggle(void) {
+    enabled = !enabled;
+    matcher_reset(false);
+}
+
+bool trie_is_enabled(void) {
+    return enabled;
+}
+
+bool process_trie(uint16_t keycode, keyrecord_t *record) {
+    if (!enabled || !record->event.pressed || is_trie_ignored_key(keycode)) {
+        return true;
+    }
+    if (IS_QK_LAYER_TAP(keycode)) {
+        if (record->tap.count == 0) {
+            return true;  // Layer hold
+        }
+        keycode = QK_LAYER_TAP_GET_TAP_KEYCODE(keycode);
+    }
+
+    uint8_t mods = get_mods();
+    uint16_t trigger = keycode;
+    bool shift = mods & MOD_MASK_SHIFT;
+    if (IS_QK_MODS(keycode) && QK_MODS_GET_MODS(keycode) == MOD_LSFT) {
+        shift = true;
+        keycode = QK_MODS_GET_BASIC_KEYCODE(keycode);
+    }
+
+    // Shortcuts and non-typing keys leave the word
+    if ((mods & ~MOD_MASK_SHIFT) || keycode > 0xFF) {
+        matcher_reset(false);
+        return true;
+    }
+
+    uint8_t symbol;
+    switch (keycode) {
+        case KC_A ... KC_Z:
+            symbol = keycode;
+            shift |= is_caps_word_on();
+            break;
+        case KC_QUOT:
+            symbol = shift ? TRIE_BOUNDARY : KC_QUOT;  // " is punctuation
+            break;
+        case KC_BSPC:
+            matcher_pop();
+            return true;
+        case KC_1 ... KC_0:
+        case KC_TAB ... KC_SCLN:
+        case KC_GRV ... KC_SLSH:
+            symbol = TRIE_BOUNDARY;
+            break;
+        default:
+            matcher_reset(false);
+            return true;
+    }
+
+    matcher_push(symbol, shift);
+    if (!trie_has_output(state) || mods) {
+        return true;  // No match, or shift held on the trigger key: type it as is
+    }
+
+    uint8_t header = read_byte(state);
+    start_output(read_offset(node_output_pos(state, header)), trigger);
+    return false;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Typed-sequence expansion and autocorrect from a flash trie
+// tools/trie_gen.py compiles tools/trie_dict.txt into trie_data.h, an
+// Aho-Corasick automaton over keycodes: the matcher keeps its current node
+// and every keystroke is one transition (a scan of at most 28 sorted edge
+// labels, plus failure links bounded by TRIE_MAX_DEPTH), independent of the
+// number of entries. No typed-text buffer is searched.
+//
+// A match consumes the trigger key and queues backspaces and the expansion,
+// which trie_task() sends one key event per TRIE_OUTPUT_INTERVAL instead of
+// blocking in tap_code. Key events that arrive meanwhile are held back and
+// replayed through action_exec() once the queue is sent, so they keep their
+// order without key processing ever waiting. Case follows what was typed: a
+// capitalised first letter capitalises the expansion, all-caps (shift or
+// caps word) makes it all-caps.
+//
+// Esc and Enter reset the matcher rather than end a word, so a modal editor
+// command typed after them is never taken for the start of an entry.
+// trie_toggle() (TR_TOGG in the keymap) turns matching off and on at run
+// time, not saved.
+
+#ifndef TRIE_OUTPUT_INTERVAL
+#define TRIE_OUTPUT_INTERVAL 1  // ms between queued key events
+#endif
+
+#ifndef TRIE_DEFERRED_EVENTS
+#define TRIE_DEFERRED_EVENTS 16  // Key events held back while the queue sends
+#endif
+
+#ifndef TRIE_HISTORY
+#define TRIE_HISTORY 16  // Keystrokes that backspace can step back over
+#endif
+
+#define TRIE_ROOT 0
+#define TRIE_BOUNDARY 0  // Symbol for word boundaries (`:` in the dictionary)
+
+typedef uint32_t trie_node_t;  // Byte offset into trie_data
+
+// Matcher core (also used by the host benchmark)
+trie_node_t trie_step(trie_node_t node, uint8_t symbol);
+bool trie_has_output(trie_node_t node);
+
+// Call from process_record_user. Returns false when the key triggered an
+// expansion and was consumed.
+bool process_trie(uint16_t keycode, keyrecord_t *record);
+
+void trie_toggle(void);
+bool trie_is_enabled(void);
+
+// Send the next queued key event, or replay held back key events once the
+// queue is empty (call every main loop iteration)
+void trie_task(void);
+
+// Call from pre_process_record_user, after anything that rewrites the event.
+// Returns false when the event was held back behind the queue.
+bool trie_defer(keyrecord_t *record);
+
+// Call first in process_record_user. Events replayed from QMK's tapping
+// buffer passed pre_process_record_user before the queue was started, so
+// they cannot be held back: the queue is sent at once ahead of them.
+void trie_catch_up(void);
+
+// To be implemented by the consumer. Keys that neither feed nor reset the
+// matcher (layer and oneshot keys).
+bool is_trie_ignored_key(uint16_t keycode);
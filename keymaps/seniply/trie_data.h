@@ -0,0 +1,148 @@
+// Generated by tools/trie_gen.py from trie_dict.txt, do not edit
+// 69 entries, 353 nodes, 2172 bytes
+#pragma once
+
+#define TRIE_ENTRIES 69
+#define TRIE_NODES 353
+#define TRIE_OFFSET_BYTES 2
+#define TRIE_MAX_DEPTH 12
+#define TRIE_DATA_SIZE 2172
+
+static const uint8_t trie_data[TRIE_DATA_SIZE] PROGMEM = {
+    0x41, 0x00, 0x04, 0x00, 0x52, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0B, 0x0C, 0x0F, 0x11, 0x12,
+    0x13, 0x15, 0x16, 0x17, 0x18, 0x1A, 0x1C, 0x3B, 0x00, 0x4B, 0x00, 0x52, 0x00, 0x56, 0x00, 0x60,
+    0x00, 0x67, 0x00, 0x6E, 0x00, 0x75, 0x00, 0x82, 0x00, 0x8C, 0x00, 0x93, 0x00, 0x9A, 0x00, 0xA1,
+    0x00, 0xA5, 0x00, 0xAF, 0x00, 0xC2, 0x00, 0xC6, 0x00, 0xD6, 0x00, 0x45, 0x06, 0x07, 0x09, 0x0F,
+    0x15, 0xDA, 0x00, 0xE1, 0x00, 0xE8, 0x00, 0xEC, 0x00, 0xF0, 0x00, 0x42, 0x08, 0x17, 0xF4, 0x00,
+    0xFE, 0x00, 0x41, 0x12, 0x02, 0x01, 0x43, 0x08, 0x0C, 0x12, 0x09, 0x01, 0x10, 0x01, 0x14, 0x01,
+    0x42, 0x11, 0x1B, 0x1B, 0x01, 0x1F, 0x01, 0x42, 0x15, 0x18, 0x23, 0x01, 0x27, 0x01, 0x42, 0x08,
+    0x17, 0x2E, 0x01, 0x32, 0x01, 0x44, 0x0C, 0x10, 0x11, 0x16, 0x36, 0x01, 0x3A, 0x01, 0x41, 0x01,
+    0x45, 0x01, 0x43, 0x04, 0x08, 0x0A, 0x49, 0x01, 0x4D, 0x01, 0x51, 0x01, 0x42, 0x04, 0x08, 0x55,
+    0x01, 0x59, 0x01, 0x42, 0x06, 0x18, 0x5D, 0x01, 0x61, 0x01, 0x42, 0x04, 0x15, 0x65, 0x01, 0x69,
+    0x01, 0x41, 0x08, 0x6D, 0x01, 0x43, 0x08, 0x0B, 0x17, 0x7A, 0x01, 0x7E, 0x01, 0x82, 0x01, 0x46,
+    0x04, 0x05, 0x08, 0x0B, 0x12, 0x15, 0x89, 0x01, 0x8D, 0x01, 0x91, 0x01, 0x95, 0x01, 0x9C, 0x01,
+    0xA0, 0x01, 0x41, 0x11, 0xA4, 0x01, 0x45, 0x04, 0x0B, 0x0C, 0x12, 0x15, 0xA8, 0x01, 0xAF, 0x01,
+    0xB3, 0x01, 0xC0, 0x01, 0xC4, 0x01, 0x41, 0x12, 0xC8, 0x01, 0x42, 0x06, 0x0B, 0xCC, 0x01, 0xD0,
+    0x01, 0x42, 0x11, 0x15, 0xD4, 0x01, 0xD8, 0x01, 0x41, 0x04, 0xDC, 0x01, 0x41, 0x12, 0xE0, 0x01,
+    0x41, 0x0A, 0xE4, 0x01, 0x43, 0x04, 0x06, 0x0F, 0xE8, 0x01, 0xEC, 0x01, 0xF3, 0x01, 0x41, 0x1A,
+    0xF7, 0x01, 0x42, 0x10, 0x18, 0xFB, 0x01, 0xFF, 0x01, 0x42, 0x09, 0x13, 0x03, 0x02, 0x07, 0x02,
+    0x41, 0x07, 0x0B, 0x02, 0x42, 0x08, 0x11, 0x0F, 0x02, 0x13, 0x02, 0x41, 0x19, 0x17, 0x02, 0x41,
+    0x0C, 0x1B, 0x02, 0x41, 0x08, 0x1F, 0x02, 0x42, 0x06, 0x11, 0x23, 0x02, 0x27, 0x02, 0x41, 0x0C,
+    0x2B, 0x02, 0x41, 0x08, 0x2F, 0x02, 0x41, 0x15, 0x33, 0x02, 0x42, 0x12, 0x13, 0x37, 0x02, 0x3B,
+    0x02, 0x41, 0x07, 0x3F, 0x02, 0x41, 0x11, 0x43, 0x02, 0x41, 0x05, 0x47, 0x02, 0x41, 0x11, 0x4B,
+    0x02, 0x41, 0x17, 0x4F, 0x02, 0x41, 0x07, 0x53, 0x02, 0x41, 0x06, 0x57, 0x02, 0x41, 0x06, 0x5B,
+    0x02, 0x41, 0x13, 0x5F, 0x02, 0x41, 0x15, 0x66, 0x02, 0x41, 0x0C, 0x6A, 0x02, 0x44, 0x06, 0x09,
+    0x17, 0x18, 0x6E, 0x02, 0x72, 0x02, 0x76, 0x02, 0x7A, 0x02, 0x41, 0x13, 0x7E, 0x02, 0x41, 0x12,
+    0x82, 0x02, 0x42, 0x0C, 0x15, 0x86, 0x02, 0x8A, 0x02, 0x41, 0x0B, 0x8E, 0x02, 0x41, 0x0B, 0x92,
+    0x02, 0x41, 0x0B, 0x96, 0x02, 0x42, 0x04, 0x0C, 0x9A, 0x02, 0x9E, 0x02, 0x41, 0x10, 0xA2, 0x02,
+    0x41, 0x18, 0xA6, 0x02, 0x41, 0x17, 0xAA, 0x02, 0x42, 0x0B, 0x16, 0xAE, 0x02, 0xB2, 0x02, 0x41,
+    0x0C, 0xB6, 0x02, 0x44, 0x06, 0x07, 0x08, 0x0B, 0xBD, 0x02, 0xC1, 0x02, 0xC5, 0x02, 0xC9, 0x02,
+    0x41, 0x18, 0xCD, 0x02, 0x41, 0x17, 0xD1, 0x02, 0x41, 0x18, 0xD5, 0x02, 0x41, 0x15, 0xD9, 0x02,
+    0x41, 0x08, 0xDD, 0x02, 0x41, 0x00, 0xE1, 0x02, 0x41, 0x08, 0xE6, 0x02, 0x41, 0x0C, 0xEA, 0x02,
+    0x41, 0x17, 0xEE, 0x02, 0x41, 0x18, 0xF2, 0x02, 0x41, 0x06, 0xF6, 0x02, 0x42, 0x04, 0x18, 0xFA,
+    0x02, 0xFE, 0x02, 0x41, 0x08, 0x02, 0x03, 0x41, 0x00, 0x06, 0x03, 0x41, 0x10, 0x0B, 0x03, 0x41,
+    0x07, 0x0F, 0x03, 0x41, 0x0C, 0x13, 0x03, 0x41, 0x08, 0x17, 0x03, 0x41, 0x11, 0x1B, 0x03, 0x41,
+    0x16, 0x1F, 0x03, 0x41, 0x17, 0x23, 0x03, 0x41, 0x0C, 0x27, 0x03, 0x41, 0x16, 0x2B, 0x03, 0x41,
+    0x0C, 0x2F, 0x03, 0x41, 0x11, 0x33, 0x03, 0x41, 0x06, 0x37, 0x03, 0x41, 0x0A, 0x3B, 0x03, 0x41,
+    0x00, 0x3F, 0x03, 0x41, 0x06, 0x44, 0x03, 0x41, 0x00, 0x48, 0x03, 0x41, 0x15, 0x4D, 0x03, 0x41,
+    0x08, 0x51, 0x03, 0x41, 0x17, 0x55, 0x03, 0x41, 0x0F, 0x59, 0x03, 0x41, 0x0A, 0x5D, 0x03, 0x41,
+    0x10, 0x61, 0x03, 0x41, 0x00, 0x65, 0x03, 0x41, 0x06, 0x6A, 0x03, 0x41, 0x18, 0x6E, 0x03, 0x42,
+    0x17, 0x18, 0x72, 0x03, 0x76, 0x03, 0x41, 0x04, 0x7A, 0x03, 0x41, 0x17, 0x7E, 0x03, 0x41, 0x0C,
+    0x82, 0x03, 0x41, 0x15, 0x86, 0x03, 0x41, 0x15, 0x8A, 0x03, 0x41, 0x17, 0x8E, 0x03, 0x41, 0x08,
+    0x92, 0x03, 0x41, 0x18, 0x96, 0x03, 0x41, 0x15, 0x9A, 0x03, 0x41, 0x0C, 0x9E, 0x03, 0x41, 0x17,
+    0xA2, 0x03, 0x41, 0x00, 0xA6, 0x03, 0x41, 0x00, 0xAB, 0x03, 0x41, 0x17, 0xB0, 0x03, 0x41, 0x08,
+    0xB4, 0x03, 0x41, 0x10, 0xB8, 0x03, 0x41, 0x08, 0xBC, 0x03, 0x41, 0x0C, 0xC0, 0x03, 0x41, 0x17,
+    0xC4, 0x03, 0x41, 0x11, 0xC8, 0x03, 0x42, 0x0B, 0x17, 0xCC, 0x03, 0xD0, 0x03, 0x41, 0x0B, 0xD4,
+    0x03, 0x41, 0x0B, 0xD8, 0x03, 0x41, 0x15, 0xDC, 0x03, 0x41, 0x17, 0xE0, 0x03, 0x41, 0x07, 0xE4,
+    0x03, 0x41, 0x00, 0xE8, 0x03, 0x41, 0x15, 0xED, 0x03, 0x41, 0x12, 0xF1, 0x03, 0x41, 0x0C, 0xF5,
+    0x03, 0x80, 0x04, 0x00, 0x3D, 0x06, 0x41, 0x16, 0xF9, 0x03, 0x41, 0x0E, 0xFD, 0x03, 0x41, 0x00,
+    0x01, 0x04, 0x41, 0x08, 0x06, 0x04, 0x41, 0x18, 0x0A, 0x04, 0x41, 0x16, 0x0E, 0x04, 0x41, 0x04,
+    0x12, 0x04, 0x41, 0x0C, 0x16, 0x04, 0x80, 0x04, 0x00, 0x43, 0x06, 0x41, 0x0C, 0x1A, 0x04, 0x41,
+    0x0F, 0x1E, 0x04, 0x41, 0x11, 0x21, 0x04, 0x41, 0x11, 0x25, 0x04, 0x41, 0x17, 0x29, 0x04, 0x41,
+    0x11, 0x2D, 0x04, 0x41, 0x00, 0x31, 0x04, 0x41, 0x15, 0x36, 0x04, 0x41, 0x17, 0x3A, 0x04, 0x41,
+    0x11, 0x3E, 0x04, 0x41, 0x17, 0x42, 0x04, 0x41, 0x0C, 0x46, 0x04, 0x41, 0x17, 0x4A, 0x04, 0x80,
+    0x04, 0x00, 0x50, 0x06, 0x41, 0x00, 0x4E, 0x04, 0x80, 0x04, 0x00, 0x57, 0x06, 0x41, 0x12, 0x53,
+    0x04, 0x41, 0x13, 0x57, 0x04, 0x41, 0x00, 0x5B, 0x04, 0x41, 0x08, 0x60, 0x04, 0x41, 0x0B, 0x63,
+    0x04, 0x41, 0x00, 0x67, 0x04, 0x80, 0x04, 0x00, 0x67, 0x06, 0x41, 0x08, 0x6C, 0x04, 0x41, 0x15,
+    0x70, 0x04, 0x41, 0x18, 0x74, 0x04, 0x41, 0x17, 0x78, 0x04, 0x41, 0x10, 0x7B, 0x04, 0x41, 0x11,
+    0x82, 0x04, 0x41, 0x08, 0x85, 0x04, 0x41, 0x08, 0x89, 0x04, 0x41, 0x18, 0x8D, 0x04, 0x41, 0x15,
+    0x91, 0x04, 0x41, 0x15, 0x95, 0x04, 0x41, 0x07, 0x99, 0x04, 0x41, 0x11, 0x9D, 0x04, 0x41, 0x0A,
+    0xA1, 0x04, 0x41, 0x00, 0xA5, 0x04, 0x80, 0x04, 0x00, 0x6E, 0x06, 0x80, 0x04, 0x00, 0x7D, 0x06,
+    0x41, 0x16, 0xAA, 0x04, 0x41, 0x15, 0xAE, 0x04, 0x41, 0x12, 0xB1, 0x04, 0x41, 0x0F, 0xB5, 0x04,
+    0x41, 0x0F, 0xB9, 0x04, 0x41, 0x00, 0xBD, 0x04, 0x41, 0x17, 0xC2, 0x04, 0x41, 0x06, 0xC6, 0x04,
+    0x41, 0x00, 0xC9, 0x04, 0x41, 0x00, 0xCE, 0x04, 0x41, 0x17, 0xD3, 0x04, 0x41, 0x07, 0xD6, 0x04,
+    0x41, 0x00, 0xD9, 0x04, 0x41, 0x0F, 0xDE, 0x04, 0x80, 0x04, 0x00, 0x83, 0x06, 0x41, 0x08, 0xE1,
+    0x04, 0x41, 0x16, 0xE5, 0x04, 0x41, 0x19, 0xE9, 0x04, 0x41, 0x16, 0xED, 0x04, 0x41, 0x00, 0xF0,
+    0x04, 0x80, 0x04, 0x00, 0x95, 0x06, 0x41, 0x10, 0xF5, 0x04, 0x41, 0x16, 0xF9, 0x04, 0x41, 0x18,
+    0xFD, 0x04, 0x41, 0x16, 0x01, 0x05, 0x41, 0x19, 0x05, 0x05, 0x41, 0x11, 0x09, 0x05, 0xC0, 0x9D,
+    0x06, 0x41, 0x04, 0x0D, 0x05, 0x41, 0x07, 0x11, 0x05, 0x41, 0x00, 0x15, 0x05, 0x41, 0x17, 0x1A,
+    0x05, 0x80, 0x04, 0x00, 0xA3, 0x06, 0x41, 0x12, 0x1E, 0x05, 0x41, 0x04, 0x22, 0x05, 0x41, 0x07,
+    0x26, 0x05, 0x41, 0x0C, 0x29, 0x05, 0x41, 0x17, 0x2D, 0x05, 0x41, 0x0B, 0x31, 0x05, 0x80, 0x04,
+    0x00, 0xA9, 0x06, 0x41, 0x17, 0x34, 0x05, 0x41, 0x08, 0x37, 0x05, 0x80, 0x04, 0x00, 0xC3, 0x06,
+    0xC0, 0xC9, 0x06, 0x41, 0x17, 0x3B, 0x05, 0x80, 0x04, 0x00, 0xCF, 0x06, 0x41, 0x16, 0x3E, 0x05,
+    0x41, 0x08, 0x42, 0x05, 0x41, 0x17, 0x46, 0x05, 0xC0, 0xE2, 0x06, 0x42, 0x04, 0x17, 0x49, 0x05,
+    0x4D, 0x05, 0xC0, 0xEA, 0x06, 0x41, 0x19, 0x51, 0x05, 0x41, 0x11, 0x55, 0x05, 0x41, 0x11, 0x59,
+    0x05, 0x41, 0x11, 0x5C, 0x05, 0x41, 0x04, 0x5F, 0x05, 0x41, 0x0F, 0x63, 0x05, 0x41, 0x0A, 0x66,
+    0x05, 0x41, 0x11, 0x69, 0x05, 0x80, 0x04, 0x00, 0xF0, 0x06, 0x41, 0x00, 0x6C, 0x05, 0xC0, 0xF7,
+    0x06, 0x41, 0x15, 0x71, 0x05, 0x41, 0x1C, 0x75, 0x05, 0x41, 0x0F, 0x78, 0x05, 0x80, 0x04, 0x00,
+    0xFE, 0x06, 0x41, 0x00, 0x7C, 0x05, 0xC0, 0x05, 0x07, 0x80, 0x04, 0x00, 0x0B, 0x07, 0x80, 0x04,
+    0x00, 0x12, 0x07, 0xC0, 0x1A, 0x07, 0xC0, 0x20, 0x07, 0x80, 0x04, 0x00, 0x28, 0x07, 0xC0, 0x2E,
+    0x07, 0x41, 0x00, 0x81, 0x05, 0x41, 0x16, 0x86, 0x05, 0x41, 0x08, 0x89, 0x05, 0xC0, 0x34, 0x07,
+    0x80, 0x04, 0x00, 0x3D, 0x07, 0x41, 0x08, 0x8C, 0x05, 0x41, 0x08, 0x90, 0x05, 0x41, 0x08, 0x93,
+    0x05, 0x41, 0x08, 0x96, 0x05, 0x41, 0x08, 0x99, 0x05, 0x41, 0x0A, 0x9C, 0x05, 0x41, 0x17, 0x9F,
+    0x05, 0x41, 0x04, 0xA3, 0x05, 0x80, 0x04, 0x00, 0x50, 0x07, 0x41, 0x00, 0xA7, 0x05, 0x41, 0x10,
+    0xAC, 0x05, 0x41, 0x11, 0xB0, 0x05, 0xC0, 0x56, 0x07, 0x41, 0x12, 0xB4, 0x05, 0x41, 0x12, 0xB8,
+    0x05, 0xC0, 0x5E, 0x07, 0xC0, 0x64, 0x07, 0x41, 0x11, 0xBC, 0x05, 0xC0, 0x6B, 0x07, 0x41, 0x16,
+    0xC0, 0x05, 0x41, 0x07, 0xC4, 0x05, 0xC0, 0x71, 0x07, 0x41, 0x17, 0xC7, 0x05, 0x41, 0x08, 0xCB,
+    0x05, 0x41, 0x08, 0xCF, 0x05, 0x41, 0x06, 0xD2, 0x05, 0xC0, 0x79, 0x07, 0xC0, 0x80, 0x07, 0x41,
+    0x17, 0xD6, 0x05, 0xC0, 0x88, 0x07, 0xC0, 0x8E, 0x07, 0xC0, 0x96, 0x07, 0x80, 0x04, 0x00, 0x9C,
+    0x07, 0x41, 0x12, 0xD9, 0x05, 0xC0, 0xA2, 0x07, 0x41, 0x00, 0xDD, 0x05, 0x80, 0x04, 0x00, 0xA8,
+    0x07, 0x80, 0x04, 0x00, 0xAE, 0x07, 0xC0, 0xB5, 0x07, 0xC0, 0xBD, 0x07, 0x41, 0x11, 0xE2, 0x05,
+    0xC0, 0xC5, 0x07, 0xC0, 0xCE, 0x07, 0xC0, 0xD5, 0x07, 0xC0, 0xDD, 0x07, 0xC0, 0xE5, 0x07, 0x41,
+    0x08, 0xE6, 0x05, 0x41, 0x11, 0xEA, 0x05, 0x80, 0x04, 0x00, 0xEC, 0x07, 0x41, 0x08, 0xEE, 0x05,
+    0x41, 0x17, 0xF2, 0x05, 0x41, 0x11, 0xF5, 0x05, 0x41, 0x11, 0xF8, 0x05, 0x41, 0x07, 0xFB, 0x05,
+    0x41, 0x04, 0xFF, 0x05, 0xC0, 0xF2, 0x07, 0x41, 0x08, 0x03, 0x06, 0x41, 0x15, 0x07, 0x06, 0xC0,
+    0xF9, 0x07, 0x41, 0x08, 0x0A, 0x06, 0xC0, 0x01, 0x08, 0x41, 0x1A, 0x0D, 0x06, 0x80, 0x04, 0x00,
+    0x09, 0x08, 0x41, 0x17, 0x10, 0x06, 0x41, 0x0F, 0x13, 0x06, 0x41, 0x06, 0x17, 0x06, 0x41, 0x11,
+    0x1B, 0x06, 0xC0, 0x0D, 0x08, 0xC0, 0x14, 0x08, 0xC0, 0x1E, 0x08, 0x41, 0x04, 0x1F, 0x06, 0x41,
+    0x15, 0x23, 0x06, 0x41, 0x15, 0x27, 0x06, 0xC0, 0x26, 0x08, 0xC0, 0x2E, 0x08, 0xC0, 0x38, 0x08,
+    0xC0, 0x41, 0x08, 0x41, 0x1C, 0x2A, 0x06, 0x41, 0x1C, 0x2D, 0x06, 0x41, 0x17, 0x30, 0x06, 0x41,
+    0x11, 0x33, 0x06, 0x41, 0x1C, 0x37, 0x06, 0xC0, 0x49, 0x08, 0xC0, 0x51, 0x08, 0xC0, 0x5A, 0x08,
+    0xC0, 0x62, 0x08, 0x41, 0x17, 0x3A, 0x06, 0xC0, 0x6B, 0x08, 0xC0, 0x75, 0x08, 0x02, 0x01, 0x04,
+    0x02, 0x11, 0x07, 0x02, 0x01, 0x04, 0x09, 0x1C, 0x2C, 0x17, 0x0B, 0x08, 0x2C, 0x1A, 0x04, 0x1C,
+    0x03, 0x03, 0x04, 0x03, 0x17, 0x0B, 0x08, 0x02, 0x01, 0x04, 0x0C, 0x11, 0x2C, 0x10, 0x1C, 0x2C,
+    0x12, 0x13, 0x0C, 0x11, 0x0C, 0x12, 0x11, 0x03, 0x03, 0x04, 0x03, 0x04, 0x11, 0x07, 0x02, 0x01,
+    0x04, 0x0B, 0x12, 0x2C, 0x05, 0x08, 0x2C, 0x0B, 0x12, 0x11, 0x08, 0x16, 0x17, 0x02, 0x01, 0x04,
+    0x02, 0x0B, 0x08, 0x02, 0x01, 0x04, 0x0E, 0x0C, 0x17, 0x0B, 0x2C, 0x15, 0x08, 0x16, 0x13, 0x08,
+    0x06, 0x17, 0x2C, 0x17, 0x12, 0x03, 0x01, 0x05, 0x04, 0x2C, 0x0F, 0x12, 0x17, 0x01, 0x00, 0x05,
+    0x02, 0x0F, 0x07, 0x01, 0x01, 0x05, 0x02, 0x34, 0x17, 0x03, 0x01, 0x05, 0x16, 0x09, 0x2C, 0x8C,
+    0x2C, 0x15, 0x08, 0x10, 0x08, 0x10, 0x05, 0x08, 0x15, 0x2C, 0x06, 0x12, 0x15, 0x15, 0x08, 0x06,
+    0x17, 0x0F, 0x1C, 0x01, 0x01, 0x05, 0x02, 0x34, 0x17, 0x01, 0x00, 0x05, 0x02, 0x08, 0x0F, 0x03,
+    0x01, 0x05, 0x0F, 0x12, 0x12, 0x0E, 0x16, 0x2C, 0x0A, 0x12, 0x12, 0x07, 0x2C, 0x17, 0x12, 0x2C,
+    0x10, 0x08, 0x02, 0x00, 0x05, 0x04, 0x17, 0x13, 0x18, 0x17, 0x01, 0x00, 0x05, 0x02, 0x11, 0x17,
+    0x03, 0x01, 0x05, 0x03, 0x0B, 0x04, 0x17, 0x02, 0x00, 0x05, 0x03, 0x08, 0x0C, 0x15, 0x03, 0x01,
+    0x05, 0x03, 0x0B, 0x04, 0x17, 0x01, 0x00, 0x05, 0x02, 0x06, 0x0B, 0x03, 0x01, 0x05, 0x03, 0x0C,
+    0x17, 0x0B, 0x03, 0x01, 0x05, 0x04, 0x0B, 0x0C, 0x06, 0x0B, 0x01, 0x00, 0x05, 0x02, 0x17, 0x0B,
+    0x03, 0x00, 0x05, 0x04, 0x08, 0x0C, 0x15, 0x07, 0x02, 0x01, 0x05, 0x02, 0x17, 0x0B, 0x01, 0x00,
+    0x05, 0x02, 0x0F, 0x07, 0x03, 0x00, 0x06, 0x05, 0x07, 0x15, 0x08, 0x16, 0x16, 0x04, 0x01, 0x06,
+    0x0F, 0x16, 0x2C, 0x09, 0x04, 0x15, 0x2C, 0x04, 0x16, 0x2C, 0x8C, 0x2C, 0x0E, 0x11, 0x12, 0x1A,
+    0x01, 0x01, 0x06, 0x02, 0x34, 0x17, 0x03, 0x00, 0x06, 0x04, 0x0C, 0x08, 0x11, 0x07, 0x01, 0x00,
+    0x06, 0x02, 0x0B, 0x17, 0x02, 0x00, 0x06, 0x03, 0x12, 0x15, 0x17, 0x01, 0x00, 0x06, 0x02, 0x17,
+    0x0B, 0x03, 0x00, 0x06, 0x04, 0x17, 0x13, 0x18, 0x17, 0x02, 0x00, 0x06, 0x03, 0x18, 0x15, 0x11,
+    0x03, 0x00, 0x06, 0x04, 0x17, 0x18, 0x15, 0x11, 0x01, 0x00, 0x06, 0x02, 0x0F, 0x07, 0x03, 0x00,
+    0x06, 0x04, 0x15, 0x0C, 0x11, 0x0A, 0x01, 0x00, 0x06, 0x02, 0x11, 0x0A, 0x01, 0x01, 0x06, 0x02,
+    0x34, 0x16, 0x02, 0x00, 0x06, 0x02, 0x0F, 0x1C, 0x01, 0x01, 0x06, 0x02, 0x34, 0x17, 0x02, 0x01,
+    0x06, 0x03, 0x34, 0x15, 0x08, 0x04, 0x00, 0x07, 0x04, 0x15, 0x12, 0x16, 0x16, 0x03, 0x00, 0x07,
+    0x04, 0x0C, 0x08, 0x19, 0x08, 0x04, 0x00, 0x07, 0x05, 0x06, 0x04, 0x18, 0x16, 0x08, 0x02, 0x00,
+    0x07, 0x03, 0x18, 0x16, 0x08, 0x03, 0x00, 0x07, 0x04, 0x04, 0x18, 0x16, 0x08, 0x03, 0x00, 0x07,
+    0x04, 0x0C, 0x08, 0x19, 0x08, 0x03, 0x00, 0x07, 0x03, 0x0C, 0x11, 0x0A, 0x01, 0x01, 0x07, 0x02,
+    0x34, 0x17, 0x01, 0x00, 0x07, 0x03, 0x15, 0x08, 0x07, 0x03, 0x00, 0x07, 0x04, 0x08, 0x0C, 0x19,
+    0x08, 0x03, 0x00, 0x07, 0x04, 0x04, 0x15, 0x04, 0x17, 0x01, 0x01, 0x07, 0x00, 0x02, 0x00, 0x08,
+    0x03, 0x08, 0x11, 0x17, 0x05, 0x00, 0x08, 0x06, 0x11, 0x06, 0x17, 0x0C, 0x12, 0x11, 0x03, 0x00,
+    0x08, 0x04, 0x17, 0x0C, 0x12, 0x11, 0x02, 0x00, 0x08, 0x04, 0x08, 0x17, 0x08, 0x15, 0x04, 0x00,
+    0x08, 0x06, 0x08, 0x15, 0x08, 0x11, 0x06, 0x08, 0x04, 0x00, 0x08, 0x05, 0x12, 0x15, 0x15, 0x12,
+    0x1A, 0x04, 0x00, 0x09, 0x04, 0x10, 0x08, 0x11, 0x17, 0x03, 0x00, 0x09, 0x04, 0x08, 0x17, 0x08,
+    0x15, 0x04, 0x00, 0x0A, 0x05, 0x0C, 0x17, 0x08, 0x0F, 0x1C, 0x03, 0x00, 0x0A, 0x04, 0x08, 0x11,
+    0x06, 0x1C, 0x03, 0x00, 0x0A, 0x05, 0x11, 0x10, 0x08, 0x11, 0x17, 0x06, 0x00, 0x0A, 0x06, 0x08,
+    0x16, 0x16, 0x04, 0x15, 0x1C, 0x02, 0x00, 0x0B, 0x03, 0x08, 0x11, 0x17,
+};
@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+"""Decode deferred binary log records (DEFLOG) from the Cleo console.
+
+Usage:
+    qmk console | ./deflog_decode.py path/to/firmware.elf
+    ./deflog_decode.py path/to/firmware.elf captured-console.txt
+
+Records arrive as console lines of the form '~<hex bytes>'. Each record holds
+a format-string ID (offset into the ELF's "deflog_fmt" section), the 16-bit
+timer value at logging time and up to eight raw 16-bit arguments. Lines that
+are not DEFLOG records are passed through unchanged.
+"""
+
+import re
+import struct
+import sys
+
+RECORD_RE = re.compile(r"~(!?)([0-9A-F]+)\s*$")
+LENGTH_MODIFIER_RE = re.compile(r"%([-+ #0]*\d*)(?:hh|h|ll|l|z)?([diuxXc%])")
+
+
+def read_format_section(elf_path, section_name="deflog_fmt"):
+    """Return the raw contents of a named section from a 32-bit little endian ELF."""
+    with open(elf_path, "rb") as f:
+        elf = f.read()
+
+    if elf[:4] != b"\x7fELF" or elf[4] != 1 or elf[5] != 1:
+        sys.exit(f"{elf_path}: expected a 32-bit little endian ELF")
+
+    e_shoff, = struct.unpack_from("<I", elf, 0x20)
+    e_shentsize, e_shnum, e_shstrndx = struct.unpack_from("<HHH", elf, 0x2E)
+
+    def section(index):
+        # name, type, flags, addr, offset, size
+        return struct.unpack_from("<IIIIII", elf, e_shoff + index * e_shentsize)
+
+    strtab = section(e_shstrndx)
+    names = elf[strtab[4]:strtab[4] + strtab[5]]
+
+    for i in range(e_shnum):
+        sh = section(i)
+        name = names[sh[0]:names.index(b"\0", sh[0])].decode()
+        if name == section_name:
+            return elf[sh[4]:sh[4] + sh[5]]
+
+    sys.exit(f"{elf_path}: no '{section_name}' section (built without CONSOLE_ENABLE?)")
+
+
+def format_string(section, fmt_id):
+    end = section.index(b"\0", fmt_id)
+    # Python's % operator has no C length modifiers
+    return LENGTH_MODIFIER_RE.sub(r"%\1\2", section[fmt_id:end].decode())
+
+
+def decode_record(section, payload):
+    nargs = payload[0]
+    fmt_id, time = struct.unpack_from("<HH", payload, 1)
+    args = struct.unpack_from(f"<{nargs}H", payload, 5)
+    try:
+        text = format_string(section, fmt_id) % args
+    except (ValueError, TypeError, IndexError) as e:
+        text = f"<bad record id={fmt_id:#06x} args={args}: {e}>"
+    return f"[{time:5d}] {text}"
+
+
+def main():
+    if len(sys.argv) not in (2, 3):
+        sys.exit(__doc__)
+
+    section = read_format_section(sys.argv[1])
+    stream = open(sys.argv[2]) if len(sys.argv) == 3 else sys.stdin
+
+    for line in stream:
+        match = RECORD_RE.search(line)
+        if not match:
+            sys.stdout.write(line)
+            continue
+
+        payload = bytes.fromhex(match.group(2))
+        if match.group(1):
+            print(f"<{int.from_bytes(payload, 'big')} records dropped>")
+        else:
+            print(decode_record(section, payload))
+        sys.stdout.flush()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,386 @@
+// Host benchmark for the RGB matrix effects (built and run by rgb_bench.py)
+// Every effect compiled in by the ENABLE_RGB_MATRIX_* defines in config.h
+// renders frames on the Cleo's LED layout while a synthetic typing stream
+// feeds the reactive effects. Effects are driven the way rgb_matrix.c drives
+// them: one call per RGB_MATRIX_LED_PROCESS_LIMIT LEDs until the effect
+// reports the frame done, each half rendering only its own LEDs.
+//
+// Usage: rgb_bench [frames] [seed] [ms between key presses]
+//
+// Output, one line per effect (frame = slower of the two halves, call = one
+// RGB task iteration in the main loop, insns = -1 without perf counters):
+//   EFFECT <name> <frame ns mean> <frame ns max> <frame insns mean>
+//          <frame insns max> <call ns max> <call insns max>
+
+#define _GNU_SOURCE
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "rgb_matrix_types.h"
+#include "color.h"
+#include "lib/lib8tion/lib8tion.h"
+
+// ============================================================================
+// rgb_matrix.h / rgb_matrix.c STAND-INS
+// ============================================================================
+// Only what the runners and effect headers use.
+
+#ifndef PROGMEM
+#define PROGMEM
+#define pgm_read_byte(address) (*(const uint8_t *)(address))
+#endif
+
+#ifndef RGB_MATRIX_LED_PROCESS_LIMIT
+#define RGB_MATRIX_LED_PROCESS_LIMIT ((RGB_MATRIX_LED_COUNT + 4) / 5)
+#endif
+#ifndef RGB_MATRIX_LED_FLUSH_LIMIT
+#define RGB_MATRIX_LED_FLUSH_LIMIT 16
+#endif
+
+static bool left_half = true;
+
+bool is_keyboard_left(void) {
+    return left_half;
+}
+
+#define RGB_MATRIX_USE_LIMITS_ITER(min, max, iter)                                      \
+    uint8_t min = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);                                \
+    uint8_t max = min + RGB_MATRIX_LED_PROCESS_LIMIT;                                   \
+    if (max > RGB_MATRIX_LED_COUNT) max = RGB_MATRIX_LED_COUNT;                         \
+    uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;                                   \
+    if (is_keyboard_left() && (max > k_rgb_matrix_split[0])) max = k_rgb_matrix_split[0]; \
+    if (!(is_keyboard_left()) && (min < k_rgb_matrix_split[0])) min = k_rgb_matrix_split[0];
+#define RGB_MATRIX_USE_LIMITS(min, max) RGB_MATRIX_USE_LIMITS_ITER(min, max, params->iter)
+
+#define RGB_MATRIX_TEST_LED_FLAGS() \
+    if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) continue
+
+static inline bool rgb_matrix_check_finished_leds(uint8_t led_idx) {
+    uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
+    return led_idx < (is_keyboard_left() ? k_rgb_matrix_split[0] : RGB_MATRIX_LED_COUNT);
+}
+
+rgb_config_t rgb_matrix_config;
+uint32_t g_rgb_timer;
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+last_hit_t g_last_hit_tracker;
+#endif
+#ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
+uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
+#endif
+
+#include RGB_BENCH_LAYOUT  // g_led_config and bench_keys[], generated from the keyboard
+
+static rgb_t leds[RGB_MATRIX_LED_COUNT];  // Stands in for the WS2812 buffer
+
+void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
+        leds[index].r = red;
+        leds[index].g = green;
+        leds[index].b = blue;
+    }
+}
+
+void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        rgb_matrix_set_color(i, red, green, blue);
+    }
+}
+
+rgb_t rgb_matrix_hsv_to_rgb(hsv_t hsv) {
+    return hsv_to_rgb(hsv);
+}
+
+uint32_t timer_read32(void) {
+    return g_rgb_timer;
+}
+
+uint32_t timer_elapsed32(uint32_t last) {
+    return g_rgb_timer - last;
+}
+
+// ============================================================================
+// EFFECTS
+// ============================================================================
+
+#include "rgb_matrix_runners.inc"
+
+#define RGB_MATRIX_EFFECT(name, ...)
+#define RGB_MATRIX_CUSTOM_EFFECT_IMPLS
+#include "rgb_matrix_effects.inc"
+#ifdef RGB_MATRIX_CUSTOM_KB
+#include "rgb_matrix_kb.inc"
+#endif
+#ifdef RGB_MATRIX_CUSTOM_USER
+#include "rgb_matrix_user.inc"
+#endif
+#undef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
+#undef RGB_MATRIX_EFFECT
+
+typedef struct {
+    const char *name;
+    bool (*render)(effect_params_t *params);
+} effect_t;
+
+static const effect_t effects[] = {
+#define RGB_MATRIX_EFFECT(name, ...) {#name, name},
+#include "rgb_matrix_effects.inc"
+#ifdef RGB_MATRIX_CUSTOM_KB
+#include "rgb_matrix_kb.inc"
+#endif
+#ifdef RGB_MATRIX_CUSTOM_USER
+#include "rgb_matrix_user.inc"
+#endif
+#undef RGB_MATRIX_EFFECT
+};
+
+// ============================================================================
+// MEASUREMENT
+// ============================================================================
+// Wall time plus retired user-space instructions when the kernel exposes the
+// counter (not in most VMs and containers; the script then estimates).
+
+#ifndef RGB_BENCH_RUNS
+#define RGB_BENCH_RUNS 5  // Runs per effect, per-frame minimum is kept
+#endif
+
+static int insn_fd = -1;
+static uint64_t ns_overhead = 0;
+static uint64_t insn_overhead = 0;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static uint64_t insns(void) {
+    uint64_t count = 0;
+#ifdef __linux__
+    if (insn_fd >= 0 && read(insn_fd, &count, sizeof(count)) != sizeof(count)) {
+        count = 0;
+    }
+#endif
+    return count;
+}
+
+static void measure_init(void) {
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    insn_fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+
+    // Cost of the measurement itself, subtracted from every call
+    ns_overhead = insn_overhead = UINT64_MAX;
+    for (int i = 0; i < 1000; i++) {
+        uint64_t t0 = now_ns(), i0 = insns();
+        uint64_t i1 = insns(), t1 = now_ns();
+        if (t1 - t0 < ns_overhead) {
+            ns_overhead = t1 - t0;
+        }
+        if (i1 - i0 < insn_overhead) {
+            insn_overhead = i1 - i0;
+        }
+    }
+}
+
+static uint64_t minus_overhead(uint64_t value, uint64_t overhead) {
+    return value > overhead ? value - overhead : 0;
+}
+
+// ============================================================================
+// SYNTHETIC TYPING
+// ============================================================================
+// Presses at random keys, 0.25-1.75x the mean interval apart (default 140 ms,
+// about 85 wpm). The hit tracker is kept the way rgb_matrix.c keeps it:
+// newest last, ticks aged every frame.
+
+static uint32_t typing_ms = 140;
+
+static uint32_t rng_state;
+
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+static last_hit_t hits;
+
+static void press(uint8_t row, uint8_t col) {
+    uint8_t led = g_led_config.matrix_co[row][col];
+    if (led == NO_LED) {
+        return;
+    }
+    if (hits.count >= LED_HITS_TO_REMEMBER) {
+        memmove(&hits.x[0], &hits.x[1], LED_HITS_TO_REMEMBER - 1);
+        memmove(&hits.y[0], &hits.y[1], LED_HITS_TO_REMEMBER - 1);
+        memmove(&hits.index[0], &hits.index[1], LED_HITS_TO_REMEMBER - 1);
+        memmove(&hits.tick[0], &hits.tick[1], (LED_HITS_TO_REMEMBER - 1) * sizeof(hits.tick[0]));
+        hits.count = LED_HITS_TO_REMEMBER - 1;
+    }
+    hits.x[hits.count] = g_led_config.point[led].x;
+    hits.y[hits.count] = g_led_config.point[led].y;
+    hits.index[hits.count] = led;
+    hits.tick[hits.count] = 0;
+    hits.count++;
+}
+
+static void age_hits(uint16_t elapsed) {
+    for (uint8_t i = 0; i < hits.count; i++) {
+        if (UINT16_MAX - elapsed < hits.tick[i]) {
+            hits.count = i;  // Oldest first, so everything from here is older
+            break;
+        }
+        hits.tick[i] += elapsed;
+    }
+}
+#endif
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+typedef struct {
+    uint64_t ns;
+    uint64_t insns;
+} cost_t;
+
+static void keep_max(cost_t *a, cost_t b) {
+    a->ns = b.ns > a->ns ? b.ns : a->ns;
+    a->insns = b.insns > a->insns ? b.insns : a->insns;
+}
+
+static void keep_min(cost_t *a, cost_t b) {
+    a->ns = b.ns < a->ns ? b.ns : a->ns;
+    a->insns = b.insns < a->insns ? b.insns : a->insns;
+}
+
+// One frame of one half, call by call as rgb_task_render() does
+static cost_t render_half(const effect_t *effect, effect_params_t *params, bool left, cost_t *worst_call) {
+    cost_t total = {0, 0};
+    left_half = left;
+    params->iter = 0;
+    bool more;
+    do {
+        uint64_t t0 = now_ns(), i0 = insns();
+        more = effect->render(params);
+        uint64_t i1 = insns(), t1 = now_ns();
+        cost_t call = {minus_overhead(t1 - t0, ns_overhead), minus_overhead(i1 - i0, insn_overhead)};
+        total.ns += call.ns;
+        total.insns += call.insns;
+        keep_max(worst_call, call);
+        params->iter++;
+    } while (more);
+    return total;
+}
+
+// One run over all frames from the same seed, so every run renders the same
+// frames and the per-frame minimum over runs drops preemption and cache noise
+static void run(const effect_t *effect, uint32_t frames, uint32_t seed, cost_t *frame_min, cost_t *call_min) {
+    rng_state = seed ? seed : 1;
+    srand(seed);
+    random16_set_seed(seed);
+    memset(leds, 0, sizeof(leds));
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    memset(&hits, 0, sizeof(hits));
+#endif
+
+    effect_params_t params = {.iter = 0, .flags = LED_FLAG_ALL, .init = true};
+    uint32_t now = 0;
+    uint32_t next_press = typing_ms;
+
+    for (uint32_t frame = 0; frame < frames; frame++) {
+        now += RGB_MATRIX_LED_FLUSH_LIMIT;
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+        age_hits(RGB_MATRIX_LED_FLUSH_LIMIT);
+        while (next_press <= now) {
+            const uint8_t *key = bench_keys[rng() % (sizeof(bench_keys) / sizeof(bench_keys[0]))];
+            press(key[0], key[1]);
+            next_press += typing_ms / 4 + rng() % (typing_ms * 3 / 2 + 1);
+        }
+        g_last_hit_tracker = hits;
+#else
+        (void)next_press;
+#endif
+        g_rgb_timer = now;
+
+        // The halves render in parallel, the slower one sets the frame time
+        cost_t worst_call = {0, 0};
+        cost_t frame_cost = render_half(effect, &params, true, &worst_call);
+        keep_max(&frame_cost, render_half(effect, &params, false, &worst_call));
+        params.init = false;
+
+        keep_min(&frame_min[frame], frame_cost);
+        keep_min(&call_min[frame], worst_call);
+    }
+}
+
+static void bench(const effect_t *effect, uint32_t frames, uint32_t seed, cost_t *frame_min, cost_t *call_min) {
+    for (uint32_t frame = 0; frame < frames; frame++) {
+        frame_min[frame] = call_min[frame] = (cost_t){UINT64_MAX, UINT64_MAX};
+    }
+    for (int i = 0; i < RGB_BENCH_RUNS; i++) {
+        run(effect, frames, seed, frame_min, call_min);
+    }
+
+    cost_t sum = {0, 0}, worst_frame = {0, 0}, worst_call = {0, 0};
+    for (uint32_t frame = 0; frame < frames; frame++) {
+        sum.ns += frame_min[frame].ns;
+        sum.insns += frame_min[frame].insns;
+        keep_max(&worst_frame, frame_min[frame]);
+        keep_max(&worst_call, call_min[frame]);
+    }
+
+    bool counted = insn_fd >= 0;
+    printf("EFFECT %s %llu %llu %lld %lld %llu %lld\n", effect->name, (unsigned long long)(sum.ns / frames),
+           (unsigned long long)worst_frame.ns, counted ? (long long)(sum.insns / frames) : -1LL,
+           counted ? (long long)worst_frame.insns : -1LL, (unsigned long long)worst_call.ns,
+           counted ? (long long)worst_call.insns : -1LL);
+}
+
+int main(int argc, char **argv) {
+    uint32_t frames = argc > 1 ? strtoul(argv[1], NULL, 0) : 500;
+    uint32_t seed = argc > 2 ? strtoul(argv[2], NULL, 0) : 1;
+    typing_ms = argc > 3 ? strtoul(argv[3], NULL, 0) : typing_ms;
+    if (frames == 0 || typing_ms == 0) {
+        fprintf(stderr, "usage: %s [frames] [seed] [ms between key presses]\n", argv[0]);
+        return 2;
+    }
+
+    cost_t *frame_min = malloc(frames * sizeof(cost_t));
+    cost_t *call_min = malloc(frames * sizeof(cost_t));
+    measure_init();
+    rgb_matrix_config.enable = 1;
+    rgb_matrix_config.hsv = (hsv_t){RGB_BENCH_HUE, RGB_BENCH_SAT, RGB_BENCH_VAL};
+    rgb_matrix_config.speed = RGB_BENCH_SPEED;
+    rgb_matrix_config.flags = LED_FLAG_ALL;
+
+    printf("LAYOUT leds %u split %u process_limit %u frame_ms %u frames %u typing_ms %u insn_counter %s\n",
+           RGB_MATRIX_LED_COUNT, ((uint8_t[])RGB_MATRIX_SPLIT)[0], RGB_MATRIX_LED_PROCESS_LIMIT,
+           RGB_MATRIX_LED_FLUSH_LIMIT, frames, typing_ms, insn_fd < 0 ? "no" : "yes");
+    for (size_t i = 0; i < sizeof(effects) / sizeof(effects[0]); i++) {
+        bench(&effects[i], frames, seed, frame_min, call_min);
+    }
+    free(frame_min);
+    free(call_min);
+    return 0;
+}
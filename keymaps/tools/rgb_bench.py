@@ -0,0 +1,203 @@
+#!/usr/bin/env python3
+"""Benchmark the enabled RGB matrix effects on the host (rgb_bench.c).
+
+Compiles every effect enabled by the ENABLE_RGB_MATRIX_* defines in the
+keyboard's config.h against a QMK checkout, renders them on the Cleo's
+62-LED layout (g_led_config from keymaps_base.c) with a synthetic typing
+stream, and reports per frame cost and the worst frame and worst single
+RGB task call. The keyboard's own effects (rgb_matrix_kb.inc) are included
+when rules.mk sets RGB_MATRIX_CUSTOM_KB.
+
+Cortex-M0 cycles are estimated from retired host instructions times
+--m0-cpi (Thumb-1 needs more instructions than x86-64 for the same 8-bit
+math, plus load/branch stalls and a flash wait state at 48 MHz; 2.0 is a
+rough average, calibrate against a SysTick measurement when it matters).
+Without perf counters (most VMs/containers) instructions are estimated
+from wall time with --host-ipns and the numbers are marked with '~'.
+
+Usage:
+    ./rgb_bench.py [--qmk ~/qmk_firmware] [--frames 500] [--wpm 85]
+    ./rgb_bench.py --save base.txt       # then, after changing effect code:
+    ./rgb_bench.py --compare base.txt
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+KB_DIR = os.path.join(HERE, '..', '..')
+LED_CONFIG_RE = re.compile(r"led_config_t\s+g_led_config\s*=\s*(\{.*?\}\s*\})\s*;", re.S)
+ENABLE_RE = re.compile(r"^\s*#define\s+ENABLE_RGB_MATRIX_(\w+)", re.M)
+
+
+def qmk_home(path):
+    for candidate in (path, os.environ.get('QMK_HOME'), os.path.expanduser('~/qmk_firmware')):
+        if candidate and os.path.isfile(os.path.join(candidate, 'quantum', 'rgb_matrix', 'rgb_matrix_types.h')):
+            return candidate
+    sys.exit("QMK checkout not found: pass --qmk or set QMK_HOME")
+
+
+def write_layout(tmp):
+    """Generate the layout defines and g_led_config from the keyboard sources."""
+    with open(os.path.join(KB_DIR, 'keyboard.json')) as f:
+        info = json.load(f)
+    with open(os.path.join(KB_DIR, 'keymaps', 'keymaps_base.c')) as f:
+        led_config = LED_CONFIG_RE.search(f.read())
+    if not led_config:
+        sys.exit("g_led_config not found in keymaps/keymaps_base.c")
+
+    rgb = info['rgb_matrix']
+    direct = info['matrix_pins']['direct']
+    split = info.get('split', {}).get('enabled', False)
+    rows = len(direct) * (2 if split else 1)
+    split_count = rgb.get('split_count', [rgb['led_count'], 0])
+    layout = next(iter(info['layouts'].values()))['layout']
+    keys = [key['matrix'] for key in layout]
+
+    defines = os.path.join(tmp, 'rgb_bench_defines.h')
+    with open(defines, 'w') as f:
+        f.write(f"#define MATRIX_ROWS {rows}\n"
+                f"#define MATRIX_COLS {len(direct[0])}\n"
+                f"#define RGB_MATRIX_ENABLE\n"
+                f"#define RGB_MATRIX_SPLIT {{{split_count[0]}, {split_count[1]}}}\n"
+                f"#define RGB_MATRIX_MAXIMUM_BRIGHTNESS {rgb.get('max_brightness', 255)}\n"
+                f"#define RGB_BENCH_HUE {rgb.get('default', {}).get('hue', 0)}\n"
+                f"#define RGB_BENCH_SAT {rgb.get('default', {}).get('sat', 255)}\n"
+                f"#define RGB_BENCH_VAL {rgb.get('default', {}).get('val', 255)}\n"
+                f"#define RGB_BENCH_SPEED {rgb.get('default', {}).get('speed', 128)}\n"
+                f"#include \"{os.path.join(KB_DIR, 'config.h')}\"\n"
+                f"#ifndef RGB_MATRIX_LED_COUNT\n"
+                f"#define RGB_MATRIX_LED_COUNT {rgb['led_count']}\n"
+                f"#endif\n")
+    layout = os.path.join(tmp, 'rgb_bench_layout.inc')
+    with open(layout, 'w') as f:
+        f.write(f"led_config_t g_led_config = {led_config.group(1)};\n\n")
+        f.write("static const uint8_t bench_keys[][2] = {\n")
+        f.writelines(f"    {{{row}, {col}}},\n" for row, col in keys)
+        f.write("};\n")
+    return defines, layout
+
+
+def custom_kb():
+    with open(os.path.join(KB_DIR, 'rules.mk')) as f:
+        return re.search(r"^\s*RGB_MATRIX_CUSTOM_KB\s*=\s*yes", f.read(), re.M) is not None
+
+
+def build(qmk, tmp):
+    defines, layout = write_layout(tmp)
+    binary = os.path.join(tmp, 'rgb_bench')
+    # -Os like the firmware, so the instruction mix is closer to what the M0 runs
+    cmd = [os.environ.get('CC', 'cc'), '-std=gnu11', '-Os', '-Wall', '-Wno-unused-function',
+           '-include', defines, f'-DRGB_BENCH_LAYOUT="{layout}"']
+    if custom_kb():
+        cmd += ['-DRGB_MATRIX_CUSTOM_KB', '-I' + KB_DIR]
+    cmd += ['-I' + qmk,
+           '-I' + os.path.join(qmk, 'quantum'),
+           '-I' + os.path.join(qmk, 'quantum', 'rgb_matrix'),
+           '-I' + os.path.join(qmk, 'quantum', 'rgb_matrix', 'animations'),
+           '-I' + os.path.join(qmk, 'quantum', 'rgb_matrix', 'animations', 'runners'),
+           '-I' + os.path.join(qmk, 'platforms'),
+           '-I' + os.path.join(qmk, 'lib', 'lib8tion'),
+           os.path.join(HERE, 'rgb_bench.c'),
+           os.path.join(qmk, 'quantum', 'color.c'),
+           os.path.join(qmk, 'lib', 'lib8tion', 'lib8tion.c'),
+           '-lm', '-o', binary]
+    subprocess.run(cmd, check=True)
+    return binary
+
+
+def parse(output):
+    header, results = {}, {}
+    for line in output.splitlines():
+        fields = line.split()
+        if fields[0] == 'LAYOUT':
+            header = dict(zip(fields[1::2], fields[2::2]))
+        elif fields[0] == 'EFFECT':
+            name, values = fields[1], [int(v) for v in fields[2:]]
+            results[name] = dict(zip(['ns', 'ns_max', 'insns', 'insns_max', 'call_ns', 'call_insns'], values))
+    return header, results
+
+
+def m0_cycles(r, key_insns, key_ns, args):
+    insns = r[key_insns] if r[key_insns] >= 0 else r[key_ns] * args.host_ipns
+    return insns * args.m0_cpi
+
+
+def show(header, results, args, baseline):
+    estimated = header.get('insn_counter') != 'yes'
+    mark = '~' if estimated else ' '
+    frame_budget_us = int(header['frame_ms']) * 1000
+    print(f"{header['leds']} LEDs ({header['split']} per half), {header['process_limit']} LEDs per RGB task call, "
+          f"{header['frames']} frames of {header['frame_ms']} ms, a key every {header['typing_ms']} ms, "
+          f"M0 at {args.mhz} MHz x {args.m0_cpi} cycles/insn")
+    if estimated:
+        print(f"no perf counters: M0 estimates from wall time at {args.host_ipns} host insns/ns (~)")
+    print()
+    print(f"{'effect':34s} {'host us':>8s} {'max':>7s} {'M0 kcyc':>9s} {'M0 ms':>7s} {'max ms':>7s} "
+          f"{'call us':>8s} {'load':>5s}" + ("  vs base" if baseline else ""))
+
+    for name, r in sorted(results.items(), key=lambda item: -m0_cycles(item[1], 'insns', 'ns', args)):
+        cycles = m0_cycles(r, 'insns', 'ns', args)
+        cycles_max = m0_cycles(r, 'insns_max', 'ns_max', args)
+        call_us = m0_cycles(r, 'call_insns', 'call_ns', args) / args.mhz
+        load = cycles / args.mhz / frame_budget_us  # Share of the M0 spent rendering at the flush rate
+        line = (f"{name:34s} {r['ns'] / 1000:8.1f} {r['ns_max'] / 1000:7.1f} {mark}{cycles / 1000:8.1f} "
+                f"{mark}{cycles / args.mhz / 1000:6.2f} {mark}{cycles_max / args.mhz / 1000:6.2f} "
+                f"{mark}{call_us:7.0f} {load:5.0%}")
+        if baseline and name in baseline:
+            before = m0_cycles(baseline[name], 'insns', 'ns', args)
+            line += f"  {(cycles - before) / before:+7.1%}" if before else "        -"
+        if call_us > args.call_budget_us or load > args.load_budget:
+            line += "  <- too slow"
+        print(line)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('--qmk', help="QMK checkout (default: $QMK_HOME or ~/qmk_firmware)")
+    parser.add_argument('--frames', type=int, default=500)
+    parser.add_argument('--seed', type=int, default=1)
+    parser.add_argument('--wpm', type=float, default=85, help="typing speed of the synthetic key presses")
+    parser.add_argument('--mhz', type=float, default=48, help="M0 clock")
+    parser.add_argument('--m0-cpi', type=float, default=2.0, help="M0 cycles per host instruction")
+    parser.add_argument('--host-ipns', type=float, default=6.0,
+                        help="host instructions per ns when there are no perf counters")
+    parser.add_argument('--call-budget-us', type=float, default=1000,
+                        help="flag effects whose worst task call blocks the scan loop longer")
+    parser.add_argument('--load-budget', type=float, default=0.25,
+                        help="flag effects needing a larger share of the M0 at the flush rate")
+    parser.add_argument('--save', metavar='FILE', help="write the raw results for --compare")
+    parser.add_argument('--compare', metavar='FILE', help="show M0 cycle changes against saved results")
+    args = parser.parse_args()
+
+    qmk = qmk_home(args.qmk)
+    with tempfile.TemporaryDirectory() as tmp:
+        binary = build(qmk, tmp)
+        typing_ms = max(1, round(12000 / args.wpm))  # 5 keys per word
+        output = subprocess.run([binary, str(args.frames), str(args.seed), str(typing_ms)], check=True,
+                                capture_output=True, text=True).stdout
+
+    header, results = parse(output)
+    baseline = None
+    if args.compare:
+        with open(args.compare) as f:
+            baseline = parse(f.read())[1]
+    show(header, results, args, baseline)
+
+    with open(os.path.join(KB_DIR, 'config.h')) as f:
+        missing = sorted(set(ENABLE_RE.findall(f.read())) - set(results))
+    if missing:
+        print(f"\nenabled in config.h but not compiled in (missing dependency define?): {', '.join(missing)}")
+
+    if args.save:
+        with open(args.save, 'w') as f:
+            f.write(output)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+"""Generate rgb_field_data.h (LED distances for the FIELD_* effects).
+
+For every LED under a key (LED_FLAG_KEYLIGHT) the table holds its distance
+to every LED of the board in g_led_config units, so rgb_matrix_kb.inc can
+apply a key press without a square root per LED. Rerun after changing
+g_led_config in keymaps/keymaps_base.c.
+
+Usage: rgb_field_gen.py [-o rgb_field_data.h]
+"""
+
+import argparse
+import json
+import math
+import os
+import re
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+KB_DIR = os.path.normpath(os.path.join(HERE, '..', '..'))
+LED_CONFIG_RE = re.compile(r"led_config_t\s+g_led_config\s*=\s*(\{.*?\}\s*\})\s*;", re.S)
+LED_FLAG_KEYLIGHT = 0x04
+NO_ROW = 0xFF
+
+
+def read_led_config(path):
+    """Return (points, flags) from the g_led_config initializer."""
+    with open(path) as f:
+        match = LED_CONFIG_RE.search(f.read())
+    if not match:
+        sys.exit(f"g_led_config not found in {path}")
+    text = re.sub(r"//[^\n]*", "", match.group(1))
+    text = re.sub(r",(\s*\})", r"\1", text).replace('{', '[').replace('}', ']')
+    _, points, flags = json.loads(text)
+    if len(points) != len(flags):
+        sys.exit(f"{len(points)} LED positions but {len(flags)} LED flags")
+    return points, flags
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('-o', '--output', default=os.path.join(KB_DIR, 'rgb_field_data.h'))
+    args = parser.parse_args()
+
+    points, flags = read_led_config(os.path.join(KB_DIR, 'keymaps', 'keymaps_base.c'))
+    keys = [i for i, flag in enumerate(flags) if flag & LED_FLAG_KEYLIGHT]
+    rows = {led: row for row, led in enumerate(keys)}
+
+    lines = [
+        "// Generated by keymaps/tools/rgb_field_gen.py from g_led_config, do not edit",
+        f"// {len(keys)} key LEDs x {len(points)} LEDs, {len(points) + len(keys) * len(points)} bytes",
+        "#pragma once",
+        "",
+        f"#define FIELD_LED_COUNT {len(points)}",
+        f"#define FIELD_KEY_LEDS {len(keys)}",
+        f"#define FIELD_NO_ROW 0x{NO_ROW:02X}",
+        "",
+        "// LED index -> row of field_dist (FIELD_NO_ROW for LEDs without a key)",
+        "static const uint8_t field_row[FIELD_LED_COUNT] PROGMEM = {",
+    ]
+    row_of = [rows.get(i, NO_ROW) for i in range(len(points))]
+    lines += ["    " + ", ".join(f"0x{r:02X}" for r in row_of[i:i + 16]) + "," for i in range(0, len(row_of), 16)]
+    lines += ["};", "", "// Distance from a key LED to every LED",
+              "static const uint8_t field_dist[FIELD_KEY_LEDS][FIELD_LED_COUNT] PROGMEM = {"]
+    for led in keys:
+        x, y = points[led]
+        dist = [min(255, math.isqrt((px - x) ** 2 + (py - y) ** 2)) for px, py in points]
+        chunks = [", ".join(f"{d:3d}" for d in dist[i:i + 16]) for i in range(0, len(dist), 16)]
+        body = ",\n     ".join(chunks)
+        lines.append(f"    {{{body}}}, // LED {led}")
+    lines.append("};")
+
+    with open(args.output, 'w') as f:
+        f.write("\n".join(lines) + "\n")
+    print(f"{args.output}: {len(keys)} key LEDs, {len(points)} LEDs")
+
+
+if __name__ == '__main__':
+    main()
@@ -22,4 +22,15 @@
 #define STM32_PWM_USE_ADVANCED FALSE
 
 #undef STM32_SPI_USE_SPI1
-#define STM32_SPI_USE_SPI1 FALSE
\ No newline at end of file
+#ifdef QUANTUM_PAINTER_ENABLE
+#define STM32_SPI_USE_SPI1 TRUE
+#else
+#define STM32_SPI_USE_SPI1 FALSE
+#endif
+
+// SPI1 RX is hardwired to DMA1 channel 2, which the WS2812 PWM driver uses
+#if defined(QUANTUM_PAINTER_ENABLE) && defined(RGB_MATRIX_ENABLE)
+#error "SPI1 (LCD) and the WS2812 driver both need DMA1 channel 2"
+#endif
+
+// USART1 DMA (serial_dma.c) is remapped to channels 4/5, clear of both
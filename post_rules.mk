@@ -0,0 +1,30 @@
+# Read after the keymap rules.mk, so keymap overrides of the defaults in
+# rules.mk (RGB_MATRIX_ENABLE included) are final here
+
+# Render the RGB matrix in a thread (rgb_thread.h); the main loop's calls
+# are redirected by the linker, and the main loop entry points that change
+# RGB state take the render lock
+ifeq ($(strip $(RGB_MATRIX_ENABLE)), yes)
+    ifeq ($(strip $(RGB_MATRIX_THREAD_ENABLE)), yes)
+        OPT_DEFS += -DRGB_MATRIX_THREAD_ENABLE
+        EXTRALDFLAGS += -Wl,--wrap=rgb_matrix_task -Wl,--wrap=process_rgb_matrix -Wl,--wrap=eeconfig_update_rgb_matrix
+        EXTRALDFLAGS += -Wl,--wrap=action_exec -Wl,--wrap=raw_hid_receive -Wl,--wrap=transport_slave
+        EXTRALDFLAGS += -Wl,--wrap=suspend_power_down_quantum -Wl,--wrap=suspend_wakeup_init_quantum
+    endif
+endif
+
+# Split link on USART1 DMA with a pipelined slave matrix read (serial_dma.c);
+# QMK's serial_usart.c stays linked but is no longer called
+ifeq ($(strip $(SERIAL_DMA_ENABLE)), yes)
+    OPT_DEFS += -DSERIAL_DMA_ENABLE
+    EXTRALDFLAGS += -Wl,--wrap=serial_transport_driver_master_init -Wl,--wrap=serial_transport_driver_slave_init
+    EXTRALDFLAGS += -Wl,--wrap=serial_transport_driver_clear -Wl,--wrap=serial_transport_send
+    EXTRALDFLAGS += -Wl,--wrap=serial_transport_receive -Wl,--wrap=serial_transport_receive_blocking
+    EXTRALDFLAGS += -Wl,--wrap=soft_serial_transaction -Wl,--wrap=transport_master
+endif
+
+# Matrix scan held to the slot before the next USB poll (usb_sof.h)
+ifeq ($(strip $(USB_SOF_SCHEDULE_ENABLE)), yes)
+    OPT_DEFS += -DUSB_SOF_SCHEDULE_ENABLE
+    EXTRALDFLAGS += -Wl,--wrap=usbStart -Wl,--wrap=matrix_scan -Wl,--wrap=host_keyboard_send
+endif
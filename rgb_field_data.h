@@ -0,0 +1,187 @@
+// Generated by keymaps/tools/rgb_field_gen.py from g_led_config, do not edit
+// 42 key LEDs x 62 LEDs, 2666 bytes
+#pragma once
+
+#define FIELD_LED_COUNT 62
+#define FIELD_KEY_LEDS 42
+#define FIELD_NO_ROW 0xFF
+
+// LED index -> row of field_dist (FIELD_NO_ROW for LEDs without a key)
+static const uint8_t field_row[FIELD_LED_COUNT] PROGMEM = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x15,
+    0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25,
+    0x26, 0x27, 0x28, 0x29, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+// Distance from a key LED to every LED
+static const uint8_t field_dist[FIELD_KEY_LEDS][FIELD_LED_COUNT] PROGMEM = {
+    {  0,  23,  43,  63,  68,  50,  35,  19,  38,  50,  62,  78,  89,  76,  67,  84,
+      92, 103, 118, 108, 102,  80,  90,  53,  28,  80,  90,  53,  28,  53,  28,  15,
+      39,  54,  71,  81,  66,  56,  45,  60,  73,  81,  94, 108,  97,  90, 108, 114,
+     123, 138, 129, 124,  94, 102,  64,  44,  94, 102,  64,  44,  64,  44}, // LED 0
+    { 23,   0,  21,  42,  45,  27,  18,  22,  35,  36,  41,  55,  68,  57,  54,  72,
+      75,  83,  99,  92,  90,  65,  71,  30,  10,  65,  71,  30,  10,  30,  10,  32,
+      44,  48,  60,  74,  65,  62,  58,  73,  80,  82,  90, 106, 100,  98, 116, 117,
+     123, 139, 134, 133, 100, 104,  57,  50, 100, 104,  57,  50,  57,  50}, // LED 1
+    { 43,  21,   0,  21,  27,  18,  27,  42,  50,  41,  36,  41,  57,  54,  57,  75,
+      72,  75,  92,  90,  92,  66,  65,  12,  24,  66,  65,  12,  24,  12,  24,  48,
+      48,  44,  48,  65,  62,  65,  69,  81,  82,  80,  82, 100,  98, 100, 117, 116,
+     117, 134, 133, 134, 100, 100,  50,  54, 100, 100,  50,  54,  50,  54}, // LED 2
+    { 63,  42,  21,   0,  18,  27,  45,  63,  68,  55,  41,  36,  54,  57,  68,  83,
+      75,  72,  90,  92,  99,  72,  66,  16,  44,  72,  66,  16,  44,  16,  44,  67,
+      60,  48,  44,  62,  65,  74,  83,  94,  90,  82,  80,  98, 100, 106, 123, 117,
+     116, 133, 134, 139, 105, 100,  51,  65, 105, 100,  51,  65,  51,  65}, // LED 3
+    { 68,  45,  27,  18,   0,  21,  42,  63,  63,  45,  27,  18,  36,  41,  55,  68,
+      57,  54,  72,  75,  83,  57,  48,  15,  43,  57,  48,  15,  43,  15,  43,  76,
+      74,  65,  62,  80,  82,  90,  96, 108, 106, 100,  98, 116, 117, 123, 140, 135,
+     134, 151, 152, 156, 122, 118,  69,  80, 122, 118,  69,  80,  69,  80}, // LED 4
+    { 50,  27,  18,  27,  21,   0,  21,  42,  43,  27,  18,  27,  41,  36,  41,  57,
+      54,  57,  75,  72,  75,  48,  47,  11,  23,  48,  47,  11,  23,  11,  23,  60,
+      65,  62,  65,  82,  80,  82,  84,  97, 100,  98, 100, 117, 116, 117, 135, 134,
+     135, 152, 151, 152, 118, 118,  68,  71, 118, 118,  68,  71,  68,  71}, // LED 5
+    { 35,  18,  27,  45,  42,  21,   0,  22,  23,  18,  27,  45,  55,  41,  36,  54,
+      57,  68,  83,  75,  72,  47,  55,  30,   8,  47,  55,  30,   8,  30,   8,  47,
+      62,  65,  74,  90,  82,  80,  75,  90,  98, 100, 106, 123, 117, 116, 134, 135,
+     140, 156, 152, 151, 118, 121,  73,  68, 118, 121,  73,  68,  73,  68}, // LED 6
+    { 19,  22,  42,  63,  63,  42,  22,   0,  19,  34,  49,  68,  77,  61,  49,  66,
+      75,  89, 102,  91,  83,  63,  75,  50,  20,  63,  75,  50,  20,  50,  20,  34,
+      57,  67,  82,  94,  82,  74,  64,  79,  91,  98, 109, 124, 114, 109, 126, 131,
+     139, 155, 148, 143, 113, 119,  77,  62, 113, 119,  77,  62,  77,  62}, // LED 7
+    { 38,  35,  50,  68,  63,  43,  23,  19,   0,  22,  42,  63,  68,  49,  33,  48,
+      60,  76,  88,  74,  65,  47,  62,  53,  26,  47,  62,  53,  26,  53,  26,  53,
+      75,  83,  95, 109,  99,  92,  83,  98, 110, 115, 125, 140, 132, 127, 145, 150,
+     157, 172, 166, 162, 131, 137,  92,  80, 131, 137,  92,  80,  92,  80}, // LED 8
+    { 50,  36,  41,  55,  45,  27,  18,  34,  22,   0,  21,  42,  45,  27,  18,  36,
+      41,  55,  68,  57,  54,  30,  41,  38,  26,  30,  41,  38,  26,  38,  26,  64,
+      80,  82,  90, 106, 100,  98,  93, 108, 116, 117, 123, 140, 135, 134, 152, 153,
+     157, 174, 170, 169, 136, 139,  90,  86, 136, 139,  90,  86,  90,  86}, // LED 9
+    { 62,  41,  36,  41,  27,  18,  27,  49,  42,  21,   0,  21,  27,  18,  27,  41,
+      36,  41,  57,  54,  57,  31,  30,  27,  34,  31,  30,  27,  34,  27,  34,  74,
+      82,  80,  82, 100,  98, 100, 100, 114, 117, 116, 117, 135, 134, 135, 153, 152,
+     153, 170, 169, 170, 136, 136,  86,  88, 136, 136,  86,  88,  86,  88}, // LED 10
+    { 78,  55,  41,  36,  18,  27,  45,  68,  63,  42,  21,   0,  18,  27,  45,  55,
+      41,  36,  54,  57,  68,  43,  31,  29,  50,  43,  31,  29,  50,  29,  50,  87,
+      90,  82,  80,  98, 100, 106, 110, 123, 123, 117, 116, 134, 135, 140, 157, 153,
+     152, 169, 170, 174, 139, 136,  86,  96, 139, 136,  86,  96,  86,  96}, // LED 11
+    { 89,  68,  57,  54,  36,  41,  55,  77,  68,  45,  27,  18,   0,  21,  42,  45,
+      27,  18,  36,  41,  55,  34,  17,  45,  61,  34,  17,  45,  61,  45,  61, 101,
+     106, 100,  98, 116, 117, 123, 125, 139, 140, 135, 134, 152, 153, 157, 175, 171,
+     170, 187, 188, 191, 157, 154, 104, 112, 157, 154, 104, 112, 104, 112}, // LED 12
+    { 76,  57,  54,  57,  41,  36,  41,  61,  49,  27,  18,  27,  21,   0,  21,  27,
+      18,  27,  41,  36,  41,  16,  13,  44,  49,  16,  13,  44,  49,  44,  49,  89,
+     100,  98, 100, 117, 116, 117, 116, 130, 135, 134, 135, 153, 152, 153, 171, 170,
+     171, 188, 187, 188, 154, 154, 104, 106, 154, 154, 104, 106, 104, 106}, // LED 13
+    { 67,  54,  57,  68,  55,  41,  36,  49,  33,  18,  27,  45,  42,  21,   0,  18,
+      27,  45,  55,  41,  36,  14,  31,  52,  44,  14,  31,  52,  44,  52,  44,  81,
+      98, 100, 106, 123, 117, 116, 111, 125, 134, 135, 140, 157, 153, 152, 170, 171,
+     175, 191, 188, 187, 154, 156, 107, 104, 154, 156, 107, 104, 107, 104}, // LED 14
+    { 84,  72,  75,  83,  68,  57,  54,  66,  48,  36,  41,  55,  45,  27,  18,   0,
+      21,  42,  45,  27,  18,  11,  29,  68,  62,  11,  29,  68,  62,  68,  62,  99,
+     116, 117, 123, 140, 135, 134, 128, 143, 152, 153, 157, 175, 171, 170, 188, 189,
+     192, 209, 206, 205, 172, 174, 125, 122, 172, 174, 125, 122, 125, 122}, // LED 15
+    { 92,  75,  72,  75,  57,  54,  57,  75,  60,  41,  36,  41,  27,  18,  27,  21,
+       0,  21,  27,  18,  27,  13,  10,  62,  65,  13,  10,  62,  65,  62,  65, 105,
+     117, 116, 117, 135, 134, 135, 133, 148, 153, 152, 153, 171, 170, 171, 189, 188,
+     189, 206, 205, 206, 172, 172, 122, 123, 172, 172, 122, 123, 122, 123}, // LED 16
+    {103,  83,  75,  72,  54,  57,  68,  89,  76,  55,  41,  36,  18,  27,  45,  42,
+      21,   0,  18,  27,  45,  33,  14,  63,  75,  33,  14,  63,  75,  63,  75, 115,
+     123, 117, 116, 134, 135, 140, 141, 155, 157, 153, 152, 170, 171, 175, 192, 189,
+     188, 205, 206, 209, 175, 172, 122, 129, 175, 172, 122, 129, 122, 129}, // LED 17
+    {118,  99,  92,  90,  72,  75,  83, 102,  88,  68,  57,  54,  36,  41,  55,  45,
+      27,  18,   0,  21,  42,  41,  28,  81,  90,  41,  28,  81,  90,  81,  90, 131,
+     140, 135, 134, 152, 153, 157, 158, 171, 175, 171, 170, 188, 189, 192, 210, 207,
+     206, 223, 223, 226, 192, 190, 140, 146, 192, 190, 140, 146, 140, 146}, // LED 18
+    {108,  92,  90,  92,  75,  72,  75,  91,  74,  57,  54,  57,  41,  36,  41,  27,
+      18,  27,  21,   0,  21,  27,  26,  80,  82,  27,  26,  80,  82,  80,  82, 122,
+     135, 134, 135, 153, 152, 153, 150, 165, 171, 170, 171, 189, 188, 189, 207, 206,
+     207, 223, 223, 223, 190, 190, 140, 141, 190, 190, 140, 141, 140, 141}, // LED 19
+    {102,  90,  92,  99,  83,  75,  72,  83,  65,  54,  57,  68,  55,  41,  36,  18,
+      27,  45,  42,  21,   0,  26,  38,  85,  80,  26,  38,  85,  80,  85,  80, 116,
+     134, 135, 140, 157, 153, 152, 146, 161, 170, 171, 175, 192, 189, 188, 206, 207,
+     210, 226, 223, 223, 190, 192, 142, 140, 190, 192, 142, 140, 142, 140}, // LED 20
+    { 15,  32,  48,  67,  76,  60,  47,  34,  53,  64,  74,  87, 101,  89,  81,  99,
+     105, 115, 131, 122, 116,  94, 102,  61,  40,  94, 102,  61,  40,  61,  40,   0,
+      28,  46,  65,  73,  55,  42,  30,  45,  58,  69,  83,  96,  84,  75,  93, 100,
+     110, 125, 115, 110,  80,  90,  55,  32,  80,  90,  55,  32,  55,  32}, // LED 31
+    { 39,  44,  48,  60,  74,  65,  62,  57,  75,  80,  82,  90, 106, 100,  98, 116,
+     117, 123, 140, 135, 134, 109, 112,  61,  54, 109, 112,  61,  54,  61,  54,  28,
+       0,  21,  42,  45,  27,  18,  23,  33,  36,  41,  55,  68,  57,  54,  72,  75,
+      83,  98,  91,  89,  56,  63,  29,   6,  56,  63,  29,   6,  29,   6}, // LED 32
+    { 54,  48,  44,  48,  65,  62,  65,  67,  83,  82,  80,  82, 100,  98, 100, 117,
+     116, 117, 135, 134, 135, 109, 109,  54,  58, 109, 109,  54,  58,  54,  58,  46,
+      21,   0,  21,  27,  18,  27,  43,  49,  41,  36,  41,  57,  54,  57,  75,  72,
+      75,  91,  89,  91,  57,  56,  10,  22,  57,  56,  10,  22,  10,  22}, // LED 33
+    { 71,  60,  48,  44,  62,  65,  74,  82,  95,  90,  82,  80,  98, 100, 106, 123,
+     117, 116, 134, 135, 140, 113, 109,  55,  69, 113, 109,  55,  69,  55,  69,  65,
+      42,  21,   0,  18,  27,  45,  63,  68,  55,  41,  36,  54,  57,  68,  83,  75,
+      72,  89,  91,  98,  65,  57,  14,  43,  65,  57,  14,  43,  14,  43}, // LED 34
+    { 81,  74,  65,  62,  80,  82,  90,  94, 109, 106, 100,  98, 116, 117, 123, 140,
+     135, 134, 152, 153, 157, 131, 127,  73,  83, 131, 127,  73,  83,  73,  83,  73,
+      45,  27,  18,   0,  21,  42,  63,  63,  45,  27,  18,  36,  41,  55,  68,  57,
+      54,  71,  74,  82,  50,  40,  17,  44,  50,  40,  17,  44,  17,  44}, // LED 35
+    { 66,  65,  62,  65,  82,  80,  82,  82,  99, 100,  98, 100, 117, 116, 117, 135,
+     134, 135, 153, 152, 153, 127, 127,  72,  75, 127, 127,  72,  75,  72,  75,  55,
+      27,  18,  27,  21,   0,  21,  42,  42,  27,  18,  27,  41,  36,  41,  57,  54,
+      57,  74,  71,  74,  39,  38,  14,  25,  39,  38,  14,  25,  14,  25}, // LED 36
+    { 56,  62,  65,  74,  90,  82,  80,  74,  92,  98, 100, 106, 123, 117, 116, 134,
+     135, 140, 157, 153, 152, 127, 130,  77,  72, 127, 130,  77,  72,  77,  72,  42,
+      18,  27,  45,  42,  21,   0,  22,  22,  18,  27,  45,  55,  41,  36,  54,  57,
+      68,  82,  74,  71,  39,  47,  31,  12,  39,  47,  31,  12,  31,  12}, // LED 37
+    { 45,  58,  69,  83,  96,  84,  75,  64,  83,  93, 100, 110, 125, 116, 111, 128,
+     133, 141, 158, 150, 146, 123, 130,  82,  68, 123, 130,  82,  68,  82,  68,  30,
+      23,  43,  63,  63,  42,  22,   0,  15,  32,  48,  67,  76,  60,  47,  64,  74,
+      87, 100,  88,  80,  54,  67,  50,  20,  54,  67,  50,  20,  50,  20}, // LED 38
+    { 60,  73,  81,  94, 108,  97,  90,  79,  98, 108, 114, 123, 139, 130, 125, 143,
+     148, 155, 171, 165, 161, 138, 143,  94,  82, 138, 143,  94,  82,  94,  82,  45,
+      33,  49,  68,  63,  42,  22,  15,   0,  23,  43,  63,  68,  50,  35,  50,  62,
+      78,  89,  75,  66,  42,  58,  53,  28,  42,  58,  53,  28,  53,  28}, // LED 39
+    { 73,  80,  82,  90, 106, 100,  98,  91, 110, 116, 117, 123, 140, 135, 134, 152,
+     153, 157, 175, 171, 170, 145, 147,  94,  90, 145, 147,  94,  90,  94,  90,  58,
+      36,  41,  55,  45,  27,  18,  32,  23,   0,  21,  42,  45,  27,  18,  36,  41,
+      55,  67,  57,  53,  21,  35,  41,  30,  21,  35,  41,  30,  41,  30}, // LED 40
+    { 81,  82,  80,  82, 100,  98, 100,  98, 115, 117, 116, 117, 135, 134, 135, 153,
+     152, 153, 171, 170, 171, 145, 145,  90,  92, 145, 145,  90,  92,  90,  92,  69,
+      41,  36,  41,  27,  18,  27,  48,  43,  21,   0,  21,  27,  18,  27,  41,  36,
+      41,  57,  53,  57,  23,  21,  31,  37,  23,  21,  31,  37,  31,  37}, // LED 41
+    { 94,  90,  82,  80,  98, 100, 106, 109, 125, 123, 117, 116, 134, 135, 140, 157,
+     153, 152, 170, 171, 175, 148, 145,  90,  99, 148, 145,  90,  99,  90,  99,  83,
+      55,  41,  36,  18,  27,  45,  67,  63,  42,  21,   0,  18,  27,  45,  55,  41,
+      36,  53,  57,  67,  38,  23,  32,  52,  38,  23,  32,  52,  32,  52}, // LED 42
+    {108, 106, 100,  98, 116, 117, 123, 124, 140, 140, 135, 134, 152, 153, 157, 175,
+     171, 170, 188, 189, 192, 166, 163, 108, 116, 166, 163, 108, 116, 108, 116,  96,
+      68,  57,  54,  36,  41,  55,  76,  68,  45,  27,  18,   0,  21,  42,  45,  27,
+      18,  35,  40,  54,  33,  13,  49,  64,  33,  13,  49,  64,  49,  64}, // LED 43
+    { 97, 100,  98, 100, 117, 116, 117, 114, 132, 135, 134, 135, 153, 152, 153, 171,
+     170, 171, 189, 188, 189, 163, 163, 108, 110, 163, 163, 108, 110, 108, 110,  84,
+      57,  54,  57,  41,  36,  41,  60,  50,  27,  18,  27,  21,   0,  21,  27,  18,
+      27,  40,  35,  40,  12,   8,  48,  52,  12,   8,  48,  52,  48,  52}, // LED 44
+    { 90,  98, 100, 106, 123, 117, 116, 109, 127, 134, 135, 140, 157, 153, 152, 170,
+     171, 175, 192, 189, 188, 163, 165, 111, 108, 163, 165, 111, 108, 111, 108,  75,
+      54,  57,  68,  55,  41,  36,  47,  35,  18,  27,  45,  42,  21,   0,  18,  27,
+      45,  54,  40,  35,   9,  29,  56,  48,   9,  29,  56,  48,  56,  48}, // LED 45
+    {108, 116, 117, 123, 140, 135, 134, 126, 145, 152, 153, 157, 175, 171, 170, 188,
+     189, 192, 210, 207, 206, 181, 183, 129, 126, 181, 183, 129, 126, 129, 126,  93,
+      72,  75,  83,  68,  57,  54,  64,  50,  36,  41,  55,  45,  27,  18,   0,  21,
+      42,  45,  27,  17,  18,  33,  72,  66,  18,  33,  72,  66,  72,  66}, // LED 46
+    {114, 117, 116, 117, 135, 134, 135, 131, 150, 153, 152, 153, 171, 170, 171, 189,
+     188, 189, 207, 206, 207, 181, 181, 126, 127, 181, 181, 126, 127, 126, 127, 100,
+      75,  72,  75,  57,  54,  57,  74,  62,  41,  36,  41,  27,  18,  27,  21,   0,
+      21,  27,  17,  27,  20,  17,  66,  69,  20,  17,  66,  69,  66,  69}, // LED 47
+    {123, 123, 117, 116, 134, 135, 140, 139, 157, 157, 153, 152, 170, 171, 175, 192,
+     189, 188, 206, 207, 210, 183, 181, 126, 133, 183, 181, 126, 133, 126, 133, 110,
+      83,  75,  72,  54,  57,  68,  87,  78,  55,  41,  36,  18,  27,  45,  42,  21,
+       0,  17,  27,  45,  36,  20,  67,  78,  36,  20,  67,  78,  67,  78}, // LED 48
+    {138, 139, 134, 133, 151, 152, 156, 155, 172, 174, 170, 169, 187, 188, 191, 209,
+     206, 205, 223, 223, 226, 200, 198, 143, 149, 200, 198, 143, 149, 143, 149, 125,
+      98,  91,  89,  71,  74,  82, 100,  89,  67,  57,  53,  35,  40,  54,  45,  27,
+      17,   0,  21,  42,  46,  35,  84,  93,  46,  35,  84,  93,  84,  93}, // LED 49
+    {129, 134, 133, 134, 152, 151, 152, 148, 166, 170, 169, 170, 188, 187, 188, 206,
+     205, 206, 223, 223, 223, 198, 198, 143, 144, 198, 198, 143, 144, 143, 144, 115,
+      91,  89,  91,  74,  71,  74,  88,  75,  57,  53,  57,  40,  35,  40,  27,  17,
+      27,  21,   0,  21,  35,  33,  83,  85,  35,  33,  83,  85,  83,  85}, // LED 50
+    {124, 133, 134, 139, 156, 152, 151, 143, 162, 169, 170, 174, 191, 188, 187, 205,
+     206, 209, 226, 223, 223, 198, 200, 145, 143, 198, 200, 145, 143, 145, 143, 110,
+      89,  91,  98,  82,  74,  71,  80,  66,  53,  57,  67,  54,  40,  35,  17,  27,
+      45,  42,  21,   0,  34,  43,  87,  83,  34,  43,  87,  83,  87,  83}, // LED 51
+};
@@ -0,0 +1,286 @@
+// RGB matrix render thread and main loop profile (see rgb_thread.h)
+
+#include "rgb_thread.h"
+#include "stopwatch.h"
+#include <string.h>
+#include <ch.h>
+#include <hal.h>
+
+static rgb_thread_stats_t stats;
+
+#ifdef RGB_MATRIX_THREAD_ENABLE
+// ============================================================================
+// RENDER THREAD
+// ============================================================================
+
+_Static_assert((RGB_THREAD_HIT_QUEUE_SIZE & (RGB_THREAD_HIT_QUEUE_SIZE - 1)) == 0 && RGB_THREAD_HIT_QUEUE_SIZE <= 128, "RGB_THREAD_HIT_QUEUE_SIZE must be a power of two <= 128");
+
+#    define FRAME_TICKS TIME_MS2I(RGB_THREAD_FRAME_MS)
+#    define YIELD_TICKS (TIME_US2I(RGB_THREAD_YIELD_US) > 0 ? TIME_US2I(RGB_THREAD_YIELD_US) : 1)
+
+void __real_rgb_matrix_task(void);
+void __real_process_rgb_matrix(uint8_t row, uint8_t col, bool pressed);
+void __real_eeconfig_update_rgb_matrix(const rgb_config_t *config);
+
+static THD_WORKING_AREA(render_wa, RGB_THREAD_STACK_SIZE);
+static thread_t *render_thread;
+
+static volatile systime_t frame_start;    // Written by the thread only
+static volatile bool      frame_pending;  // Written by the thread only
+static volatile bool      frame_flushed;  // Set by the driver flush, in the thread
+
+// Key hits: single producer (main loop) advances head, single consumer
+// (thread) advances tail. 8-bit stores are atomic on the M0, no lock.
+typedef struct {
+    uint8_t row;
+    uint8_t col;
+    bool    pressed;
+} hit_t;
+
+static volatile hit_t   hits[RGB_THREAD_HIT_QUEUE_SIZE];
+static volatile uint8_t hit_head = 0;
+static volatile uint8_t hit_tail = 0;
+
+// EEPROM write requested by the thread, done by the main loop. The thread
+// clears the flag while it fills the copy; the main loop cannot be
+// preempted by it, so it never sees a half written copy.
+static rgb_config_t  eeprom_copy;
+static volatile bool eeprom_requested = false;
+
+// Render lock: the thread holds it for each step of QMK's task state
+// machine, the main loop around everything that can change RGB state (key
+// processing, raw HID, the slave's split sync, suspend). Priority
+// inheritance bounds the main loop's wait to one step. Between steps the
+// state may still change, as it does between main loop iterations in a
+// build without the thread.
+static MUTEX_DECL(render_lock);
+static uint8_t main_lock_depth = 0; // Main loop only, nests
+
+void rgb_thread_lock(void) {
+    if (main_lock_depth++ == 0) {
+        chMtxLock(&render_lock);
+    }
+}
+
+void rgb_thread_unlock(void) {
+    if (--main_lock_depth == 0) {
+        chMtxUnlock(&render_lock);
+    }
+}
+
+static void drain_hits(void) {
+    while (hit_tail != hit_head) {
+        volatile hit_t *hit = &hits[hit_tail & (RGB_THREAD_HIT_QUEUE_SIZE - 1)];
+        __real_process_rgb_matrix(hit->row, hit->col, hit->pressed);
+        hit_tail++;
+    }
+}
+
+// One frame per RGB_THREAD_FRAME_MS: run QMK's task state machine (sync,
+// start, render in chunks, flush) until the driver flush, then sleep to
+// the next frame. An overrun starts the next frame at once, without
+// catching up.
+static THD_FUNCTION(render, arg) {
+    chRegSetThreadName("rgb");
+    systime_t start = chVTGetSystemTimeX();
+
+    while (true) {
+        frame_start   = start;
+        frame_pending = true;
+        frame_flushed = false;
+        uint32_t cycles = stopwatch_now();
+
+        while (!frame_flushed) {
+            chMtxLock(&render_lock);
+            drain_hits();
+            __real_rgb_matrix_task();
+            chMtxUnlock(&render_lock);
+        }
+
+        frame_pending = false;
+        stats.frames++;
+        stats.frame_max_us = MAX(stats.frame_max_us, MIN(stopwatch_elapsed_us(cycles), UINT16_MAX));
+
+        if (chVTTimeElapsedSinceX(start) >= FRAME_TICKS) {
+            stats.overruns++;
+            start = chVTGetSystemTimeX();
+            continue;
+        }
+        systime_t next = chTimeAddX(start, FRAME_TICKS);
+        chThdSleepUntilWindowed(start, next);
+        start = next;
+    }
+}
+
+// Main loop side of rgb_matrix_task(): pending EEPROM write, then give the
+// thread the CPU while a frame is due. On the master it also runs while
+// the main loop waits on the split link and USB; the other half never
+// waits, so this sleep is its only hand-over.
+void __wrap_rgb_matrix_task(void) {
+    if (eeprom_requested) {
+        rgb_config_t config = eeprom_copy;
+        eeprom_requested    = false;
+        __real_eeconfig_update_rgb_matrix(&config);
+    }
+    if (frame_pending || chVTTimeElapsedSinceX(frame_start) >= FRAME_TICKS) {
+        chThdSleep(YIELD_TICKS);
+    }
+}
+
+void __wrap_process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
+    uint8_t head = hit_head;
+    if ((uint8_t)(head - hit_tail) >= RGB_THREAD_HIT_QUEUE_SIZE) {
+        if (stats.hits_dropped < UINT8_MAX) {
+            stats.hits_dropped++;
+        }
+        return;
+    }
+    volatile hit_t *hit = &hits[head & (RGB_THREAD_HIT_QUEUE_SIZE - 1)];
+    hit->row            = row;
+    hit->col            = col;
+    hit->pressed        = pressed;
+    hit_head            = head + 1;
+}
+
+void __wrap_eeconfig_update_rgb_matrix(const rgb_config_t *config) {
+    if (chThdGetSelfX() != render_thread) {
+        __real_eeconfig_update_rgb_matrix(config);
+        return;
+    }
+    eeprom_requested = false;
+    eeprom_copy      = *config;
+    eeprom_requested = true;
+}
+
+void rgb_thread_frame_done(void) {
+    frame_flushed = true;
+}
+
+// Main loop entry points that can change rgb_matrix_config or the task
+// state, see the render lock above
+void __real_action_exec(keyevent_t event);
+void __real_raw_hid_receive(uint8_t *data, uint8_t length);
+void __real_transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
+void __real_suspend_power_down_quantum(void);
+void __real_suspend_wakeup_init_quantum(void);
+
+void __wrap_action_exec(keyevent_t event) {
+    rgb_thread_lock();
+    __real_action_exec(event);
+    rgb_thread_unlock();
+}
+
+void __wrap_raw_hid_receive(uint8_t *data, uint8_t length) {
+    rgb_thread_lock();
+    __real_raw_hid_receive(data, length);
+    rgb_thread_unlock();
+}
+
+void __wrap_transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    rgb_thread_lock();
+    __real_transport_slave(master_matrix, slave_matrix);
+    rgb_thread_unlock();
+}
+
+void __wrap_suspend_power_down_quantum(void) {
+    rgb_thread_lock();
+    __real_suspend_power_down_quantum();
+    rgb_thread_unlock();
+}
+
+void __wrap_suspend_wakeup_init_quantum(void) {
+    rgb_thread_lock();
+    __real_suspend_wakeup_init_quantum();
+    rgb_thread_unlock();
+}
+#elif defined(RGB_MATRIX_ENABLE)
+void rgb_thread_frame_done(void) {
+    stats.frames++;
+}
+#endif
+
+// ============================================================================
+// MAIN LOOP PROFILE
+// ============================================================================
+
+static uint32_t loop_start;
+static bool     loop_started = false;
+
+void keyboard_post_init_kb(void) {
+    stopwatch_init();
+#ifdef RGB_MATRIX_ENABLE
+    // A brightness above the limit can only come from EEPROM written by
+    // another build (the rgb_matrix setters clamp). The gamma LUT of
+    // ws2812_fused.c already caps the output, this brings the setting back
+    // in range once, before the first frame, without an EEPROM write.
+    if (rgb_matrix_get_val() > RGB_MATRIX_MAXIMUM_BRIGHTNESS && rgb_matrix_is_enabled()) {
+        rgb_matrix_sethsv_noeeprom(rgb_matrix_get_hue(), rgb_matrix_get_sat(), RGB_MATRIX_MAXIMUM_BRIGHTNESS);
+    }
+#endif
+#ifdef RGB_MATRIX_THREAD_ENABLE
+    render_thread = chThdCreateStatic(render_wa, sizeof(render_wa), RGB_THREAD_PRIORITY, render, NULL);
+#endif
+    rgb_thread_lock();
+    keyboard_post_init_user();
+    rgb_thread_unlock();
+}
+
+// Once per main loop iteration: the time since the previous call is the
+// loop period a key event can wait for
+void housekeeping_task_kb(void) {
+    uint32_t now = stopwatch_now();
+    if (loop_started) {
+        uint32_t us     = stopwatch_elapsed_us(loop_start);
+        uint8_t  bucket = 0;
+        for (uint32_t limit = 128; us >= limit && bucket < RGB_THREAD_LOOP_BUCKETS - 1; limit <<= 1) {
+            bucket++;
+        }
+        stats.loops++;
+        stats.loop_max_us = MAX(stats.loop_max_us, MIN(us, UINT16_MAX));
+        if (stats.loop_hist[bucket] < UINT16_MAX) {
+            stats.loop_hist[bucket]++;
+        }
+    }
+    loop_start   = now;
+    loop_started = true;
+
+    housekeeping_task_user();
+}
+
+const rgb_thread_stats_t *rgb_thread_stats(void) {
+    return &stats;
+}
+
+// ============================================================================
+// RAW HID QUERY (host tool: keymaps/seniply/tools/loop_jitter.py)
+// ============================================================================
+
+void rgb_thread_raw_hid(uint8_t *data, uint8_t length) {
+    if (length < 31) {
+        return;
+    }
+    bool reset = data[1];
+
+    data[1] = 0;
+#ifdef RGB_MATRIX_ENABLE
+    data[1] |= 2;
+#endif
+#ifdef RGB_MATRIX_THREAD_ENABLE
+    data[1] |= 1;
+#endif
+    uint8_t i = stopwatch_put_u16(data, 2, stats.loops & 0xFFFF);
+    i         = stopwatch_put_u16(data, i, stats.loops >> 16);
+    i         = stopwatch_put_u16(data, i, stats.loop_max_us);
+    for (uint8_t bucket = 0; bucket < RGB_THREAD_LOOP_BUCKETS; bucket++) {
+        i = stopwatch_put_u16(data, i, stats.loop_hist[bucket]);
+    }
+    i       = stopwatch_put_u16(data, i, stats.frames);
+    i       = stopwatch_put_u16(data, i, stats.frame_max_us);
+    i       = stopwatch_put_u16(data, i, stats.overruns);
+    data[i] = stats.hits_dropped;
+
+    if (reset) {
+        memset(&stats, 0, sizeof(stats));
+        loop_started = false;
+    }
+}
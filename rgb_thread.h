@@ -0,0 +1,81 @@
+#pragma once
+
+#include "quantum.h"
+
+// RGB matrix rendering in its own ChibiOS thread (RGB_MATRIX_THREAD_ENABLE)
+// QMK calls rgb_matrix_task() from the main loop, so an effect frame (and
+// every split of it across loop iterations) lands between matrix scans.
+// With the thread enabled, the linker sends the main loop's calls to
+// rgb_thread.c instead (-Wl,--wrap, see rules.mk):
+//   rgb_matrix_task             only publishes work and yields while a frame
+//                               is due, the thread runs the real task
+//   process_rgb_matrix          key hits go through a lock-free queue, the
+//                               thread owns g_last_hit_tracker
+//   eeconfig_update_rgb_matrix  writes requested by the thread are done by
+//                               the main loop, EEPROM stays single threaded
+//   action_exec, raw_hid_receive, transport_slave, suspend_*_quantum
+//                               hold the render lock, so RGB keycodes, raw
+//                               HID, the slave's split sync and suspend
+//                               change rgb_matrix_config and the task state
+//                               between render steps, never during one
+// The thread runs below the main loop priority: it only gets the CPU while
+// the main loop waits (split transaction, USB) or yields, so scan ->
+// report never waits for an LED frame. Render callbacks must not read
+// multi-word main loop state directly; keymap state reaches them as a
+// single published word (key_indicators.c).
+//
+// Main loop period is profiled with or without the thread, and without
+// the RGB matrix, so the builds can be compared (rgb_thread_raw_hid,
+// tools/loop_jitter.py).
+
+#ifndef RGB_THREAD_PRIORITY
+#    define RGB_THREAD_PRIORITY (NORMALPRIO - 1)
+#endif
+
+#ifndef RGB_THREAD_STACK_SIZE
+#    define RGB_THREAD_STACK_SIZE 512
+#endif
+
+#ifndef RGB_THREAD_FRAME_MS
+#    define RGB_THREAD_FRAME_MS RGB_MATRIX_LED_FLUSH_LIMIT // Frame period and budget
+#endif
+
+#ifndef RGB_THREAD_YIELD_US
+#    define RGB_THREAD_YIELD_US 100 // Main loop sleep per iteration while a frame is due
+#endif
+
+#ifndef RGB_THREAD_HIT_QUEUE_SIZE
+#    define RGB_THREAD_HIT_QUEUE_SIZE 16 // Key hits, power of two <= 128
+#endif
+
+#define RGB_THREAD_LOOP_BUCKETS 8 // Main loop period: < 128 us, doubling, >= 8 ms
+
+typedef struct {
+    uint32_t loops;
+    uint16_t loop_max_us;
+    uint16_t loop_hist[RGB_THREAD_LOOP_BUCKETS]; // Saturating counts
+    uint16_t frames;
+    uint16_t frame_max_us; // Frame start -> flush, wall time
+    uint16_t overruns;     // Frames longer than RGB_THREAD_FRAME_MS
+    uint8_t  hits_dropped; // Hit queue full
+} rgb_thread_stats_t;
+
+const rgb_thread_stats_t *rgb_thread_stats(void);
+
+// Called by the LED driver flush at the end of each frame
+void rgb_thread_frame_done(void);
+
+// Around other main loop code that changes RGB matrix state (nests)
+#ifdef RGB_MATRIX_THREAD_ENABLE
+void rgb_thread_lock(void);
+void rgb_thread_unlock(void);
+#else
+static inline void rgb_thread_lock(void) {}
+static inline void rgb_thread_unlock(void) {}
+#endif
+
+// Handle a raw HID query: [cmd, reset] -> [cmd, flags (1 = threaded,
+// 2 = RGB matrix), loops u32,
+// loop max us u16, loop histogram 8 x u16, frames u16, frame max us u16,
+// overruns u16, hits dropped u8]
+void rgb_thread_raw_hid(uint8_t *data, uint8_t length);
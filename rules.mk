@@ -1,3 +1,15 @@
 SERIAL_DRIVER = usart
 RGB_MATRIX_ENABLE = yes
-NO_USB_STARTUP_CHECK = yes
\ No newline at end of file
+NO_USB_STARTUP_CHECK = yes
+RGB_MATRIX_CUSTOM_KB = yes
+SRC += ws2812_fused.c
+SRC += rgb_thread.c
+SRC += serial_dma.c
+SRC += usb_sof.c
+SRC += stopwatch.c
+
+# Defaults only: a keymap rules.mk is read after this file and may override
+# them, so the flags and linker wraps are set in post_rules.mk
+RGB_MATRIX_THREAD_ENABLE ?= yes
+SERIAL_DMA_ENABLE ?= yes
+USB_SOF_SCHEDULE_ENABLE ?= no  # Turns the serial_dma.c pipeline off while aligned, see usb_sof.h
@@ -0,0 +1,306 @@
+// Split transport over USART1 with DMA and a pipelined slave matrix read
+// QMK's serial_usart.c runs the link through the ChibiOS serial driver (an
+// interrupt per byte) and the master waits out every exchange in the middle
+// of its scan. With SERIAL_DMA_ENABLE the linker sends the driver calls of
+// QMK's serial_protocol.c here instead (-Wl,--wrap, see rules.mk):
+//   RX  circular DMA into a ring, no interrupt per byte. A reader short of
+//       bytes sleeps until the start bit of the next one (EXTI on the RX
+//       pin), so a thread waiting on the link leaves the CPU to others,
+//       the slave's high priority thread included.
+//   TX  one DMA transfer per send, which returns as soon as it is queued.
+// On top of that the master pipelines the slave matrix: when
+// transport_master() is done with a scan's transactions, the requests for
+// the next scan's matrix checksum and data go out together. The slave
+// answers while the master runs the keymap, USB and its own next scan, and
+// soft_serial_transaction() for either ID is then served from the replies
+// already received. Any other transaction first collects the replies in
+// flight, so the byte stream stays in order and the slave side is QMK's.
+// A prefetch that times out fails the transaction it was collected for, so
+// a missing slave costs one timeout per scan, and no prefetch goes out
+// while the transport is disconnected.
+//
+// The pipeline and scans held to the USB frame (usb_sof.c) exclude each
+// other: an aligned scan is a frame after the previous one, so its
+// prefetched matrix would be a frame old. The pipeline is the default;
+// USB_SOF_SCHEDULE_ENABLE is opt-in and turns the pipeline off while SOFs
+// arrive.
+//
+// USART1 TX/RX DMA requests are remapped to DMA1 channels 4/5 (channel 2
+// drives the WS2812s, channel 3 is SPI1 TX).
+
+#include "quantum.h"
+#include "serial.h"
+#include "transactions.h"
+#include <hal.h>
+#include <string.h>
+#ifdef USB_SOF_SCHEDULE_ENABLE
+#    include "usb_sof.h"
+#endif
+
+#if defined(SPLIT_KEYBOARD) && defined(SERIAL_DMA_ENABLE)
+
+#    ifndef SERIAL_USART_FULL_DUPLEX
+#        error "serial_dma.c needs SERIAL_USART_FULL_DUPLEX (separate TX and RX lines)"
+#    endif
+
+#    ifndef SERIAL_USART_TIMEOUT
+#        define SERIAL_USART_TIMEOUT 20 // ms per exchange, same default as serial_usart.c
+#    endif
+#    ifndef SERIAL_DMA_RX_SIZE
+#        define SERIAL_DMA_RX_SIZE 128 // Ring, power of two
+#    endif
+#    ifndef SERIAL_DMA_TX_SIZE
+#        define SERIAL_DMA_TX_SIZE 64
+#    endif
+#    ifndef SERIAL_DMA_PREFETCH_AGE_US
+#        define SERIAL_DMA_PREFETCH_AGE_US 1000 // Older matrix replies are read again instead
+#    endif
+#    ifndef HANDSHAKE_MAGIC
+#        define HANDSHAKE_MAGIC 7 // Slave's token: the transaction ID XOR this (serial_protocol.c)
+#    endif
+
+#    define SERIAL_DMA_TX_STREAM STM32_DMA1_STREAM4
+#    define SERIAL_DMA_RX_STREAM STM32_DMA1_STREAM5
+#    define SERIAL_DMA_TIMEOUT TIME_MS2I(SERIAL_USART_TIMEOUT)
+
+_Static_assert((SERIAL_DMA_RX_SIZE & (SERIAL_DMA_RX_SIZE - 1)) == 0, "SERIAL_DMA_RX_SIZE must be a power of two");
+
+static uint8_t  rx_ring[SERIAL_DMA_RX_SIZE];
+static uint8_t  tx_buffer[SERIAL_DMA_TX_SIZE];
+static uint16_t rx_tail = 0; // Next byte to read
+
+// ============================================================================
+// RX RING
+// ============================================================================
+
+static uint16_t rx_head(void) {
+    return (SERIAL_DMA_RX_SIZE - dmaStreamGetTransactionSize(SERIAL_DMA_RX_STREAM)) & (SERIAL_DMA_RX_SIZE - 1);
+}
+
+static uint16_t rx_available(void) {
+    return (rx_head() - rx_tail) & (SERIAL_DMA_RX_SIZE - 1);
+}
+
+// Until `size` bytes are in the ring, sleeping on the start bit of each
+// missing byte. A byte already in reception had its start bit: when it is
+// the last one missing, the wait spins for the rest of it (one byte time,
+// 22 us at 460800 baud), otherwise it sleeps until the next start bit.
+static bool rx_wait(size_t size, sysinterval_t timeout) {
+    systime_t start = chVTGetSystemTimeX();
+
+    while (rx_available() < size) {
+        sysinterval_t waited = chVTTimeElapsedSinceX(start);
+        if (timeout != TIME_INFINITE && waited >= timeout) {
+            return false;
+        }
+        // The event is armed before the check: a start bit is either seen
+        // by the USART (BUSY, RXNE) or wakes the wait
+        chSysLock();
+        palEnableLineEventI(SERIAL_USART_RX_PIN, PAL_EVENT_MODE_FALLING_EDGE);
+        uint16_t missing   = size - rx_available();
+        bool     receiving = USART1->ISR & (USART_ISR_BUSY | USART_ISR_RXNE);
+        if (missing > (receiving ? 1 : 0)) {
+            palWaitLineTimeoutS(SERIAL_USART_RX_PIN, timeout == TIME_INFINITE ? TIME_INFINITE : timeout - waited);
+        }
+        palDisableLineEventI(SERIAL_USART_RX_PIN);
+        chSysUnlock();
+    }
+    return true;
+}
+
+static bool rx_read(uint8_t *destination, size_t size, sysinterval_t timeout) {
+    if (!rx_wait(size, timeout)) {
+        return false;
+    }
+    while (size--) {
+        *destination++ = rx_ring[rx_tail];
+        rx_tail        = (rx_tail + 1) & (SERIAL_DMA_RX_SIZE - 1);
+    }
+    return true;
+}
+
+// ============================================================================
+// TX
+// ============================================================================
+
+static bool tx_wait_idle(void) {
+    systime_t start = chVTGetSystemTimeX();
+    while (dmaStreamGetTransactionSize(SERIAL_DMA_TX_STREAM) > 0) {
+        if (chVTTimeElapsedSinceX(start) >= SERIAL_DMA_TIMEOUT) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool tx_send(const uint8_t *source, size_t size) {
+    while (size > 0) {
+        if (!tx_wait_idle()) {
+            return false;
+        }
+        size_t chunk = MIN(size, sizeof(tx_buffer));
+        memcpy(tx_buffer, source, chunk);
+        dmaStreamDisable(SERIAL_DMA_TX_STREAM);
+        dmaStreamSetMemory0(SERIAL_DMA_TX_STREAM, tx_buffer);
+        dmaStreamSetTransactionSize(SERIAL_DMA_TX_STREAM, chunk);
+        dmaStreamSetMode(SERIAL_DMA_TX_STREAM, STM32_DMA_CR_DIR_M2P | STM32_DMA_CR_PSIZE_BYTE | STM32_DMA_CR_MSIZE_BYTE | STM32_DMA_CR_MINC | STM32_DMA_CR_PL(2));
+        dmaStreamEnable(SERIAL_DMA_TX_STREAM);
+        source += chunk;
+        size -= chunk;
+    }
+    return true;
+}
+
+// ============================================================================
+// HARDWARE
+// ============================================================================
+
+static void usart_start(void) {
+    palSetLineMode(SERIAL_USART_TX_PIN, PAL_MODE_ALTERNATE(SERIAL_USART_TX_PAL_MODE) | PAL_STM32_OTYPE_PUSHPULL | PAL_STM32_OSPEED_HIGHEST);
+    palSetLineMode(SERIAL_USART_RX_PIN, PAL_MODE_ALTERNATE(SERIAL_USART_RX_PAL_MODE) | PAL_STM32_PUPDR_PULLUP); // Idle high without the other half
+
+    rccEnableUSART1(true);
+    SYSCFG->CFGR1 |= SYSCFG_CFGR1_USART1TX_DMA_RMP | SYSCFG_CFGR1_USART1RX_DMA_RMP;
+
+    dmaStreamAlloc(SERIAL_DMA_RX_STREAM - STM32_DMA_STREAM(0), 3, NULL, NULL);
+    dmaStreamSetPeripheral(SERIAL_DMA_RX_STREAM, &USART1->RDR);
+    dmaStreamSetMemory0(SERIAL_DMA_RX_STREAM, rx_ring);
+    dmaStreamSetTransactionSize(SERIAL_DMA_RX_STREAM, SERIAL_DMA_RX_SIZE);
+    dmaStreamSetMode(SERIAL_DMA_RX_STREAM, STM32_DMA_CR_DIR_P2M | STM32_DMA_CR_PSIZE_BYTE | STM32_DMA_CR_MSIZE_BYTE | STM32_DMA_CR_MINC | STM32_DMA_CR_CIRC | STM32_DMA_CR_PL(3));
+    dmaStreamEnable(SERIAL_DMA_RX_STREAM);
+    rx_tail = 0;
+
+    dmaStreamAlloc(SERIAL_DMA_TX_STREAM - STM32_DMA_STREAM(0), 3, NULL, NULL);
+    dmaStreamSetPeripheral(SERIAL_DMA_TX_STREAM, &USART1->TDR);
+
+    // 8N1, overrun detection off: a late DMA read loses a byte, it does not
+    // stop reception (the transaction checksums catch the loss)
+    USART1->CR1 = 0;
+    USART1->BRR = (STM32_USART1CLK + SERIAL_USART_SPEED / 2) / SERIAL_USART_SPEED;
+    USART1->CR2 = 0;
+    USART1->CR3 = USART_CR3_DMAR | USART_CR3_DMAT | USART_CR3_OVRDIS;
+    USART1->CR1 = USART_CR1_UE | USART_CR1_TE | USART_CR1_RE;
+}
+
+// ============================================================================
+// DRIVER (called by QMK's serial_protocol.c)
+// ============================================================================
+
+void __wrap_serial_transport_driver_master_init(void) {
+    usart_start();
+}
+
+void __wrap_serial_transport_driver_slave_init(void) {
+    usart_start();
+}
+
+void __wrap_serial_transport_driver_clear(void) {
+    rx_tail = rx_head();
+}
+
+bool __wrap_serial_transport_send(const uint8_t *source, const size_t size) {
+    return tx_send(source, size);
+}
+
+bool __wrap_serial_transport_receive(uint8_t *destination, const size_t size) {
+    return rx_read(destination, size, SERIAL_DMA_TIMEOUT);
+}
+
+bool __wrap_serial_transport_receive_blocking(uint8_t *destination, const size_t size) {
+    return rx_read(destination, size, TIME_INFINITE);
+}
+
+// ============================================================================
+// SLAVE MATRIX PIPELINE (master)
+// ============================================================================
+// Both IDs only read from the slave (no initiator data), so their requests
+// are a single byte each and the slave answers them back to back, each
+// reply framed as in serial_protocol.c: the handshake token, then the
+// transaction's target2initiator buffer.
+
+bool __real_soft_serial_transaction(int index);
+bool __real_transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
+
+static const uint8_t prefetch_ids[] = {GET_SLAVE_MATRIX_CHECKSUM, GET_SLAVE_MATRIX_DATA};
+
+static uint8_t   prefetch_reply[16];
+static bool      prefetch_in_flight = false;
+static uint8_t   prefetch_ready     = 0; // Bit per prefetch_ids entry
+static systime_t prefetch_time;
+
+static void prefetch_send(void) {
+    __wrap_serial_transport_driver_clear();
+    prefetch_ready     = 0;
+    prefetch_time      = chVTGetSystemTimeX();
+    prefetch_in_flight = tx_send(prefetch_ids, sizeof(prefetch_ids));
+}
+
+// Replies of the requests in flight, in request order. False when they
+// timed out or a handshake token does not match its request.
+static bool prefetch_collect(void) {
+    if (!prefetch_in_flight) {
+        return true;
+    }
+    prefetch_in_flight = false;
+    uint8_t *reply     = prefetch_reply;
+    for (uint8_t i = 0; i < ARRAY_SIZE(prefetch_ids); i++) {
+        uint8_t size = split_transaction_table[prefetch_ids[i]].target2initiator_buffer_size;
+        if (reply + size > prefetch_reply + sizeof(prefetch_reply)) {
+            return true; // Not prefetchable, read by the transaction itself
+        }
+        uint8_t token;
+        if (!rx_read(&token, sizeof(token), SERIAL_DMA_TIMEOUT) || token != (prefetch_ids[i] ^ HANDSHAKE_MAGIC)) {
+            return false;
+        }
+        if (!rx_read(reply, size, SERIAL_DMA_TIMEOUT)) {
+            return false;
+        }
+        prefetch_ready |= 1 << i;
+        reply += size;
+    }
+    return true;
+}
+
+bool __wrap_soft_serial_transaction(int index) {
+    // The timeout was this transaction's: no second exchange to wait out
+    if (!prefetch_collect()) {
+        prefetch_ready = 0;
+        return false;
+    }
+
+    if (chVTTimeElapsedSinceX(prefetch_time) < TIME_US2I(SERIAL_DMA_PREFETCH_AGE_US)) {
+        const uint8_t *reply = prefetch_reply;
+        for (uint8_t i = 0; i < ARRAY_SIZE(prefetch_ids); i++) {
+            split_transaction_desc_t *trans = &split_transaction_table[prefetch_ids[i]];
+            if (prefetch_ids[i] == index && (prefetch_ready & (1 << i))) {
+                prefetch_ready &= ~(1 << i);
+                memcpy(split_trans_target2initiator_buffer(trans), reply, trans->target2initiator_buffer_size);
+                return true;
+            }
+            reply += trans->target2initiator_buffer_size;
+        }
+    }
+    prefetch_ready = 0;
+    return __real_soft_serial_transaction(index);
+}
+
+// Held to the USB frame, the next scan is a frame away and its reply would
+// be too old by then: the transaction runs in the scan slot instead
+bool __wrap_transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    bool okay = __real_transport_master(master_matrix, slave_matrix);
+    if (!prefetch_collect()) {
+        prefetch_ready = 0;
+    }
+    if (!is_transport_connected()) {
+        return okay;
+    }
+#    ifdef USB_SOF_SCHEDULE_ENABLE
+    if (usb_sof_aligned()) {
+        return okay;
+    }
+#    endif
+    prefetch_send();
+    return okay;
+}
+
+#endif // SPLIT_KEYBOARD && SERIAL_DMA_ENABLE
@@ -0,0 +1,25 @@
+#include "stopwatch.h"
+
+#define STOPWATCH_MASK 0x00FFFFFF
+
+void stopwatch_init(void) {
+    if (SysTick->CTRL & SysTick_CTRL_ENABLE_Msk) {
+        return;
+    }
+    SysTick->LOAD = STOPWATCH_MASK;
+    SysTick->VAL  = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+}
+
+uint32_t stopwatch_now(void) {
+    return SysTick->VAL;
+}
+
+// Down-counter: elapsed = start - now (mod 2^24)
+uint32_t stopwatch_elapsed_cycles(uint32_t start) {
+    return (start - SysTick->VAL) & STOPWATCH_MASK;
+}
+
+uint32_t stopwatch_elapsed_us(uint32_t start) {
+    return stopwatch_elapsed_cycles(start) / STOPWATCH_CYCLES_PER_US;
+}
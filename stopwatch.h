@@ -0,0 +1,29 @@
+#pragma once
+
+#include "quantum.h"
+
+// Microsecond stopwatch on the Cortex-M SysTick counter
+// ChibiOS runs tickless on TIM3 here (STM32_ST_USE_TIMER 3), so SysTick is
+// free: it is set up as a free-running 24-bit down-counter at the core
+// clock with no interrupt. Spans must stay below 2^24 cycles (~349 ms at
+// 48 MHz). Shared by the loop and frame profile (rgb_thread.c), the SOF
+// schedule (usb_sof.c) and keymap measurements.
+
+#define STOPWATCH_CYCLES_PER_US (STM32_SYSCLK / 1000000)
+
+// Start the counter (idempotent)
+void stopwatch_init(void);
+
+// Current counter value, pass to stopwatch_elapsed_*()
+uint32_t stopwatch_now(void);
+
+uint32_t stopwatch_elapsed_cycles(uint32_t start);
+uint32_t stopwatch_elapsed_us(uint32_t start);
+
+// Little-endian 16-bit value at data[i] of a raw HID reply, returns the
+// next index. The profile queries report their measurements with it.
+static inline uint8_t stopwatch_put_u16(uint8_t *data, uint8_t i, uint16_t value) {
+    data[i]     = value & 0xFF;
+    data[i + 1] = value >> 8;
+    return i + 2;
+}
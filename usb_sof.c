@@ -0,0 +1,185 @@
+// USB start-of-frame aligned matrix scan (see usb_sof.h)
+
+#include "usb_sof.h"
+#include "stopwatch.h"
+#include <string.h>
+#include <ch.h>
+#include <hal.h>
+
+#ifdef USB_SOF_SCHEDULE_ENABLE
+
+#    define TICK_US TIME_I2US(1)
+
+_Static_assert(USB_SOF_LEAD_MIN_US < USB_SOF_FRAME_US / 2, "USB_SOF_LEAD_MIN_US must be under half a frame");
+
+void    __real_usbStart(USBDriver *usbp, const USBConfig *config);
+uint8_t __real_matrix_scan(void);
+void    __real_host_keyboard_send(report_keyboard_t *report);
+
+static usb_sof_stats_t stats;
+static uint32_t        frames_base = 0; // frames at the last stats reset
+static bool            enabled     = true;
+
+// ============================================================================
+// SOF REFERENCE
+// ============================================================================
+
+static USBConfig     usb_config; // QMK's, with our SOF callback
+static usbcallback_t qmk_sof_cb;
+
+static volatile uint32_t  frames = 0;
+static volatile uint32_t  sof_cycles; // SysTick at the last SOF
+static volatile systime_t sof_time;
+
+static void sof_cb(USBDriver *usbp) {
+    sof_cycles = stopwatch_now();
+    sof_time   = chVTGetSystemTimeX();
+    frames++;
+    if (qmk_sof_cb != NULL) {
+        qmk_sof_cb(usbp);
+    }
+}
+
+// The ChibiOS USB driver enables the SOF interrupt when the config has a
+// callback; QMK restarts the driver with the same config after a suspend
+void __wrap_usbStart(USBDriver *usbp, const USBConfig *config) {
+    stopwatch_init();
+    if (config != &usb_config) {
+        qmk_sof_cb        = config->sof_cb;
+        usb_config        = *config;
+        usb_config.sof_cb = sof_cb;
+    }
+    __real_usbStart(usbp, &usb_config);
+}
+
+// SysTick stamp of the last SOF and its frame number, read consistently
+// with the interrupt
+static uint32_t sof_stamp(uint32_t *frame) {
+    uint32_t stamp;
+    do {
+        *frame = frames;
+        stamp  = sof_cycles;
+    } while (*frame != frames);
+    return stamp;
+}
+
+static bool sof_arriving(void) {
+    return frames != 0 && chVTTimeElapsedSinceX(sof_time) < TIME_US2I(USB_SOF_TIMEOUT_US);
+}
+
+bool usb_sof_aligned(void) {
+    return enabled && sof_arriving();
+}
+
+// ============================================================================
+// SCAN SLOT
+// ============================================================================
+
+static uint32_t scan_cycles;     // SysTick at the last scan start
+static uint32_t scan_frame;      // Frame the last scan started in
+static uint16_t peak_us = 0;     // Scan -> report, decays 1 us per scan
+static uint16_t lead_us = USB_SOF_LEAD_MIN_US;
+
+// Sleep in system ticks while two are left, busy-wait the rest
+static void wait_until(uint32_t start, uint32_t us) {
+    uint32_t elapsed = stopwatch_elapsed_us(start);
+    if (us > elapsed + 2 * TICK_US) {
+        chThdSleep((us - elapsed) / TICK_US - 1);
+    }
+    while (stopwatch_elapsed_us(start) < us) {
+    }
+}
+
+// A slot missed by more than half the guard waits for the next frame's
+static void wait_for_slot(void) {
+    uint32_t frame;
+    uint32_t stamp = sof_stamp(&frame);
+    uint32_t since = stopwatch_elapsed_us(stamp);
+    while (since >= USB_SOF_FRAME_US) { // SOF interrupt still pending or lost
+        stamp -= USB_SOF_FRAME_US * STOPWATCH_CYCLES_PER_US;
+        since -= USB_SOF_FRAME_US;
+    }
+    uint32_t slot = USB_SOF_FRAME_US - lead_us;
+    if (since > slot + USB_SOF_GUARD_US / 2) {
+        slot += USB_SOF_FRAME_US;
+    }
+    wait_until(stamp, slot);
+}
+
+uint8_t __wrap_matrix_scan(void) {
+    if (usb_sof_aligned()) {
+        wait_for_slot();
+    }
+    scan_cycles = stopwatch_now();
+    scan_frame  = frames;
+
+    if (peak_us > 0) {
+        peak_us--;
+    }
+    lead_us = MIN(MAX(peak_us + USB_SOF_GUARD_US, USB_SOF_LEAD_MIN_US), USB_SOF_FRAME_US / 2);
+    return __real_matrix_scan();
+}
+
+// Reports from blocking waits (tap_code delays, EEPROM) take longer than
+// half a frame: they miss the poll anyway and are kept out of the lead
+void __wrap_host_keyboard_send(report_keyboard_t *report) {
+    __real_host_keyboard_send(report);
+    if (!sof_arriving()) {
+        return;
+    }
+    uint32_t frame;
+    uint32_t since  = stopwatch_elapsed_us(sof_stamp(&frame));
+    uint32_t slack  = since < USB_SOF_FRAME_US ? USB_SOF_FRAME_US - since : 0;
+    uint8_t  bucket = MIN(slack * USB_SOF_SLACK_BUCKETS / USB_SOF_FRAME_US, USB_SOF_SLACK_BUCKETS - 1);
+
+    if (stats.slack_hist[bucket] < UINT16_MAX) {
+        stats.slack_hist[bucket]++;
+    }
+    stats.reports++;
+    stats.late += frame != scan_frame;
+
+    uint32_t scan_us = stopwatch_elapsed_us(scan_cycles);
+    if (scan_us < USB_SOF_FRAME_US / 2) {
+        peak_us                  = MAX(peak_us, scan_us);
+        stats.scan_report_max_us = MAX(stats.scan_report_max_us, scan_us);
+    }
+}
+
+const usb_sof_stats_t *usb_sof_stats(void) {
+    stats.frames  = frames - frames_base;
+    stats.lead_us = lead_us;
+    return &stats;
+}
+
+// ============================================================================
+// RAW HID QUERY (host tool: keymaps/seniply/tools/sof_timing.py)
+// ============================================================================
+
+void usb_sof_raw_hid(uint8_t *data, uint8_t length) {
+    if (length < 30) {
+        return;
+    }
+    uint8_t flags = data[1];
+    if (flags & 2) {
+        enabled = flags & 4;
+    }
+
+    const usb_sof_stats_t *s = usb_sof_stats();
+    data[1]                  = enabled | sof_arriving() << 1;
+    uint8_t i                = stopwatch_put_u16(data, 2, s->frames & 0xFFFF);
+    i                        = stopwatch_put_u16(data, i, s->frames >> 16);
+    i                        = stopwatch_put_u16(data, i, s->reports);
+    i                        = stopwatch_put_u16(data, i, s->late);
+    for (uint8_t bucket = 0; bucket < USB_SOF_SLACK_BUCKETS; bucket++) {
+        i = stopwatch_put_u16(data, i, s->slack_hist[bucket]);
+    }
+    i = stopwatch_put_u16(data, i, s->lead_us);
+    stopwatch_put_u16(data, i, s->scan_report_max_us);
+
+    if (flags & 1) {
+        memset(&stats, 0, sizeof(stats));
+        frames_base = frames;
+    }
+}
+
+#endif // USB_SOF_SCHEDULE_ENABLE
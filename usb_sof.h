@@ -0,0 +1,71 @@
+#pragma once
+
+#include "quantum.h"
+
+// Matrix scan aligned to the USB start of frame (USB_SOF_SCHEDULE_ENABLE)
+// On full speed USB the host polls the keyboard endpoint once per 1 ms
+// frame, right after the SOF. A free-running main loop finishes a report
+// anywhere in the frame, so it waits 0-1 ms for the poll, and how long
+// depends on what the loop happened to be doing (RGB, split link). Here the
+// SOF interrupt is the time reference and the scan runs in the slot that
+// ends just before the next poll (-Wl,--wrap, see rules.mk):
+//   usbStart            QMK's USB config gets a SOF callback that stamps
+//                       each frame (QMK's own callback still runs)
+//   matrix_scan         held until USB_SOF_FRAME_US - lead after the SOF;
+//                       the wait goes to the RGB thread and housekeeping
+//   host_keyboard_send  time from scan to report, slack before the SOF
+//
+//   SOF ....... wait (RGB, housekeeping) ...... | scan, split, keymap, report | SOF poll
+//
+// The lead is the longest scan -> report time seen lately (decaying) plus
+// USB_SOF_GUARD_US, split transaction included. The wait sleeps in system
+// ticks and busy-waits the last tick or two on SysTick. Without SOFs
+// (suspended, the half without USB) the loop runs freely. Alignment can be
+// switched at run time to compare both (usb_sof_raw_hid,
+// keymaps/seniply/tools/sof_timing.py).
+//
+// Off by default (USB_SOF_SCHEDULE_ENABLE = yes to opt in): it excludes the
+// pipelined slave matrix read of serial_dma.c, which is the default. While
+// aligned the pipeline is off, since a request sent ahead of the slot would
+// only read the right half that much earlier. Aligned scans cut edge ->
+// host by 0.1-0.55 ms in the split bench (sim/README.md), but hold the main
+// loop in a wait every frame, busy for its last tick or two; the pipeline
+// keeps the loop free and the link off its critical path.
+
+#ifndef USB_SOF_FRAME_US
+#    define USB_SOF_FRAME_US 1000 // Full speed frame
+#endif
+
+#ifndef USB_SOF_GUARD_US
+#    define USB_SOF_GUARD_US 50 // Margin on top of the measured scan -> report time
+#endif
+
+#ifndef USB_SOF_LEAD_MIN_US
+#    define USB_SOF_LEAD_MIN_US 100
+#endif
+
+#ifndef USB_SOF_TIMEOUT_US
+#    define USB_SOF_TIMEOUT_US 3000 // No SOF for this long: run freely
+#endif
+
+#define USB_SOF_SLACK_BUCKETS 8 // Report -> next SOF, USB_SOF_FRAME_US / 8 wide
+
+typedef struct {
+    uint32_t frames;             // SOF interrupts
+    uint16_t reports;            // Keyboard reports sent
+    uint16_t late;               // ... after the SOF their scan was due for
+    uint16_t slack_hist[USB_SOF_SLACK_BUCKETS]; // Saturating counts
+    uint16_t lead_us;            // Current slot lead
+    uint16_t scan_report_max_us; // Longest scan -> report
+} usb_sof_stats_t;
+
+const usb_sof_stats_t *usb_sof_stats(void);
+
+// Scans are held to the SOF slot right now (enabled and SOFs arriving)
+bool usb_sof_aligned(void);
+
+// Handle a raw HID query: [cmd, flags (bit 0 reset, bit 1 set alignment
+// to bit 2)] -> [cmd, flags (bit 0 aligned, bit 1 SOFs arriving), frames
+// u32, reports u16, late u16, slack histogram 8 x u16, lead us u16,
+// scan -> report max us u16]
+void usb_sof_raw_hid(uint8_t *data, uint8_t length);
@@ -0,0 +1,276 @@
+// WS2812 driver with a fused colour pipeline (WS2812_DRIVER = custom)
+// The stock PWM driver keeps an RGB array that ws2812_set_color fills and
+// ws2812_flush then encodes, LED by LED, into one 32-bit duty value per bit.
+// Here the colour work is folded into fewer steps:
+//   rgb_matrix_hsv_to_rgb  hue sector and ramp from a flash LUT, no division
+//   ws2812_set_color       gamma + brightness limit LUT, stores the output
+//                          levels in GRB order
+//   ws2812_flush           power scale from the frame's level sum, then each
+//                          byte is written as 8 duty bytes (two word stores)
+// so every frame is encoded once, with the scale it is shown at. The DMA
+// reads bytes and writes them zero extended to the 32-bit CCR, which keeps
+// a buffer at one byte per bit, for this half's LEDs only.
+//
+// There are two buffers: the DMA streams the front one in a loop while the
+// flush encodes the frame into the back one, then swaps them at the end of
+// a pass, so the LEDs never latch a half written frame.
+
+#include "quantum.h"
+#include "ws2812.h"
+#include "rgb_thread.h"
+#include <hal.h>
+
+#ifdef RGB_MATRIX_ENABLE
+
+// ============================================================================
+// TIMING (same defaults as the stock ChibiOS PWM driver)
+// ============================================================================
+
+#    ifndef WS2812_PWM_TARGET_PERIOD
+#        define WS2812_PWM_TARGET_PERIOD 800000
+#    endif
+#    ifndef WS2812_PWM_FREQUENCY
+#        define WS2812_PWM_FREQUENCY (STM32_SYSCLK / 2)
+#    endif
+#    ifndef WS2812_FUSED_LED_COUNT
+#        define WS2812_FUSED_LED_COUNT WS2812_LED_COUNT
+#    endif
+
+// Power estimate: WS2812B current per colour channel at full duty and per
+// LED with all channels off. The budget is per half, each half drives its
+// own LEDs from the one USB port.
+#    ifndef WS2812_POWER_BUDGET_MA
+#        define WS2812_POWER_BUDGET_MA 200
+#    endif
+#    ifndef WS2812_POWER_CHANNEL_MA
+#        define WS2812_POWER_CHANNEL_MA 16
+#    endif
+#    ifndef WS2812_POWER_IDLE_UA
+#        define WS2812_POWER_IDLE_UA 700
+#    endif
+
+#    define WS2812_PWM_PERIOD (WS2812_PWM_FREQUENCY / WS2812_PWM_TARGET_PERIOD)
+#    define WS2812_DUTYCYCLE_0 (WS2812_PWM_FREQUENCY / (1000000000 / WS2812_T0H))
+#    define WS2812_DUTYCYCLE_1 (WS2812_PWM_FREQUENCY / (1000000000 / WS2812_T1H))
+#    define WS2812_COLOR_BIT_N (WS2812_FUSED_LED_COUNT * 24)
+#    define WS2812_RESET_BIT_N ((1000 * WS2812_TRST_US / WS2812_TIMING + 3) & ~3) // Word aligned, colours follow
+#    define WS2812_BIT_N (WS2812_RESET_BIT_N + WS2812_COLOR_BIT_N)
+
+// Sum of the output levels of a frame that draws WS2812_POWER_BUDGET_MA
+#    define WS2812_POWER_LEVEL_BUDGET ((WS2812_POWER_BUDGET_MA * 1000UL - WS2812_POWER_IDLE_UA * WS2812_FUSED_LED_COUNT) * 255 / (WS2812_POWER_CHANNEL_MA * 1000UL))
+
+_Static_assert(WS2812_DUTYCYCLE_1 < 256, "duty values must fit the byte wide DMA buffer, lower WS2812_PWM_FREQUENCY");
+_Static_assert(WS2812_POWER_BUDGET_MA * 1000UL > WS2812_POWER_IDLE_UA * WS2812_FUSED_LED_COUNT, "WS2812_POWER_BUDGET_MA is below the idle current of the LEDs");
+
+#    ifdef WS2812_PWM_COMPLEMENTARY_OUTPUT
+#        define WS2812_PWM_OUTPUT_MODE PWM_COMPLEMENTARY_OUTPUT_ACTIVE_HIGH
+#    else
+#        define WS2812_PWM_OUTPUT_MODE PWM_OUTPUT_ACTIVE_HIGH
+#    endif
+
+// ============================================================================
+// LOOKUP TABLES
+// ============================================================================
+
+// Nibble -> 4 duty bytes, most significant bit first in memory
+#    define WS2812_DUTY(bit) ((bit) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0)
+#    define WS2812_NIBBLE(n) ((uint32_t)WS2812_DUTY((n)&8) | (uint32_t)WS2812_DUTY((n)&4) << 8 | (uint32_t)WS2812_DUTY((n)&2) << 16 | (uint32_t)WS2812_DUTY((n)&1) << 24)
+
+static const uint32_t ws2812_nibble[16] = {
+    WS2812_NIBBLE(0),  WS2812_NIBBLE(1),  WS2812_NIBBLE(2),  WS2812_NIBBLE(3),  //
+    WS2812_NIBBLE(4),  WS2812_NIBBLE(5),  WS2812_NIBBLE(6),  WS2812_NIBBLE(7),  //
+    WS2812_NIBBLE(8),  WS2812_NIBBLE(9),  WS2812_NIBBLE(10), WS2812_NIBBLE(11), //
+    WS2812_NIBBLE(12), WS2812_NIBBLE(13), WS2812_NIBBLE(14), WS2812_NIBBLE(15),
+};
+
+// Hue -> sector << 8 | position in the sector, as computed by hsv_to_rgb()
+// (the h * 6 / 255 there is a library division call on the M0)
+#    define HUE_SECTOR(h) ((h)*6 / 255)
+#    define HUE(h) ((uint16_t)(HUE_SECTOR(h) << 8 | ((((h)*2 - HUE_SECTOR(h) * 85) * 3) & 0xFF)))
+#    define HUE4(h) HUE(h), HUE((h) + 1), HUE((h) + 2), HUE((h) + 3)
+#    define HUE16(h) HUE4(h), HUE4((h) + 4), HUE4((h) + 8), HUE4((h) + 12)
+#    define HUE64(h) HUE16(h), HUE16((h) + 16), HUE16((h) + 32), HUE16((h) + 48)
+
+static const uint16_t ws2812_hue[256] = {HUE64(0), HUE64(64), HUE64(128), HUE64(192)};
+
+// Channel value -> output level: gamma 2 below RGB_MATRIX_MAXIMUM_BRIGHTNESS,
+// which maps onto itself, so values capped by the brightness limit keep their
+// peak current and raw rgb_matrix_set_color() writes get the same cap
+static uint8_t ws2812_gamma[256];
+
+// One byte per bit: the reset low time, then G, R, B, most significant bit
+// first. Word aligned so a nibble is a single store. The reset comes first
+// so the buffer swap at the end of a pass lands in it.
+static uint32_t ws2812_frame_buffers[2][WS2812_BIT_N / 4];
+static uint32_t *ws2812_back = ws2812_frame_buffers[1]; // Encoded by the flush
+
+// Set by the flush, cleared by the DMA interrupt once it streams the back
+// buffer
+static volatile bool ws2812_swap_pending = false;
+static binary_semaphore_t ws2812_swapped;
+
+// Output levels before the power scale, G, R, B per LED. Kept between
+// frames, so effects that do not write every LED keep the others.
+static uint8_t ws2812_levels[WS2812_FUSED_LED_COUNT][3];
+
+static void ws2812_gamma_init(void) {
+    const uint16_t max = RGB_MATRIX_MAXIMUM_BRIGHTNESS;
+    for (uint16_t i = 0; i < 256; i++) {
+        ws2812_gamma[i] = i >= max ? max : (i * i + max / 2) / max;
+    }
+}
+
+// ============================================================================
+// PIPELINE
+// ============================================================================
+
+// Same result as hsv_to_rgb() without USE_CIE1931_CURVE (the gamma LUT
+// replaces it), without the division
+rgb_t rgb_matrix_hsv_to_rgb(hsv_t hsv) {
+    if (hsv.s == 0) {
+        return (rgb_t){.r = hsv.v, .g = hsv.v, .b = hsv.v};
+    }
+
+    uint16_t sector    = ws2812_hue[hsv.h];
+    uint8_t  remainder = sector & 0xFF;
+    uint8_t  v         = hsv.v;
+    uint8_t  p         = (v * (255 - hsv.s)) >> 8;
+    uint8_t  q         = (v * (255 - ((hsv.s * remainder) >> 8))) >> 8;
+    uint8_t  t         = (v * (255 - ((hsv.s * (255 - remainder)) >> 8))) >> 8;
+
+    switch (sector >> 8) {
+        case 6:
+        case 0:
+            return (rgb_t){.r = v, .g = t, .b = p};
+        case 1:
+            return (rgb_t){.r = q, .g = v, .b = p};
+        case 2:
+            return (rgb_t){.r = p, .g = v, .b = t};
+        case 3:
+            return (rgb_t){.r = p, .g = q, .b = v};
+        case 4:
+            return (rgb_t){.r = t, .g = p, .b = v};
+        default:
+            return (rgb_t){.r = v, .g = p, .b = q};
+    }
+}
+
+static inline void ws2812_write_byte(uint32_t *bits, uint8_t value) {
+    bits[0] = ws2812_nibble[value >> 4];
+    bits[1] = ws2812_nibble[value & 0x0F];
+}
+
+void ws2812_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    if (index < 0 || index >= WS2812_FUSED_LED_COUNT) {
+        return;
+    }
+    ws2812_levels[index][0] = ws2812_gamma[green];
+    ws2812_levels[index][1] = ws2812_gamma[red];
+    ws2812_levels[index][2] = ws2812_gamma[blue];
+}
+
+void ws2812_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    ws2812_set_color(0, red, green, blue);
+    for (uint8_t i = 1; i < WS2812_FUSED_LED_COUNT; i++) {
+        memcpy(ws2812_levels[i], ws2812_levels[0], 3);
+    }
+}
+
+// Current is linear in the output level, so the frame's level sum against
+// WS2812_POWER_LEVEL_BUDGET gives the power scale, 256 = full
+static uint16_t ws2812_power_scale(void) {
+    uint32_t sum = 0;
+    for (uint8_t i = 0; i < WS2812_FUSED_LED_COUNT; i++) {
+        sum += ws2812_levels[i][0] + ws2812_levels[i][1] + ws2812_levels[i][2];
+    }
+    return sum > WS2812_POWER_LEVEL_BUDGET ? WS2812_POWER_LEVEL_BUDGET * 256UL / sum : 256;
+}
+
+static void ws2812_encode(uint16_t scale) {
+    uint32_t *bits = &ws2812_back[WS2812_RESET_BIT_N / 4];
+    for (uint8_t i = 0; i < WS2812_FUSED_LED_COUNT; i++, bits += 6) {
+        const uint8_t *levels = ws2812_levels[i];
+        ws2812_write_byte(&bits[0], (levels[0] * scale) >> 8);
+        ws2812_write_byte(&bits[2], (levels[1] * scale) >> 8);
+        ws2812_write_byte(&bits[4], (levels[2] * scale) >> 8);
+    }
+}
+
+// The back buffer is still streamed until the swap requested by the last
+// flush has happened (at most one pass, about 1 ms), then the frame is
+// encoded into it at its power scale and handed to the DMA
+void ws2812_flush(void) {
+    if (ws2812_swap_pending) {
+        chBSemWait(&ws2812_swapped);
+    }
+    ws2812_encode(ws2812_power_scale());
+    chBSemReset(&ws2812_swapped, true);
+    ws2812_swap_pending = true;
+    rgb_thread_frame_done();
+}
+
+// End of a pass: the DMA has just wrapped into the reset time of the front
+// buffer, so restarting it on the back buffer only shortens a low period
+static void ws2812_dma_complete(void *param, uint32_t flags) {
+    if (!ws2812_swap_pending) {
+        return;
+    }
+    uint32_t *front = ws2812_back;
+    ws2812_back     = front == ws2812_frame_buffers[0] ? ws2812_frame_buffers[1] : ws2812_frame_buffers[0];
+    dmaStreamDisable(WS2812_DMA_STREAM);
+    dmaStreamSetMemory0(WS2812_DMA_STREAM, front);
+    dmaStreamSetTransactionSize(WS2812_DMA_STREAM, WS2812_BIT_N);
+    dmaStreamEnable(WS2812_DMA_STREAM);
+
+    chSysLockFromISR();
+    ws2812_swap_pending = false;
+    chBSemSignalI(&ws2812_swapped);
+    chSysUnlockFromISR();
+}
+
+// ============================================================================
+// HARDWARE
+// ============================================================================
+
+void ws2812_init(void) {
+    chBSemObjectInit(&ws2812_swapped, true);
+    ws2812_gamma_init();
+    ws2812_set_color_all(0, 0, 0);
+    ws2812_encode(256);
+    memset(ws2812_back, 0, WS2812_RESET_BIT_N);
+    memcpy(ws2812_frame_buffers[0], ws2812_back, sizeof(ws2812_frame_buffers[0]));
+
+    palSetLineMode(WS2812_DI_PIN, PAL_MODE_ALTERNATE(WS2812_PWM_PAL_MODE) | PAL_STM32_OTYPE_PUSHPULL | PAL_STM32_OSPEED_HIGHEST);
+
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Woverride-init" // [0 ... 3] sets the default, the channel in use overrides it
+    static const PWMConfig ws2812_pwm_config = {
+        .frequency = WS2812_PWM_FREQUENCY,
+        .period    = WS2812_PWM_PERIOD,
+        .callback  = NULL,
+        .channels =
+            {
+                [0 ... 3]                = {.mode = PWM_OUTPUT_DISABLED, .callback = NULL},
+                [WS2812_PWM_CHANNEL - 1] = {.mode = WS2812_PWM_OUTPUT_MODE, .callback = NULL},
+            },
+        .cr2  = 0,
+        .dier = TIM_DIER_UDE, // Next duty value on every update event
+    };
+#    pragma GCC diagnostic pop
+
+    // Byte reads, word writes: the DMA zero extends into CCR. The transfer
+    // complete interrupt (once per pass) does the buffer swap.
+    dmaStreamAlloc(WS2812_DMA_STREAM - STM32_DMA_STREAM(0), 10, ws2812_dma_complete, NULL);
+    dmaStreamSetPeripheral(WS2812_DMA_STREAM, &(WS2812_PWM_DRIVER.tim->CCR[WS2812_PWM_CHANNEL - 1]));
+    dmaStreamSetMemory0(WS2812_DMA_STREAM, ws2812_frame_buffers[0]);
+    dmaStreamSetTransactionSize(WS2812_DMA_STREAM, WS2812_BIT_N);
+    dmaStreamSetMode(WS2812_DMA_STREAM, STM32_DMA_CR_CHSEL(WS2812_DMA_CHANNEL) | STM32_DMA_CR_DIR_M2P | STM32_DMA_CR_PSIZE_WORD | STM32_DMA_CR_MSIZE_BYTE | STM32_DMA_CR_MINC | STM32_DMA_CR_CIRC | STM32_DMA_CR_PL(3) | STM32_DMA_CR_TCIE);
+    dmaStreamEnable(WS2812_DMA_STREAM);
+
+    // CCR preload is enabled by the ChibiOS PWM driver, so a new duty value
+    // takes effect at the next period
+    pwmStart(&WS2812_PWM_DRIVER, &ws2812_pwm_config);
+    pwmEnableChannel(&WS2812_PWM_DRIVER, WS2812_PWM_CHANNEL - 1, 0);
+}
+
+#endif // RGB_MATRIX_ENABLE